@@ -1684,13 +1684,17 @@ typedef union DecorationData {
 
 #define MAX_ACTOR_DECORATIONS 2
 #define ACTOR_BLUR_FRAMES 16
+#define PAL_CACHE_INVALID -1
 
 typedef struct DecorationTable {
     /* 0x000 */ PAL_BIN copiedPalettes[2][27][SPR_PAL_SIZE];
     /* 0x6C0 */ s8 paletteAdjustment;
     /* 0x6C1 */ b8 resetPalAdjust;
     /* 0x6C2 */ s8 palAnimState;
-    /* 0x6C3 */ char unk_6C3[5];
+    /* 0x6C3 */ s8 palCachePhase; // phase and step of the adjustment currently built in copiedPalettes[0]
+    /* 0x6C4 */ u8 palCacheStep;
+    /* 0x6C5 */ char unk_6C5[1];
+    /* 0x6C6 */ s16 palCacheSpriteID;
     /* 0x6C8 */ s16 nextPalTime;
     /* 0x6CA */ s16 palBlendAlpha;
     /* 0x6CC */ s8 spriteColorVariations;
@@ -5014,7 +5014,7 @@ enum EntityModelFlags {
     ENTITY_MODEL_FLAG_ENABLED           = 0x00000010,
     ENTITY_MODEL_FLAG_HIDDEN            = 0x00000020,
     ENTITY_MODEL_FLAG_40                = 0x00000040,
-    ENTITY_MODEL_FLAG_80                = 0x00000080,
+    ENTITY_MODEL_FLAG_IDLE_SCRIPT       = 0x00000080, // command list loops on a single draw, nothing left to step
     ENTITY_MODEL_FLAG_100               = 0x00000100,
     ENTITY_MODEL_FLAG_REFLECT           = 0x00000200,
     ENTITY_MODEL_FLAG_USE_IMAGE         = 0x00000400,
@@ -17,6 +17,9 @@ void boot_idle(void* data);
 void boot_main(void* data);
 
 void is_debug_init(void);
+void is_debug_write(const void* data, size_t count);
+void is_debug_flush(void);
+void is_debug_flush_crash(void);
 void is_debug_panic(const char* message);
 
 f32 signF(f32 val);
@@ -504,6 +507,7 @@ void set_tex_panner(struct Model* model, s32 texPannerID);
 void set_custom_gfx(s32 customGfxIndex, Gfx* pre, Gfx* post);
 
 s32 make_item_entity(s32 itemID, f32 x, f32 y, f32 z, s32 itemSpawnMode, s32 pickupDelay, s32 angle, s32 pickupVar);
+b32 has_free_item_entity_slot(void);
 s32 make_item_entity_delayed(s32 itemID, f32 x, f32 y, f32 z, s32 itemSpawnMode, s32 pickupDelay, s32 pickupVar);
 void set_item_entity_position(s32 itemEntityIndex, f32 x, f32 y, f32 z);
 ItemEntity* get_item_entity(s32 itemEntityIndex);
@@ -113,7 +113,7 @@ typedef struct ModelTreeInfo {
     /* 0x00 */ u8 modelIndex;
     /* 0x01 */ u8 treeDepth;
     /* 0x02 */ u8 textureID;
-    /* 0x03 */ char unk_03;
+    /* 0x03 */ s8 transformGroupIndex;
 } ModelTreeInfo; // size = 0x04
 
 typedef struct TextureHandle {
@@ -186,6 +186,11 @@ typedef struct ShapeFile {
 
 typedef ModelTreeInfo ModelTreeInfoList[0x200];
 
+#define MAX_CLONED_MODEL_IDS 32
+
+// list index of the model cloned with each ID from CLONED_MODEL(0) on, or -1
+typedef u8 ClonedModelIndexList[MAX_CLONED_MODEL_IDS];
+
 extern ModelTreeInfoList* gCurrentModelTreeNodeInfo;
 extern ModelList* gCurrentModels;
 
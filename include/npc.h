@@ -287,6 +287,13 @@ typedef NpcGroup NpcGroupList[];
 // function signature used for state handlers in AI main functions
 typedef void AIStateHandler(Evt* script, MobileAISettings* settings, EnemyDetectVolume* territory);
 
+// How much of update_encounters_neutral an enemy needs each frame
+enum EnemyActivityTier {
+    ENEMY_ACTIVITY_ACTIVE   = 0, // updated normally, but too far away for any contact test to pass
+    ENEMY_ACTIVITY_NEAR     = 1, // close enough to the player or partner to be tested for contact
+    ENEMY_ACTIVITY_DORMANT  = 2, // offscreen and far away, only checked every few frames
+};
+
 typedef struct Enemy {
     /* 0x00 */ s32 flags;
     /* 0x04 */ s8 encounterIndex;
@@ -340,7 +347,9 @@ typedef struct Enemy {
     /* 0xD8 */ u32 tattleMsg;
     /* 0xDC */ s32 unk_DC;
     /* 0xE0 */ s16 savedNpcYaw;
-    /* 0xE2 */ char unk_E2[6];
+    /* 0xE2 */ s8 activityTier; // see enum: EnemyActivityTier
+    /* 0xE3 */ s8 activityTimer; // frames until a dormant enemy checks whether it should wake up
+    /* 0xE4 */ char unk_E4[4];
 } Enemy; // size = 0xE8
 
 typedef struct Encounter {
@@ -404,6 +413,13 @@ extern EncounterStatus gCurrentEncounter;
 
 s32 basic_ai_check_player_dist(EnemyDetectVolume* arg0, Enemy* arg1, f32 arg2, f32 arg3, b8 arg4);
 
+/// Tests whether collision blocks the enemy's view of the player, using the shared sight cache.
+b32 basic_ai_is_player_sight_blocked(Enemy* enemy, Npc* npc);
+
+/// Drops the cached sight results of an enemy, or of all enemies if NULL. Called before enemies are freed or recreated,
+/// since a new enemy can be allocated at the same address.
+void basic_ai_forget_sight(Enemy* enemy);
+
 /// The default Npc::onUpdate and Npc::onRender callback.
 void STUB_npc_callback(Npc*);
 
@@ -451,6 +467,9 @@ void render_npcs(void);
 
 void npc_move_heading(Npc* npc, f32 speed, f32 yaw);
 
+/// Forgets every cached NPC ID to slot mapping. Called whenever the NPC list is cleared or switched.
+void clear_npc_lookup(void);
+
 Npc* get_npc_unsafe(s32 npcID);
 
 /// @returns NULL if not found
@@ -643,6 +662,9 @@ void bind_npc_aux(s32 npcID, EvtScript* npcAuxBytecode);
 /// @param npcInteractBytecode  pointer to the script to be bound.
 void bind_npc_interact(s32 npcID, EvtScript* npcInteractBytecode);
 
+/// Forgets every cached NPC ID to enemy mapping. Called whenever the encounter list is cleared or rebuilt.
+void clear_enemy_lookup(void);
+
 /// Looks for an enemy matching the specified npcID.
 ///
 /// @param npcID   ID of the npc bound to the desired enemy.
@@ -92,6 +92,7 @@ extern DisplayContext* gDisplayContext;
 extern Gfx* gMainGfxPos;
 extern u16 gMatrixListPos;
 extern s32 gCurrentDisplayContextIndex;
+extern u32 gLastFrameCycles;
 
 extern s16 gCurrentCamID;
 
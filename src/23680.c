@@ -2,6 +2,7 @@
 #include "vars_access.h"
 #include "npc.h"
 #include "effects.h"
+#include "dx/config.h"
 
 extern s32 gLastRenderTaskCount;
 
@@ -426,13 +427,98 @@ b32 is_point_outside_territory(s32 shape, f32 centerX, f32 centerZ, f32 pointX,
     }
 }
 
+// Sight tests are shared by all enemies: results are cached until the enemy or the player moves, and only a few
+// new rays are cast each frame. Enemies which are over budget keep their previous answer for a while.
+#define SIGHT_CACHE_SIZE 32
+#define SIGHT_MOVE_THRESHOLD 8.0f
+#define SIGHT_MAX_AGE 12
+
+typedef struct EnemySightEntry {
+    /* 0x00 */ Enemy* enemy;
+    /* 0x04 */ Vec3f npcPos;
+    /* 0x10 */ Vec3f playerPos;
+    /* 0x1C */ u32 frame;
+    /* 0x20 */ b32 blocked;
+} EnemySightEntry; // size = 0x24
+
+BSS EnemySightEntry EnemySightCache[SIGHT_CACHE_SIZE];
+BSS u32 EnemySightBudgetFrame;
+BSS s32 EnemySightRaysCast;
+
+static b32 sight_pos_unchanged(Vec3f* cached, Vec3f* cur) {
+    return fabsf(cached->x - cur->x) < SIGHT_MOVE_THRESHOLD
+        && fabsf(cached->y - cur->y) < SIGHT_MOVE_THRESHOLD
+        && fabsf(cached->z - cur->z) < SIGHT_MOVE_THRESHOLD;
+}
+
+void basic_ai_forget_sight(Enemy* enemy) {
+    s32 i;
+
+    for (i = 0; i < ARRAY_COUNT(EnemySightCache); i++) {
+        if (enemy == NULL || EnemySightCache[i].enemy == enemy) {
+            EnemySightCache[i].enemy = NULL;
+        }
+    }
+}
+
+b32 basic_ai_is_player_sight_blocked(Enemy* enemy, Npc* npc) {
+    PlayerStatus* playerStatus = &gPlayerStatus;
+    u32 frame = gGameStatusPtr->frameCounter;
+    EnemySightEntry* entry = NULL;
+    EnemySightEntry* oldest = &EnemySightCache[0];
+    f32 x, y, z;
+    f32 dist;
+    s32 i;
+
+    if (EnemySightBudgetFrame != frame) {
+        EnemySightBudgetFrame = frame;
+        EnemySightRaysCast = 0;
+    }
+
+    for (i = 0; i < ARRAY_COUNT(EnemySightCache); i++) {
+        if (EnemySightCache[i].enemy == enemy) {
+            entry = &EnemySightCache[i];
+            break;
+        }
+        if (frame - EnemySightCache[i].frame > frame - oldest->frame) {
+            oldest = &EnemySightCache[i];
+        }
+    }
+
+    if (entry != NULL && frame - entry->frame < SIGHT_MAX_AGE) {
+        if (sight_pos_unchanged(&entry->npcPos, &npc->pos) && sight_pos_unchanged(&entry->playerPos, &playerStatus->pos)) {
+            return entry->blocked;
+        }
+        if (EnemySightRaysCast >= DX_ENEMY_SIGHT_RAYS_PER_FRAME) {
+            return entry->blocked;
+        }
+    }
+
+    if (entry == NULL) {
+        entry = oldest;
+        entry->enemy = enemy;
+    }
+
+    EnemySightRaysCast++;
+    x = npc->pos.x;
+    y = npc->pos.y + npc->collisionHeight * 0.5;
+    z = npc->pos.z;
+    dist = dist2D(npc->pos.x, npc->pos.z, playerStatus->pos.x, playerStatus->pos.z);
+    entry->blocked = npc_test_move_simple_with_slipping(COLLIDER_FLAG_IGNORE_PLAYER | COLLISION_IGNORE_ENTITIES,
+        &x, &y, &z,
+        dist, atan2(npc->pos.x, npc->pos.z, playerStatus->pos.x, playerStatus->pos.z),
+        0.1f, 0.1f);
+    entry->npcPos = npc->pos;
+    entry->playerPos = playerStatus->pos;
+    entry->frame = frame;
+    return entry->blocked;
+}
+
 b32 basic_ai_check_player_dist(EnemyDetectVolume* territory, Enemy* enemy, f32 radius, f32 fwdPosOffset, b8 useWorldYaw) {
     Npc* npc = get_npc_unsafe(enemy->npcID);
     PlayerStatus* playerStatus = &gPlayerStatus;
     PartnerStatus* partnerStatus;
-    f32 x, y, z;
-    f32 dist;
-    s32 skipCheckForPlayer;
+    f32 x, z;
 
     if (enemy->aiFlags & AI_FLAG_CANT_DETECT_PLAYER) {
         return FALSE;
@@ -469,47 +555,41 @@ b32 basic_ai_check_player_dist(EnemyDetectVolume* territory, Enemy* enemy, f32 r
         return FALSE;
     }
 
-    // check for unbroken line of sight
-    if (enemy->aiDetectFlags & AI_DETECT_SIGHT) {
-        x = npc->pos.x;
-        y = npc->pos.y + npc->collisionHeight * 0.5;
-        z = npc->pos.z;
-        dist = dist2D(npc->pos.x, npc->pos.z, playerStatus->pos.x, playerStatus->pos.z);
-        if (npc_test_move_simple_with_slipping(COLLIDER_FLAG_IGNORE_PLAYER | COLLISION_IGNORE_ENTITIES,
-                &x, &y, &z,
-                dist, atan2(npc->pos.x, npc->pos.z, playerStatus->pos.x, playerStatus->pos.z),
-                0.1f, 0.1f)) {
+    if (territory->skipPlayerDetectChance != 0) {
+        // the chance roll only happens while the player is in sight, so keep that order to stay in step with the rng
+        if ((enemy->aiDetectFlags & AI_DETECT_SIGHT) && basic_ai_is_player_sight_blocked(enemy, npc)) {
+            return FALSE;
+        }
+        if (rand_int(territory->skipPlayerDetectChance + 1) != 0) {
             return FALSE;
         }
     }
 
-    if (territory->skipPlayerDetectChance == 0) {
-        skipCheckForPlayer = 0;
+    if (enemy->aiDetectFlags & AI_DETECT_SENSITIVE_MOTION) {
+        if (playerStatus->actionState == ACTION_STATE_WALK) {
+            radius *= 1.15;
+        } else if (playerStatus->actionState == ACTION_STATE_RUN) {
+            radius *= 1.3;
+        }
+    }
+    x = npc->pos.x;
+    z = npc->pos.z;
+    if (useWorldYaw & 0xFF) {
+        add_vec2D_polar(&x, &z, fwdPosOffset, npc->yaw);
     } else {
-        skipCheckForPlayer = rand_int(territory->skipPlayerDetectChance + 1);
+        add_vec2D_polar(&x, &z, fwdPosOffset, 270.0f - npc->renderYaw);
+    }
+    if (dist2D(x, z, playerStatus->pos.x, playerStatus->pos.z) > radius) {
+        return FALSE;
     }
 
-    if (skipCheckForPlayer == 0) {
-        if (enemy->aiDetectFlags & AI_DETECT_SENSITIVE_MOTION) {
-            if (playerStatus->actionState == ACTION_STATE_WALK) {
-                radius *= 1.15;
-            } else if (playerStatus->actionState == ACTION_STATE_RUN) {
-                radius *= 1.3;
-            }
-        }
-        x = npc->pos.x;
-        z = npc->pos.z;
-        if (useWorldYaw & 0xFF) {
-            add_vec2D_polar(&x, &z, fwdPosOffset, npc->yaw);
-        } else {
-            add_vec2D_polar(&x, &z, fwdPosOffset, 270.0f - npc->renderYaw);
-        }
-        if (dist2D(x, z, playerStatus->pos.x, playerStatus->pos.z) <= radius) {
-            return TRUE;
-        }
+    // check for unbroken line of sight, only once the cheap tests have passed
+    if (territory->skipPlayerDetectChance == 0
+            && (enemy->aiDetectFlags & AI_DETECT_SIGHT) && basic_ai_is_player_sight_blocked(enemy, npc)) {
+        return FALSE;
     }
 
-    return FALSE;
+    return TRUE;
 }
 
 s32 ai_check_player_dist(Enemy* enemy, s32 chance, f32 radius, f32 moveSpeed) {
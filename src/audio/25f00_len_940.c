@@ -20,10 +20,35 @@ BSS u8* D_800A3628[3];
 BSS s32 AlFrameSize;
 BSS s32 AlMinFrameSize;
 BSS OSMesgQueue nuAuDmaMesgQ;
-BSS OSMesg nuAuDmaMesgBuf[50];
-BSS OSIoMesg nuAuDmaIOMesgBuf[50];
+BSS OSMesg nuAuDmaMesgBuf[DX_AUDIO_DMA_BUFFERS];
+BSS OSIoMesg nuAuDmaIOMesgBuf[DX_AUDIO_DMA_BUFFERS];
 BSS NUDMAState nuAuDmaState;
-BSS NUDMABuffer nuAuDmaBufList[50];
+BSS NUDMABuffer nuAuDmaBufList[DX_AUDIO_DMA_BUFFERS];
+
+// resident sample cache: used buffers are hashed by the ROM page their data starts in
+#define AU_DMA_BUFFER_SIZE 0x500
+#define AU_DMA_PAGE_SHIFT 11
+#define AU_DMA_HASH_SIZE 64
+#define AU_DMA_PAGE(addr) ((u32)(addr) >> AU_DMA_PAGE_SHIFT)
+#define AU_DMA_BUCKET(page) ((page) & (AU_DMA_HASH_SIZE - 1))
+#define AU_DMA_PIN_MIN_USES 4
+#define AU_DMA_PIN_DECAY_FRAMES 256
+
+typedef struct AuDmaHotInstrument {
+    /* 0x00 */ s32 addr;
+    /* 0x04 */ u16 uses;
+} AuDmaHotInstrument; // size = 0x08
+
+BSS s8 nuAuDmaHashHeads[AU_DMA_HASH_SIZE];
+BSS s8 nuAuDmaHashNext[DX_AUDIO_DMA_BUFFERS];
+BSS u8 nuAuDmaPinned[DX_AUDIO_DMA_BUFFERS];
+BSS s32 nuAuDmaNumPinned;
+BSS AuDmaHotInstrument nuAuDmaHotInstruments[DX_AUDIO_DMA_PINNED];
+BSS u16 nuAuDmaHits;
+BSS u16 nuAuDmaMisses;
+BSS u16 nuAuDmaLoads;
+// handed to the RSP when a sample can't be loaded this frame, decodes to silence
+BSS u8 nuAuDmaSilence[AU_DMA_BUFFER_SIZE] ALIGNED(16);
 
 ALHeap nuAuHeap;
 AuSynDriver auSynDriver;
@@ -88,11 +113,15 @@ void create_audio_system(void) {
     nuAuDmaBufList[0].node.next = nuAuDmaBufList[0].node.prev = NULL;
     for (i = 0; i < ARRAY_COUNT(nuAuDmaBufList) - 1; i++) {
         alLink(&nuAuDmaBufList[i+1].node, &nuAuDmaBufList[i].node);
-        nuAuDmaBufList[i].ptr = alHeapAlloc(config.heap, 1, 0x500);
+        nuAuDmaBufList[i].ptr = alHeapAlloc(config.heap, 1, AU_DMA_BUFFER_SIZE);
     }
-    nuAuDmaBufList[i].ptr = alHeapAlloc(config.heap, 1, 0x500);
+    nuAuDmaBufList[i].ptr = alHeapAlloc(config.heap, 1, AU_DMA_BUFFER_SIZE);
 
-    osCreateMesgQueue(&nuAuDmaMesgQ, nuAuDmaMesgBuf, 50);
+    for (i = 0; i < ARRAY_COUNT(nuAuDmaHashHeads); i++) {
+        nuAuDmaHashHeads[i] = -1;
+    }
+
+    osCreateMesgQueue(&nuAuDmaMesgQ, nuAuDmaMesgBuf, ARRAY_COUNT(nuAuDmaMesgBuf));
     nuAuPreNMIFunc = nuAuPreNMIProc;
     au_driver_init(&auSynDriver, &config);
     au_engine_init(config.outputRate);
@@ -157,7 +186,6 @@ void nuAuMgr(void* arg) {
                 profiler_audio_started(); // XXX: is this the right place?
                 if (osAiGetStatus() & AI_STATUS_FIFO_FULL) {
                     cond = FALSE;
-                    profiler_audio_completed();
                     continue;
                 }
                 sampleSize = osAiGetLength() >> 2;
@@ -174,6 +202,14 @@ void nuAuMgr(void* arg) {
                     cond = TRUE;
                 }
                 cmdListAfter_ptr = alAudioFrame(cmdListBuf, &cmdList_len, (s16*)osVirtualToPhysical(bufferPtr), samples);
+                // only frames which produce a task for the next retrace count as audio frames
+                if (cmdList_len != 0 && nuAuTaskStop == NU_AU_TASK_RUN) {
+                    profiler_audio_counter_update(PROFILER_COUNTER_AUDIO_DMA_HITS, nuAuDmaHits);
+                    profiler_audio_counter_update(PROFILER_COUNTER_AUDIO_DMA_MISSES, nuAuDmaMisses);
+                    profiler_audio_counter_update(PROFILER_COUNTER_AUDIO_DMA_LOADS, nuAuDmaLoads);
+                    nuAuDmaHits = nuAuDmaMisses = nuAuDmaLoads = 0;
+                    profiler_audio_completed();
+                }
                 if (nuAuPreNMIFunc != 0 && nuAuPreNMI != 0) {
                     nuAuPreNMIFunc(NU_SC_RETRACE_MSG, nuAuPreNMI);
                     nuAuPreNMI++;
@@ -187,75 +223,194 @@ void nuAuMgr(void* arg) {
                 nuAuPreNMI++;
                 break;
         }
-        profiler_audio_completed();
     }
 }
 
+static void au_dma_hash_insert(NUDMABuffer* dmaPtr) {
+    s32 idx = dmaPtr - nuAuDmaBufList;
+    s32 bucket = AU_DMA_BUCKET(AU_DMA_PAGE(dmaPtr->startAddr));
+
+    nuAuDmaHashNext[idx] = nuAuDmaHashHeads[bucket];
+    nuAuDmaHashHeads[bucket] = idx;
+}
+
+static void au_dma_hash_remove(NUDMABuffer* dmaPtr) {
+    s32 idx = dmaPtr - nuAuDmaBufList;
+    s8* link = &nuAuDmaHashHeads[AU_DMA_BUCKET(AU_DMA_PAGE(dmaPtr->startAddr))];
+
+    while (*link != idx) {
+        link = &nuAuDmaHashNext[*link];
+    }
+    *link = nuAuDmaHashNext[idx];
+}
+
+static NUDMABuffer* au_dma_find_buffer(u32 addr, u32 addrEnd) {
+    u32 page = AU_DMA_PAGE(addr);
+    s32 i, j;
+
+    // a buffer is larger than a page, so one starting in the previous page may also cover the request
+    for (i = 0; i < 2; i++) {
+        for (j = nuAuDmaHashHeads[AU_DMA_BUCKET(page - i)]; j >= 0; j = nuAuDmaHashNext[j]) {
+            NUDMABuffer* dmaPtr = &nuAuDmaBufList[j];
+
+            if (addr >= dmaPtr->startAddr && dmaPtr->startAddr + AU_DMA_BUFFER_SIZE >= addrEnd) {
+                return dmaPtr;
+            }
+        }
+    }
+    return NULL;
+}
+
+// Whether the buffer starting at startAddr holds the start of a frequently played sample.
+static b32 au_dma_is_hot(u32 startAddr) {
+    s32 i;
+
+    for (i = 0; i < ARRAY_COUNT(nuAuDmaHotInstruments); i++) {
+        u32 hotAddr = nuAuDmaHotInstruments[i].addr;
+
+        if (nuAuDmaHotInstruments[i].uses >= AU_DMA_PIN_MIN_USES
+            && hotAddr >= startAddr && hotAddr < startAddr + AU_DMA_BUFFER_SIZE
+        ) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/// Called whenever an instrument is selected by au_get_instrument. The most frequently selected instruments
+/// which stream from ROM get the buffer holding the start of their sample pinned in the cache.
+void au_dma_note_instrument(Instrument* instrument) {
+    AuDmaHotInstrument* coldest;
+    s32 i;
+
+    if (instrument->unk_25 == 0) {
+        // sample is resident in RAM
+        return;
+    }
+
+    coldest = &nuAuDmaHotInstruments[0];
+    for (i = 0; i < ARRAY_COUNT(nuAuDmaHotInstruments); i++) {
+        AuDmaHotInstrument* hot = &nuAuDmaHotInstruments[i];
+
+        if (hot->addr == (s32)instrument->base) {
+            if (hot->uses < 0xFFFF) {
+                hot->uses++;
+            }
+            return;
+        }
+        if (hot->uses < coldest->uses) {
+            coldest = hot;
+        }
+    }
+
+    coldest->addr = (s32)instrument->base;
+    coldest->uses = 1;
+}
+
+static void au_dma_unlink_used(NUDMABuffer* dmaPtr) {
+    if (nuAuDmaState.firstUsed == dmaPtr) {
+        nuAuDmaState.firstUsed = (NUDMABuffer*)dmaPtr->node.next;
+    }
+    alUnlink(&dmaPtr->node);
+}
+
+/// Reclaims the least recently used unpinned buffer which the RSP is no longer reading from. With force set, pinned
+/// buffers and those used by the previous frame may be taken too, but never one the frame being built reads from.
+static NUDMABuffer* au_dma_evict_buffer(b32 force) {
+    NUDMABuffer* dmaPtr;
+    NUDMABuffer* oldest = NULL;
+
+    for (dmaPtr = nuAuDmaState.firstUsed; dmaPtr != NULL; dmaPtr = (NUDMABuffer*)dmaPtr->node.next) {
+        if ((force
+                ? dmaPtr->frameCnt != nuAuFrameCounter
+                : (!nuAuDmaPinned[dmaPtr - nuAuDmaBufList] && dmaPtr->frameCnt + 1 < nuAuFrameCounter))
+            && (oldest == NULL || dmaPtr->frameCnt < oldest->frameCnt)
+        ) {
+            oldest = dmaPtr;
+        }
+    }
+
+    if (oldest != NULL) {
+        if (nuAuDmaPinned[oldest - nuAuDmaBufList]) {
+            nuAuDmaPinned[oldest - nuAuDmaBufList] = FALSE;
+            nuAuDmaNumPinned--;
+        }
+        au_dma_unlink_used(oldest);
+        au_dma_hash_remove(oldest);
+    }
+    return oldest;
+}
+
 s32 nuAuDmaCallBack(s32 addr, s32 len, void *state, u8 arg3) {
     NUDMABuffer* dmaPtr;
     NUDMABuffer* freeBuffer;
     OSIoMesg* mesg;
     s32 delta;
-    u32 startAddr;
-    s32 addrEnd, buffEnd;
-    NUDMABuffer* lastDmaPtr;
 
     if (arg3 == 0) {
         return osVirtualToPhysical((void*)addr);
     }
 
-    lastDmaPtr = NULL;
-    dmaPtr = nuAuDmaState.firstUsed;
-    addrEnd = addr + len;
+    dmaPtr = au_dma_find_buffer(addr, addr + len);
+    if (dmaPtr != NULL) {
+        nuAuDmaHits++;
+        dmaPtr->frameCnt = nuAuFrameCounter;
+        freeBuffer = (NUDMABuffer*)(dmaPtr->ptr + addr - dmaPtr->startAddr);
+        return osVirtualToPhysical(freeBuffer);
+    }
 
-    while (dmaPtr != NULL) {
-        startAddr = dmaPtr->startAddr;
-        buffEnd = dmaPtr->startAddr + 0x500;
-        if (addr >= startAddr && buffEnd >= addrEnd) {
-            dmaPtr->frameCnt = nuAuFrameCounter;
-            freeBuffer = (NUDMABuffer*)(dmaPtr->ptr + addr - dmaPtr->startAddr);
-            return osVirtualToPhysical(freeBuffer);
-        } else if (addr < startAddr) {
-            break;
-        }
-        lastDmaPtr = dmaPtr;
-        dmaPtr = (NUDMABuffer*)dmaPtr->node.next;
+    nuAuDmaMisses++;
+
+    if (nuAuDmaNext >= ARRAY_COUNT(nuAuDmaIOMesgBuf)) {
+        // out of DMA messages for this frame
+        return osVirtualToPhysical(nuAuDmaSilence);
     }
 
     dmaPtr = nuAuDmaState.firstFree;
-    if (dmaPtr == NULL) {
-        return osVirtualToPhysical(nuAuDmaState.firstUsed);
+    if (dmaPtr != NULL) {
+        nuAuDmaState.firstFree = (NUDMABuffer*)dmaPtr->node.next;
+        alUnlink(&dmaPtr->node);
+    } else {
+        dmaPtr = au_dma_evict_buffer(FALSE);
+        if (dmaPtr == NULL) {
+            dmaPtr = au_dma_evict_buffer(TRUE);
+        }
+        if (dmaPtr == NULL) {
+            // every buffer is read by the frame being built, this sample stays silent for a frame
+            return osVirtualToPhysical(nuAuDmaSilence);
+        }
     }
 
-    nuAuDmaState.firstFree = (NUDMABuffer*)dmaPtr->node.next;
-    alUnlink(&dmaPtr->node);
-
-    if (lastDmaPtr != NULL) {
-        alLink(&dmaPtr->node, &lastDmaPtr->node);
-    } else if (nuAuDmaState.firstUsed != NULL){
-        lastDmaPtr = nuAuDmaState.firstUsed;
-        nuAuDmaState.firstUsed = dmaPtr;
-        dmaPtr->node.next = &lastDmaPtr->node;
+    // order of the used list no longer matters, lookups go through the hash table
+    if (nuAuDmaState.firstUsed != NULL) {
+        dmaPtr->node.next = &nuAuDmaState.firstUsed->node;
         dmaPtr->node.prev = NULL;
-        lastDmaPtr->node.prev = &dmaPtr->node;
+        nuAuDmaState.firstUsed->node.prev = &dmaPtr->node;
     } else {
-        nuAuDmaState.firstUsed = dmaPtr;
         dmaPtr->node.next = NULL;
         dmaPtr->node.prev = NULL;
     }
+    nuAuDmaState.firstUsed = dmaPtr;
 
     freeBuffer = (NUDMABuffer*)dmaPtr->ptr;
     delta = addr & 1;
     addr -= delta;
     dmaPtr->startAddr = addr;
     dmaPtr->frameCnt = nuAuFrameCounter;
+    au_dma_hash_insert(dmaPtr);
 
+    if (nuAuDmaNumPinned < DX_AUDIO_DMA_PINNED && au_dma_is_hot(addr)) {
+        nuAuDmaPinned[dmaPtr - nuAuDmaBufList] = TRUE;
+        nuAuDmaNumPinned++;
+    }
+
+    nuAuDmaLoads++;
     mesg = &nuAuDmaIOMesgBuf[nuAuDmaNext++];
     mesg->hdr.pri = OS_MESG_PRI_NORMAL;
     mesg->hdr.retQueue = &nuAuDmaMesgQ;
     mesg->dramAddr = freeBuffer;
     mesg->devAddr = addr;
-    mesg->size = 0x500;
+    mesg->size = AU_DMA_BUFFER_SIZE;
     osEPiStartDma(nuPiCartHandle, mesg, 0);
     return osVirtualToPhysical(freeBuffer) + delta;
 }
@@ -277,16 +432,23 @@ void nuAuCleanDMABuffers(void) {
     NUDMABuffer* dmaPtr = state->firstUsed;
     NUDMABuffer* nextPtr;
     u32* frameCounter;
+    s32 i;
 
     while (dmaPtr != NULL) {
         nextPtr = (NUDMABuffer*)dmaPtr->node.next;
 
-        if (dmaPtr->frameCnt + 1 < nuAuFrameCounter) {
-            if (state->firstUsed == dmaPtr) {
-                state->firstUsed = nextPtr;
+        if (nuAuDmaPinned[dmaPtr - nuAuDmaBufList]) {
+            if (au_dma_is_hot(dmaPtr->startAddr)) {
+                dmaPtr = nextPtr;
+                continue;
             }
+            nuAuDmaPinned[dmaPtr - nuAuDmaBufList] = FALSE;
+            nuAuDmaNumPinned--;
+        }
 
-            alUnlink(&dmaPtr->node);
+        if (dmaPtr->frameCnt + 1 < nuAuFrameCounter) {
+            au_dma_unlink_used(dmaPtr);
+            au_dma_hash_remove(dmaPtr);
 
             if (state->firstFree != 0) {
                 alLink(&dmaPtr->node, &state->firstFree->node);
@@ -300,6 +462,13 @@ void nuAuCleanDMABuffers(void) {
         dmaPtr = nextPtr;
     }
 
+    // let instruments which are no longer played cool down and lose their pins
+    if (nuAuFrameCounter % AU_DMA_PIN_DECAY_FRAMES == 0) {
+        for (i = 0; i < ARRAY_COUNT(nuAuDmaHotInstruments); i++) {
+            nuAuDmaHotInstruments[i].uses >>= 1;
+        }
+    }
+
     nuAuDmaNext = 0;
     frameCounter = &nuAuFrameCounter;
     *frameCounter += 1;
@@ -807,12 +807,21 @@ void au_bgm_player_initialize(BGMPlayer* player) {
 
 void func_8004E844(BGMPlayer* player, s32 arg1) {
     s32 i;
+#ifdef AUDIO_HOST
+    // in the host harness a plain u16 pointer would write host order into the big-endian field
+    player->unk_212[arg1] = 0;
+
+    for (i = 0; i < 9; i++) {
+        player->unk_174[arg1][i] = 0xFF00;
+    }
+#else
     u16* temp = player->unk_174[arg1];
     player->unk_212[arg1] = 0;
 
     for (i = 0; i < 9; i++) {
         *temp++ = 0xFF00;
     }
+#endif
 }
 
 // divisor is number of ticks per beat?
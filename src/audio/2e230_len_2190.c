@@ -485,6 +485,7 @@ Instrument* au_get_instrument(AuGlobals* globals, u32 bank, u32 patch, EnvelopeD
         envData->cmdListPress = EnvelopePressDefault;
         envData->cmdListRelease = &EnvelopePressDefault[4]; //EnvelopeReleaseDefault;
     }
+    au_dma_note_instrument(instrument);
     return instrument;
 }
 
@@ -717,7 +718,9 @@ void au_load_INIT(AuGlobals* arg0, s32 romAddr, ALHeap* heap) {
     s32* data;
     s32 numEntries;
     s32 tblOffset, shortsOffset;
+#ifndef AUDIO_HOST
     s32* romPtr = &arg0->baseRomOffset;
+#endif
 
     au_read_rom(romAddr, &sbnHeader, sizeof(sbnHeader));
     numEntries = sbnHeader.numEntries;
@@ -739,7 +742,12 @@ void au_load_INIT(AuGlobals* arg0, s32 romAddr, ALHeap* heap) {
     }
 
     if (sbnHeader.INIToffset != 0) {
+#ifdef AUDIO_HOST
+        // the host harness can't take the address of a byte-swapped field
+        initBase = arg0->baseRomOffset + sbnHeader.INIToffset;
+#else
         initBase = *romPtr + sbnHeader.INIToffset;
+#endif
         au_read_rom(initBase, &initHeader, sizeof(initHeader));
 
         tblOffset = initHeader.tblOffset;
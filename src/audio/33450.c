@@ -40,6 +40,9 @@ Acmd* au_pull_voice(AuPVoice* pvoice, Acmd* cmdBufPos) {
     s32 startZero;
     s32 outCount;
     s32 incr;
+#ifdef AUDIO_HOST
+    u16 ratl;
+#endif
 
     envMixer = &pvoice->envMixer;
     resampler = &pvoice->resampler;
@@ -263,8 +266,16 @@ Acmd* au_pull_voice(AuPVoice* pvoice, Acmd* cmdBufPos) {
             envMixer->ltgt = (envMixer->volume * AuEqPower[envMixer->pan]) >> 15;
             envMixer->rtgt = (envMixer->volume * AuEqPower[AUEQPOWER_LENGTH - envMixer->pan - 1]) >> 15;
         }
+#ifdef AUDIO_HOST
+        // the host harness can't take the address of a byte-swapped field
+        envMixer->lratm = _getRate(envMixer->cvolL, envMixer->ltgt, envMixer->segEnd, &ratl);
+        envMixer->lratl = ratl;
+        envMixer->rratm = _getRate(envMixer->cvolR, envMixer->rtgt, envMixer->segEnd, &ratl);
+        envMixer->rratl = ratl;
+#else
         envMixer->lratm = _getRate(envMixer->cvolL, envMixer->ltgt, envMixer->segEnd, &envMixer->lratl);
         envMixer->rratm = _getRate(envMixer->cvolR, envMixer->rtgt, envMixer->segEnd, &envMixer->rratl);
+#endif
         n_aSetVolume(ptr++, A_RATE, envMixer->ltgt, envMixer->lratm, envMixer->lratl);
         n_aSetVolume(ptr++, A_LEFT  | A_VOL, envMixer->cvolL, envMixer->dryamt, envMixer->wetamt);
         n_aSetVolume(ptr++, A_RIGHT | A_VOL, envMixer->rtgt, envMixer->rratm, envMixer->rratl);
@@ -81,6 +81,7 @@ void create_audio_system(void);
 //void nuAuPreNMIFuncSet(NUAuPreNMIFunc func);
 void nuAuMgr(void* arg);
 s32 nuAuDmaCallBack(s32 addr, s32 len, void *state, u8 arg3);
+void au_dma_note_instrument(Instrument* instrument);
 //ALDMAproc nuAuDmaNew(NUDMAState** state);
 //void nuAuCleanDMABuffers(void);
 //void nuAuPreNMIProc(NUScMsg mesg_type, u32 frameCounter);
@@ -209,33 +209,62 @@ void func_80027600(Color_RGBA8* arg0, s16* out) {
     #undef RGBA_BUF_SIZE
 }
 
+// Unpacked color and coverage for the three rows around the one being filtered. Each source pixel is unpacked once
+// per pass and the rows are rotated as the filter moves down the screen.
+BSS Color_RGBA8 FrameFilterRows[3][SCREEN_WIDTH];
+
+// row of the pause background filter which will be processed next when it is spread over several frames
+BSS s16 FrameFilterNextRow;
+
+void gfx_frame_filter_unpack_row(const u16* frameBuffer0, const u16* frameBuffer1, s32 y, Color_RGBA8* out) {
+    const u16* color = &frameBuffer0[SCREEN_WIDTH * y];
+    const u16* coverage = &frameBuffer1[SCREEN_WIDTH * y];
+    s32 x;
+
+    for (x = 0; x < SCREEN_WIDTH; x++) {
+        out[x].a = (coverage[x] >> 2) & 0xF;
+        out[x].r = UNPACK_PAL_R(color[x]);
+        out[x].g = UNPACK_PAL_G(color[x]);
+        out[x].b = UNPACK_PAL_B(color[x]);
+    }
+}
+
 void func_80027774(u16* frameBuffer0, u16* frameBuffer1, u16* zBuffer) {
     Color_RGBA8 filterBuf0[9];
+    Color_RGBA8* prev = FrameFilterRows[0];
+    Color_RGBA8* cur = FrameFilterRows[1];
+    Color_RGBA8* next = FrameFilterRows[2];
+    Color_RGBA8* temp;
     s32 x, y;
 
+    gfx_frame_filter_unpack_row(frameBuffer0, frameBuffer1, 0, cur);
+    gfx_frame_filter_unpack_row(frameBuffer0, frameBuffer1, 1, next);
+
     for (y = 1; y < SCREEN_HEIGHT - 1; y++) {
+        temp = prev;
+        prev = cur;
+        cur = next;
+        next = temp;
+        gfx_frame_filter_unpack_row(frameBuffer0, frameBuffer1, y + 1, next);
+
         for (x = 1; x < SCREEN_WIDTH - 1; x++) {
 
             /*
-            The application of gfx_frame_filter_pass_0 is done to the following pixels, where x is the current pixel.
+            The filter is applied using the following pixels, where x is the current pixel.
                ...
                .x.
                ...
             */
-            if (
-                (((frameBuffer1[(SCREEN_WIDTH * y) + x - 1] >> 2) & 0xF) < 8) ||
-                (((frameBuffer1[(SCREEN_WIDTH * y) + x + 0] >> 2) & 0xF) < 8) ||
-                (((frameBuffer1[(SCREEN_WIDTH * y) + x + 1] >> 2) & 0xF) < 8))
-            {
-                gfx_frame_filter_pass_0(frameBuffer0, frameBuffer1, y - 1, x - 1, &filterBuf0[0]);
-                gfx_frame_filter_pass_0(frameBuffer0, frameBuffer1, y - 1, x,     &filterBuf0[1]);
-                gfx_frame_filter_pass_0(frameBuffer0, frameBuffer1, y - 1, x + 1, &filterBuf0[2]);
-                gfx_frame_filter_pass_0(frameBuffer0, frameBuffer1, y    , x - 1, &filterBuf0[3]);
-                gfx_frame_filter_pass_0(frameBuffer0, frameBuffer1, y    , x,     &filterBuf0[4]);
-                gfx_frame_filter_pass_0(frameBuffer0, frameBuffer1, y    , x + 1, &filterBuf0[5]);
-                gfx_frame_filter_pass_0(frameBuffer0, frameBuffer1, y + 1, x - 1, &filterBuf0[6]);
-                gfx_frame_filter_pass_0(frameBuffer0, frameBuffer1, y + 1, x,     &filterBuf0[7]);
-                gfx_frame_filter_pass_0(frameBuffer0, frameBuffer1, y + 1, x + 1, &filterBuf0[8]);
+            if (cur[x - 1].a < 8 || cur[x].a < 8 || cur[x + 1].a < 8) {
+                filterBuf0[0] = prev[x - 1];
+                filterBuf0[1] = prev[x];
+                filterBuf0[2] = prev[x + 1];
+                filterBuf0[3] = cur[x - 1];
+                filterBuf0[4] = cur[x];
+                filterBuf0[5] = cur[x + 1];
+                filterBuf0[6] = next[x - 1];
+                filterBuf0[7] = next[x];
+                filterBuf0[8] = next[x + 1];
                 func_80027600(filterBuf0, &zBuffer[(SCREEN_WIDTH * y) + x]);
             } else {
                 zBuffer[(SCREEN_WIDTH * y) + x] = frameBuffer0[(SCREEN_WIDTH * y) + x] | 1;
@@ -244,43 +273,74 @@ void func_80027774(u16* frameBuffer0, u16* frameBuffer1, u16* zBuffer) {
     }
 }
 
-// transfers the framebuffer into the depth buffer and applies filters
-void gfx_transfer_frame_to_depth(u16* frameBuffer0, u16* frameBuffer1, u16* zBuffer) {
+/// Transfers rows [startY, endY) of the framebuffer into the depth buffer and applies filters to them.
+/// The first and last rows of the screen are never filtered.
+void gfx_transfer_frame_rows_to_depth(u16* frameBuffer0, u16* frameBuffer1, u16* zBuffer, s32 startY, s32 endY) {
     Color_RGBA8 filterBuf0[6];
-    Color_RGBA8 filterBuf1;
+    Color_RGBA8* prev = FrameFilterRows[0];
+    Color_RGBA8* cur = FrameFilterRows[1];
+    Color_RGBA8* next = FrameFilterRows[2];
+    Color_RGBA8* temp;
     s32 y;
     s32 x;
 
-    for (y = 1; y < SCREEN_HEIGHT - 1; y++) {
+    startY = MAX(startY, 1);
+    endY = MIN(endY, SCREEN_HEIGHT - 1);
+    if (startY >= endY) {
+        return;
+    }
+
+    gfx_frame_filter_unpack_row(frameBuffer0, frameBuffer1, startY - 1, cur);
+    gfx_frame_filter_unpack_row(frameBuffer0, frameBuffer1, startY, next);
+
+    for (y = startY; y < endY; y++) {
+        temp = prev;
+        prev = cur;
+        cur = next;
+        next = temp;
+        gfx_frame_filter_unpack_row(frameBuffer0, frameBuffer1, y + 1, next);
+
         for (x = 2; x < SCREEN_WIDTH - 2; x++) {
             s32 pixel = SCREEN_WIDTH * y + x;
 
             /*
-            The application of gfx_frame_filter_pass_0 is done to the following pixels, where x is the current pixel.
+            The filter is applied using the following pixels, where x is the current pixel.
                . .
               . x .
                . .
             */
-            //TODO emulator test -- find which ones have bad performance here
-            #if !DX_PAUSE_LAG_FIX
-            if (((frameBuffer1[pixel] >> 2) & 0xF) < 8) {
-                gfx_frame_filter_pass_0(frameBuffer0, frameBuffer1, y - 1, x - 1, &filterBuf0[0]);
-                gfx_frame_filter_pass_0(frameBuffer0, frameBuffer1, y - 1, x + 1, &filterBuf0[1]);
-                gfx_frame_filter_pass_0(frameBuffer0, frameBuffer1, y,     x - 2, &filterBuf0[2]);
-                gfx_frame_filter_pass_0(frameBuffer0, frameBuffer1, y,     x + 2, &filterBuf0[3]);
-                gfx_frame_filter_pass_0(frameBuffer0, frameBuffer1, y + 1, x - 1, &filterBuf0[4]);
-                gfx_frame_filter_pass_0(frameBuffer0, frameBuffer1, y + 1, x + 1, &filterBuf0[5]);
-                gfx_frame_filter_pass_0(frameBuffer0, frameBuffer1, y,     x,     &filterBuf1);
-                gfx_frame_filter_pass_1(filterBuf0, filterBuf1, &zBuffer[pixel]);
+            if (cur[x].a < 8) {
+                filterBuf0[0] = prev[x - 1];
+                filterBuf0[1] = prev[x + 1];
+                filterBuf0[2] = cur[x - 2];
+                filterBuf0[3] = cur[x + 2];
+                filterBuf0[4] = next[x - 1];
+                filterBuf0[5] = next[x + 1];
+                gfx_frame_filter_pass_1(filterBuf0, cur[x], &zBuffer[pixel]);
             } else {
                 // Don't apply any filters to the edges of the screen
                 zBuffer[pixel] = frameBuffer0[pixel] | 1;
             }
-            #else
+        }
+    }
+}
+
+// transfers the framebuffer into the depth buffer and applies filters
+void gfx_transfer_frame_to_depth(u16* frameBuffer0, u16* frameBuffer1, u16* zBuffer) {
+    #if !DX_PAUSE_LAG_FIX
+    gfx_transfer_frame_rows_to_depth(frameBuffer0, frameBuffer1, zBuffer, 1, SCREEN_HEIGHT - 1);
+    #else
+    s32 y;
+    s32 x;
+
+    for (y = 1; y < SCREEN_HEIGHT - 1; y++) {
+        for (x = 2; x < SCREEN_WIDTH - 2; x++) {
+            s32 pixel = SCREEN_WIDTH * y + x;
+
             zBuffer[pixel] = frameBuffer0[pixel] | 1;
-            #endif
         }
     }
+    #endif
 }
 
 void func_80027BAC(s32 arg0, s32 arg1) {
@@ -342,10 +402,22 @@ void gfx_draw_background(void) {
             gDPSetDepthSource(gMainGfxPos++, G_ZS_PIXEL);
             gGameStatusPtr->backgroundFlags &= ~BACKGROUND_RENDER_STATE_MASK;
             gGameStatusPtr->backgroundFlags |= BACKGROUND_RENDER_STATE_FILTER_PAUSED;
+            FrameFilterNextRow = 1;
             break;
         case BACKGROUND_RENDER_STATE_FILTER_PAUSED:
             // Save the framebuffer into the depth buffer and run a filter on it based on the saved coverage values
+            #if DX_PAUSE_BLUR_SLICES > 1 && !DX_PAUSE_LAG_FIX
+            // Frame drawing is still held while the pause menu loads, so nothing overwrites the saved framebuffer
+            // while the filter is spread over the next few frames.
+            i = FrameFilterNextRow;
+            FrameFilterNextRow += (SCREEN_HEIGHT - 2 + DX_PAUSE_BLUR_SLICES - 1) / DX_PAUSE_BLUR_SLICES;
+            gfx_transfer_frame_rows_to_depth(nuGfxCfb[0], nuGfxCfb[1], nuGfxZBuffer, i, FrameFilterNextRow);
+            if (FrameFilterNextRow < SCREEN_HEIGHT - 1) {
+                break;
+            }
+            #else
             gfx_transfer_frame_to_depth(nuGfxCfb[0], nuGfxCfb[1], nuGfxZBuffer); // applies filters to the framebuffer
+            #endif
             gPauseBackgroundFade = 0;
             gGameStatusPtr->backgroundFlags &= ~BACKGROUND_RENDER_STATE_MASK;
             gGameStatusPtr->backgroundFlags |= BACKGROUND_RENDER_STATE_SHOW_PAUSED;
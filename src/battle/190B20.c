@@ -1382,6 +1382,7 @@ void load_player_actor(void) {
         ASSERT(decorations != NULL);
 
         decorations->paletteAdjustment = ACTOR_PAL_ADJUST_NONE;
+        decorations->palCachePhase = PAL_CACHE_INVALID;
         decorations->glowState = GLOW_PAL_OFF;
         decorations->flashState = 0;
         decorations->flashEnabled = FLASH_PAL_OFF;
@@ -1873,6 +1874,7 @@ Actor* create_actor(Formation formation) {
             ASSERT(decorations != NULL);
 
             decorations->paletteAdjustment = ACTOR_PAL_ADJUST_NONE;
+            decorations->palCachePhase = PAL_CACHE_INVALID;
             decorations->glowState = GLOW_PAL_OFF;
             decorations->flashState = 0;
             decorations->flashEnabled = FLASH_PAL_OFF;
@@ -2599,6 +2601,7 @@ void set_part_pal_adjustment(ActorPart* part, s32 palAdjust) {
         if (decorations->paletteAdjustment != palAdjust) {
             decorations->paletteAdjustment = palAdjust;
             decorations->palAnimState = 0;
+            decorations->palCachePhase = PAL_CACHE_INVALID;
             decorations->resetPalAdjust = TRUE;
         }
     }
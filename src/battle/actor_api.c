@@ -2632,6 +2632,7 @@ API_CALLABLE(SetActorPaletteSwapTimes) {
     decorations->blendPalB = evt_get_variable(script, *args++);
     decorations->palswapTimeHoldA = evt_get_variable(script, *args++);
     decorations->palswapTimeAtoB = evt_get_variable(script, *args++);
+    decorations->palCachePhase = PAL_CACHE_INVALID;
 
     return ApiStatus_DONE2;
 }
@@ -2659,6 +2660,7 @@ API_CALLABLE(SetActorPaletteSwapParams) {
     table->palswapTimeBtoA = evt_get_variable(script, *args++);
     table->palswapUnused1 = evt_get_variable(script, *args++);
     table->palswapUnused2 = evt_get_variable(script, *args++);
+    table->palCachePhase = PAL_CACHE_INVALID;
 
     return ApiStatus_DONE2;
 }
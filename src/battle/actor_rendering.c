@@ -4,6 +4,7 @@
 #include "battle/battle.h"
 #include "sprite/npc/BattleWatt.h"
 #include "chaos.h"
+#include "dx/config.h"
 
 enum StandardPalettes {
     STANDARD_PAL_POISON     = 1,
@@ -351,6 +352,40 @@ void force_disable_player_blur_immediately(void) {
     decorations->blurDisableDelay = 1;
 }
 
+#if DX_CHEAP_ACTOR_BLUR
+// ghosts are drawn from every third history frame
+#define ACTOR_BLUR_MAX_GHOSTS (ACTOR_BLUR_FRAMES / 3)
+
+// frames taking longer than this drop a ghost, frames faster than the second threshold give one back
+#define ACTOR_BLUR_SLOW_FRAME_CYCLES OS_USEC_TO_CYCLES(33333)
+#define ACTOR_BLUR_FAST_FRAME_CYCLES OS_USEC_TO_CYCLES(25000)
+
+BSS s32 ActorBlurGhostsDropped;
+BSS u32 ActorBlurLimitFrame;
+BSS SpriteShadingProfile ActorBlurNoShading;
+#endif
+
+// Number of ghosts to draw behind a blurred part this frame
+s32 get_actor_blur_ghost_count(DecorationTable* decorations) {
+#if DX_CHEAP_ACTOR_BLUR
+    if (ActorBlurLimitFrame != gGameStatusPtr->frameCounter) {
+        ActorBlurLimitFrame = gGameStatusPtr->frameCounter;
+        if (gLastFrameCycles > ACTOR_BLUR_SLOW_FRAME_CYCLES) {
+            if (ActorBlurGhostsDropped < ACTOR_BLUR_MAX_GHOSTS - 1) {
+                ActorBlurGhostsDropped++;
+            }
+        } else if (gLastFrameCycles < ACTOR_BLUR_FAST_FRAME_CYCLES) {
+            if (ActorBlurGhostsDropped > 0) {
+                ActorBlurGhostsDropped--;
+            }
+        }
+    }
+    return MIN(decorations->blurDrawCount, ACTOR_BLUR_MAX_GHOSTS - ActorBlurGhostsDropped);
+#else
+    return decorations->blurDrawCount;
+#endif
+}
+
 void update_player_actor_blur_history(Actor* actor) {
     ActorPart* partsTable = actor->partsTable;
     DecorationTable* decorations = partsTable->decorationTable;
@@ -396,7 +431,11 @@ void appendGfx_player_actor_blur(Actor* actor) {
     s32 bufPos;
     s32 blurOpacityBase;
     s32 opacityLossIncrement;
+    s32 ghostCount;
     f32 x, y, z;
+#if DX_CHEAP_ACTOR_BLUR
+    SpriteShadingProfile* shadingProfile;
+#endif
 
     partTable = actor->partsTable;
     decorations = partTable->decorationTable;
@@ -412,6 +451,11 @@ void appendGfx_player_actor_blur(Actor* actor) {
         bufPos = decorations->blurBufferPos;
         strideIdx = 0;
         drawIdx = 0;
+        ghostCount = get_actor_blur_ghost_count(decorations);
+#if DX_CHEAP_ACTOR_BLUR
+        shadingProfile = gSpriteShadingProfile;
+        gSpriteShadingProfile = &ActorBlurNoShading;
+#endif
 
         while (TRUE) {
             bufPos--;
@@ -431,7 +475,7 @@ void appendGfx_player_actor_blur(Actor* actor) {
             strideIdx = 0;
             drawIdx++;
 
-            if (decorations->blurDrawCount < drawIdx) {
+            if (ghostCount < drawIdx) {
                 break;
             }
 
@@ -483,6 +527,9 @@ void appendGfx_player_actor_blur(Actor* actor) {
             render_with_adjusted_palettes(SPRITE_MODE_PLAYER, partTable, clamp_angle(yaw + 180), mtxTransform, 1);
             partTable->opacity = prevOpacity;
         }
+#if DX_CHEAP_ACTOR_BLUR
+        gSpriteShadingProfile = shadingProfile;
+#endif
     }
 }
 
@@ -539,7 +586,13 @@ void appendGfx_nonplayer_actor_blur(b32 isPartner, Actor* actor) {
     s32 blurOpacityBase;
     s32 opacityLossIncrement;
     s32 blurOpacity;
+    s32 ghostCount;
     s32 flags;
+#if DX_CHEAP_ACTOR_BLUR
+    SpriteShadingProfile* shadingProfile = gSpriteShadingProfile;
+
+    gSpriteShadingProfile = &ActorBlurNoShading;
+#endif
 
     guRotateF(mtxRotX, actor->rot.x, 1.0f, 0.0f, 0.0f);
     guRotateF(mtxRotY, actor->rot.y, 0.0f, 1.0f, 0.0f);
@@ -581,6 +634,7 @@ void appendGfx_nonplayer_actor_blur(b32 isPartner, Actor* actor) {
         bufPos = decorations->blurBufferPos;
         strideIdx = 0;
         drawIdx = 0;
+        ghostCount = get_actor_blur_ghost_count(decorations);
 
         while (TRUE) {
             bufPos--;
@@ -602,7 +656,7 @@ void appendGfx_nonplayer_actor_blur(b32 isPartner, Actor* actor) {
             strideIdx = 0;
             drawIdx++;
 
-            if (decorations->blurDrawCount < drawIdx) {
+            if (ghostCount < drawIdx) {
                 break;
             }
 
@@ -669,6 +723,10 @@ void appendGfx_nonplayer_actor_blur(b32 isPartner, Actor* actor) {
             }
         }
     }
+
+#if DX_CHEAP_ACTOR_BLUR
+    gSpriteShadingProfile = shadingProfile;
+#endif
 }
 
 void update_enemy_actor_blur_history(Actor* actor) {
@@ -1924,6 +1982,32 @@ void appendGfx_player_actor_reflection(void* arg0) {
     render_with_adjusted_palettes(SPRITE_MODE_PLAYER, part, clamp_angle(playerYaw + 180.0f), mtxTransform, TRUE);
 }
 
+#if DX_CHECK_PAL_CACHE
+BSS PAL_BIN PalCacheCheckCopy[27][SPR_PAL_SIZE];
+BSS b32 PalCacheCheckPending;
+
+// Compares the palettes rebuilt after a forced cache miss with the ones that were cached
+void check_part_pal_cache(ActorPart* part) {
+    DecorationTable* decorations = part->decorationTable;
+    s32 i, j;
+
+    // skipped if the draw overwrote them again, e.g. for a flash
+    if (!PalCacheCheckPending || decorations->palCachePhase == PAL_CACHE_INVALID) {
+        PalCacheCheckPending = FALSE;
+        return;
+    }
+    PalCacheCheckPending = FALSE;
+
+    for (i = 0; i < decorations->originalPalettesCount; i++) {
+        for (j = 0; j < SPR_PAL_SIZE; j++) {
+            ASSERT_MSG(PalCacheCheckCopy[i][j] == decorations->copiedPalettes[0][i][j],
+                "Palette cache for sprite %d is stale (mode %d, phase %d)", decorations->palCacheSpriteID,
+                decorations->paletteAdjustment, decorations->palCachePhase);
+        }
+    }
+}
+#endif
+
 s32 render_with_adjusted_palettes(b32 isNpcSprite, ActorPart* part, s32 yaw, Matrix4f mtx, b32 skipAnimation) {
     s32 opacity;
     s32 sprDrawOpts;
@@ -2001,6 +2085,9 @@ s32 render_with_adjusted_palettes(b32 isNpcSprite, ActorPart* part, s32 yaw, Mat
         default:
             break;
     }
+#if DX_CHECK_PAL_CACHE
+    check_part_pal_cache(part);
+#endif
     return 0;
 }
 
@@ -2066,6 +2153,7 @@ void func_unkA_draw_npc(ActorPart* part, s32 yaw, Matrix4f mtx) {
             decorations->adjustedPalettes[i] = decorations->copiedPalettes[0][i];
         }
 
+        decorations->palCachePhase = PAL_CACHE_INVALID;
         func_unkB_draw_npc(part, yaw, mtx);
     } else {
         spr_draw_npc_sprite(part->spriteInstanceID | idMask, yaw, opacity, NULL, mtx);
@@ -2134,6 +2222,7 @@ void func_unkA_draw_player(ActorPart* part, s32 yaw, Matrix4f mtx) {
         for (i = 0; i < decorations->originalPalettesCount; i++) {
             decorations->adjustedPalettes[i] = decorations->copiedPalettes[0][i];
         }
+        decorations->palCachePhase = PAL_CACHE_INVALID;
         func_unkB_draw_player(part, yaw, mtx);
     } else {
         spr_draw_player_sprite(PLAYER_SPRITE_MAIN | idMask, yaw, opacity, NULL, mtx);
@@ -2164,6 +2253,32 @@ void func_unkB_draw_player(ActorPart* part, s32 yaw, Matrix4f mtx) {
     }
 }
 
+// Adjusted palettes built in copiedPalettes[0] only depend on the sprite, the adjustment mode, and the phase or blend
+// step it is in, so they are kept until one of those changes rather than rebuilt for every draw. Anything else that
+// writes copiedPalettes[0], or changes the parameters of an adjustment, sets palCachePhase to PAL_CACHE_INVALID.
+b32 part_pal_cache_hit(ActorPart* part, s32 phase, s32 step) {
+    DecorationTable* decorations = part->decorationTable;
+    s16 spriteID = part->curAnimation >> 16;
+
+    if (decorations->palCachePhase == phase && decorations->palCacheStep == step
+        && decorations->palCacheSpriteID == spriteID
+    ) {
+#if DX_CHECK_PAL_CACHE
+        // rebuild anyway, render_with_adjusted_palettes compares the result
+        bcopy(decorations->copiedPalettes[0], PalCacheCheckCopy, sizeof(PalCacheCheckCopy));
+        PalCacheCheckPending = TRUE;
+        return FALSE;
+#else
+        return TRUE;
+#endif
+    }
+
+    decorations->palCachePhase = phase;
+    decorations->palCacheStep = step;
+    decorations->palCacheSpriteID = spriteID;
+    return FALSE;
+}
+
 void render_without_adjusted_palettes(b32 isNpcSprite, ActorPart* part, s32 yaw, Matrix4f mtx, b32 skipAnimation) {
     DecorationTable* decorations = part->decorationTable;
 
@@ -2202,24 +2317,26 @@ void render_with_sleep_palettes(b32 isNpcSprite, ActorPart* part, s32 yaw, Matri
         decorations->resetPalAdjust = FALSE;
     }
 
-    for (i = 0; i < decorations->originalPalettesCount; i++) {
-        PAL_PTR palIn = decorations->originalPalettesList[i];
-        PAL_PTR palOut = decorations->copiedPalettes[0][i];
-        decorations->adjustedPalettes[i] = palOut;
-        if (palIn != NULL) {
-            for (j = 0; j < SPR_PAL_SIZE; j++) {
-                u8 r = UNPACK_PAL_R(*palIn);
-                u8 g = UNPACK_PAL_G(*palIn);
-                u8 b = UNPACK_PAL_B(*palIn);
-                u8 a = UNPACK_PAL_A(*palIn);
-                palIn++;
-
-                // make colors darker and bluer
-                r *= 0.2;
-                g *= 0.4;
-                b *= 0.7;
-
-                *palOut++ = PACK_PAL_RGBA(r, g, b, a);
+    if (!part_pal_cache_hit(part, 0, 0)) {
+        for (i = 0; i < decorations->originalPalettesCount; i++) {
+            PAL_PTR palIn = decorations->originalPalettesList[i];
+            PAL_PTR palOut = decorations->copiedPalettes[0][i];
+            decorations->adjustedPalettes[i] = palOut;
+            if (palIn != NULL) {
+                for (j = 0; j < SPR_PAL_SIZE; j++) {
+                    u8 r = UNPACK_PAL_R(*palIn);
+                    u8 g = UNPACK_PAL_G(*palIn);
+                    u8 b = UNPACK_PAL_B(*palIn);
+                    u8 a = UNPACK_PAL_A(*palIn);
+                    palIn++;
+
+                    // make colors darker and bluer
+                    r *= 0.2;
+                    g *= 0.4;
+                    b *= 0.7;
+
+                    *palOut++ = PACK_PAL_RGBA(r, g, b, a);
+                }
             }
         }
     }
@@ -2290,55 +2407,57 @@ void render_with_static_palettes(b32 isNpcSprite, ActorPart* part, s32 yaw, Matr
         paletteType = StaticPalettesAnim[decorations->palAnimState];
     }
 
-    switch (paletteType) {
-        case STATIC_DEFAULT: // no change
-            for (i = 0; i < decorations->spriteColorVariations; i++) {
-                palIn = decorations->originalPalettesList[i];
-                palOut = decorations->copiedPalettes[0][i];
-                if (palIn != NULL) {
-                    for (j = 0; j < SPR_PAL_SIZE; j++) {
-                        *palOut++ = *palIn++;
+    if (!part_pal_cache_hit(part, paletteType, 0)) {
+        switch (paletteType) {
+            case STATIC_DEFAULT: // no change
+                for (i = 0; i < decorations->spriteColorVariations; i++) {
+                    palIn = decorations->originalPalettesList[i];
+                    palOut = decorations->copiedPalettes[0][i];
+                    if (palIn != NULL) {
+                        for (j = 0; j < SPR_PAL_SIZE; j++) {
+                            *palOut++ = *palIn++;
+                        }
                     }
                 }
-            }
-            break;
-        case STATIC_BRIGHT: // bright yellow
-            for (i = 0; i < decorations->spriteColorVariations; i++) {
-                staticPalIdx = decorations->spriteColorVariations * STANDARD_PAL_STATIC + i;
-                palIn = decorations->originalPalettesList[staticPalIdx];
-                palOut = decorations->copiedPalettes[0][i];
-                if (palIn != NULL) {
-                    for (j = 0; j < SPR_PAL_SIZE; j++) {
-                        *palOut++ = *palIn++;
+                break;
+            case STATIC_BRIGHT: // bright yellow
+                for (i = 0; i < decorations->spriteColorVariations; i++) {
+                    staticPalIdx = decorations->spriteColorVariations * STANDARD_PAL_STATIC + i;
+                    palIn = decorations->originalPalettesList[staticPalIdx];
+                    palOut = decorations->copiedPalettes[0][i];
+                    if (palIn != NULL) {
+                        for (j = 0; j < SPR_PAL_SIZE; j++) {
+                            *palOut++ = *palIn++;
+                        }
                     }
                 }
-            }
-            break;
-        case STATIC_DARK: // darkened via code
-            for (i = 0; i < decorations->spriteColorVariations; i++) {
-                palIn = decorations->originalPalettesList[i];
-                palOut = decorations->copiedPalettes[0][i];
-                if (palIn != NULL) {
-                    for (j = 0; j < SPR_PAL_SIZE; j++) {
-                        u8 r = UNPACK_PAL_R(*palIn);
-                        u8 g = UNPACK_PAL_G(*palIn);
-                        u8 b = UNPACK_PAL_B(*palIn);
-                        u8 a = UNPACK_PAL_A(*palIn);
-                        palIn++;
-
-                        r *= 0.1;
-                        g *= 0.1;
-                        b *= 0.1;
-
-                        *palOut++ = PACK_PAL_RGBA(r, g, b, a);
+                break;
+            case STATIC_DARK: // darkened via code
+                for (i = 0; i < decorations->spriteColorVariations; i++) {
+                    palIn = decorations->originalPalettesList[i];
+                    palOut = decorations->copiedPalettes[0][i];
+                    if (palIn != NULL) {
+                        for (j = 0; j < SPR_PAL_SIZE; j++) {
+                            u8 r = UNPACK_PAL_R(*palIn);
+                            u8 g = UNPACK_PAL_G(*palIn);
+                            u8 b = UNPACK_PAL_B(*palIn);
+                            u8 a = UNPACK_PAL_A(*palIn);
+                            palIn++;
+
+                            r *= 0.1;
+                            g *= 0.1;
+                            b *= 0.1;
+
+                            *palOut++ = PACK_PAL_RGBA(r, g, b, a);
+                        }
                     }
                 }
-            }
-            break;
-    }
+                break;
+        }
 
-    for (i = 0; i < decorations->originalPalettesCount; i++) {
-        decorations->adjustedPalettes[i] = decorations->copiedPalettes[0][i];
+        for (i = 0; i < decorations->originalPalettesCount; i++) {
+            decorations->adjustedPalettes[i] = decorations->copiedPalettes[0][i];
+        }
     }
 
     if (isNpcSprite == SPRITE_MODE_PLAYER) {
@@ -2380,24 +2499,26 @@ void render_with_fear_palettes(b32 isNpcSprite, ActorPart* part, s32 yaw, Matrix
         decorations->resetPalAdjust = FALSE;
     }
 
-    for (i = 0; i < decorations->originalPalettesCount; i++) {
-        palIn = decorations->originalPalettesList[i];
-        palOut = decorations->copiedPalettes[0][i];
-        decorations->adjustedPalettes[i] = palOut;
-        if (palIn != NULL) {
-            for (j = 0; j < SPR_PAL_SIZE; j++) {
-                u8 r = UNPACK_PAL_R(*palIn);
-                u8 g = UNPACK_PAL_G(*palIn);
-                u8 b = UNPACK_PAL_B(*palIn);
-                u8 a = UNPACK_PAL_A(*palIn);
-                palIn++;
-
-                // darken the color
-                r /= 2;
-                g /= 2;
-                b /= 2;
-
-                *palOut++ = PACK_PAL_RGBA(r, g, b, a);
+    if (!part_pal_cache_hit(part, 0, 0)) {
+        for (i = 0; i < decorations->originalPalettesCount; i++) {
+            palIn = decorations->originalPalettesList[i];
+            palOut = decorations->copiedPalettes[0][i];
+            decorations->adjustedPalettes[i] = palOut;
+            if (palIn != NULL) {
+                for (j = 0; j < SPR_PAL_SIZE; j++) {
+                    u8 r = UNPACK_PAL_R(*palIn);
+                    u8 g = UNPACK_PAL_G(*palIn);
+                    u8 b = UNPACK_PAL_B(*palIn);
+                    u8 a = UNPACK_PAL_A(*palIn);
+                    palIn++;
+
+                    // darken the color
+                    r /= 2;
+                    g /= 2;
+                    b /= 2;
+
+                    *palOut++ = PACK_PAL_RGBA(r, g, b, a);
+                }
             }
         }
     }
@@ -2450,27 +2571,29 @@ void render_with_poison_palettes(b32 isNpcSprite, ActorPart* part, s32 yaw, Matr
         decorations->resetPalAdjust = FALSE;
     }
 
-    for (i = 0; i < decorations->originalPalettesCount; i++) {
-        palIn = decorations->originalPalettesList[i];
-        palOut = decorations->copiedPalettes[0][i];
-        if (palIn != NULL) {
-            for (j = 0; j < SPR_PAL_SIZE; j++) {
-                *palOut++ = *palIn++;
+    if (!part_pal_cache_hit(part, 0, 0)) {
+        for (i = 0; i < decorations->originalPalettesCount; i++) {
+            palIn = decorations->originalPalettesList[i];
+            palOut = decorations->copiedPalettes[0][i];
+            if (palIn != NULL) {
+                for (j = 0; j < SPR_PAL_SIZE; j++) {
+                    *palOut++ = *palIn++;
+                }
             }
         }
-    }
-    for (i = 0; i < decorations->spriteColorVariations; i++) {
-        palIn = decorations->originalPalettesList[decorations->spriteColorVariations + i];
-        palOut = decorations->copiedPalettes[0][i];
-        if (palIn != NULL) {
-            for (j = 0; j < SPR_PAL_SIZE; j++) {
-                *palOut++ = *palIn++;
+        for (i = 0; i < decorations->spriteColorVariations; i++) {
+            palIn = decorations->originalPalettesList[decorations->spriteColorVariations + i];
+            palOut = decorations->copiedPalettes[0][i];
+            if (palIn != NULL) {
+                for (j = 0; j < SPR_PAL_SIZE; j++) {
+                    *palOut++ = *palIn++;
+                }
             }
         }
-    }
 
-    for (i = 0; i < decorations->originalPalettesCount; i++) {
-        decorations->adjustedPalettes[i] = decorations->copiedPalettes[0][i];
+        for (i = 0; i < decorations->originalPalettesCount; i++) {
+            decorations->adjustedPalettes[i] = decorations->copiedPalettes[0][i];
+        }
     }
 
     if (isNpcSprite == SPRITE_MODE_PLAYER) {
@@ -2507,36 +2630,38 @@ void render_with_paralyze_palettes(b32 isNpcSprite, ActorPart* part, s32 yaw, Ma
         decorations->resetPalAdjust = FALSE;
     }
 
-    for (i = 0; i < decorations->originalPalettesCount; i++) {
-        palIn = decorations->originalPalettesList[i];
-        palOut = decorations->copiedPalettes[0][i];
-        if (palIn != NULL) {
-            for (j = 0; j < SPR_PAL_SIZE; j++) {
-                u8 r = UNPACK_PAL_R(*palIn);
-                u8 g = UNPACK_PAL_G(*palIn);
-                u8 b = UNPACK_PAL_B(*palIn);
-                u8 a = UNPACK_PAL_A(*palIn);
-                palIn++;
-                r += 4;
-                if (r > 31) {
-                    r = 31;
-                }
-                g += 4;
-                if (g > 31) {
-                    g = 31;
-                }
-                b += 4;
-                if (b > 31) {
-                    b = 31;
-                }
+    if (!part_pal_cache_hit(part, 0, 0)) {
+        for (i = 0; i < decorations->originalPalettesCount; i++) {
+            palIn = decorations->originalPalettesList[i];
+            palOut = decorations->copiedPalettes[0][i];
+            if (palIn != NULL) {
+                for (j = 0; j < SPR_PAL_SIZE; j++) {
+                    u8 r = UNPACK_PAL_R(*palIn);
+                    u8 g = UNPACK_PAL_G(*palIn);
+                    u8 b = UNPACK_PAL_B(*palIn);
+                    u8 a = UNPACK_PAL_A(*palIn);
+                    palIn++;
+                    r += 4;
+                    if (r > 31) {
+                        r = 31;
+                    }
+                    g += 4;
+                    if (g > 31) {
+                        g = 31;
+                    }
+                    b += 4;
+                    if (b > 31) {
+                        b = 31;
+                    }
 
-                *palOut++ = PACK_PAL_RGBA(r, g, b, a);
+                    *palOut++ = PACK_PAL_RGBA(r, g, b, a);
+                }
             }
         }
-    }
 
-    for (i = 0; i < decorations->originalPalettesCount; i++) {
-        decorations->adjustedPalettes[i] = decorations->copiedPalettes[0][i];
+        for (i = 0; i < decorations->originalPalettesCount; i++) {
+            decorations->adjustedPalettes[i] = decorations->copiedPalettes[0][i];
+        }
     }
 
     switch (decorations->palAnimState) {
@@ -2607,30 +2732,32 @@ void render_with_berserk_palettes(b32 isNpcSprite, ActorPart* part, s32 yaw, Mat
         decorations->resetPalAdjust = FALSE;
     }
 
-    // adjust each palette
-    for (i = 0; i < decorations->originalPalettesCount; i++) {
-        PAL_PTR palIn = decorations->originalPalettesList[i];
-        PAL_PTR palOut = decorations->copiedPalettes[0][i];
-        if (palIn != NULL) {
-            for (j = 0; j < SPR_PAL_SIZE; j++) {
-                u8 r = UNPACK_PAL_R(*palIn);
-                u8 g = UNPACK_PAL_G(*palIn);
-                u8 b = UNPACK_PAL_B(*palIn);
-                u8 a = UNPACK_PAL_A(*palIn);
-                palIn++;
-
-                // make each color darker and redder
-                r *= 0.8;
-                g *= 0.6;
-                b *= 0.1;
-
-                *palOut++ = PACK_PAL_RGBA(r, g, b, a);
+    if (!part_pal_cache_hit(part, 0, 0)) {
+        // adjust each palette
+        for (i = 0; i < decorations->originalPalettesCount; i++) {
+            PAL_PTR palIn = decorations->originalPalettesList[i];
+            PAL_PTR palOut = decorations->copiedPalettes[0][i];
+            if (palIn != NULL) {
+                for (j = 0; j < SPR_PAL_SIZE; j++) {
+                    u8 r = UNPACK_PAL_R(*palIn);
+                    u8 g = UNPACK_PAL_G(*palIn);
+                    u8 b = UNPACK_PAL_B(*palIn);
+                    u8 a = UNPACK_PAL_A(*palIn);
+                    palIn++;
+
+                    // make each color darker and redder
+                    r *= 0.8;
+                    g *= 0.6;
+                    b *= 0.1;
+
+                    *palOut++ = PACK_PAL_RGBA(r, g, b, a);
+                }
             }
         }
-    }
 
-    for (i = 0; i < decorations->originalPalettesCount; i++) {
-        decorations->adjustedPalettes[i] = decorations->copiedPalettes[0][i];
+        for (i = 0; i < decorations->originalPalettesCount; i++) {
+            decorations->adjustedPalettes[i] = decorations->copiedPalettes[0][i];
+        }
     }
 
     if (isNpcSprite == SPRITE_MODE_PLAYER) {
@@ -2696,49 +2823,51 @@ void render_with_watt_idle_palettes(b32 isNpcSprite, ActorPart* part, s32 yaw, M
         brightnessLevel = bWattIdlePalettesAnim[decorations->palAnimState];
     }
 
-    switch (brightnessLevel) {
-        case WATT_DEFAULT:
-            for (i = 0; i < decorations->spriteColorVariations; i++) {
-                // use watt's base palettes
-                palIn = decorations->originalPalettesList[i];
-                palOut = decorations->copiedPalettes[0][i];
-                if (palIn != NULL) {
-                    for (j = 0; j < SPR_PAL_SIZE; j++) {
-                        *palOut++ = *palIn++;
+    if (!part_pal_cache_hit(part, brightnessLevel, 0)) {
+        switch (brightnessLevel) {
+            case WATT_DEFAULT:
+                for (i = 0; i < decorations->spriteColorVariations; i++) {
+                    // use watt's base palettes
+                    palIn = decorations->originalPalettesList[i];
+                    palOut = decorations->copiedPalettes[0][i];
+                    if (palIn != NULL) {
+                        for (j = 0; j < SPR_PAL_SIZE; j++) {
+                            *palOut++ = *palIn++;
+                        }
                     }
                 }
-            }
-            break;
-        case WATT_BRIGHTEST:
-            for (i = 0; i < decorations->spriteColorVariations; i++) {
-                // use watt's Brightest palettes
-                palIdx = decorations->spriteColorVariations * SPR_PAL_BattleWatt_Brightest + i;
-                palIn = decorations->originalPalettesList[palIdx];
-                palOut = decorations->copiedPalettes[0][i];
-                if (palIn != NULL) {
-                    for (j = 0; j < SPR_PAL_SIZE; j++) {
-                        *palOut++ = *palIn++;
+                break;
+            case WATT_BRIGHTEST:
+                for (i = 0; i < decorations->spriteColorVariations; i++) {
+                    // use watt's Brightest palettes
+                    palIdx = decorations->spriteColorVariations * SPR_PAL_BattleWatt_Brightest + i;
+                    palIn = decorations->originalPalettesList[palIdx];
+                    palOut = decorations->copiedPalettes[0][i];
+                    if (palIn != NULL) {
+                        for (j = 0; j < SPR_PAL_SIZE; j++) {
+                            *palOut++ = *palIn++;
+                        }
                     }
                 }
-            }
-            break;
-        case WATT_BRIGHTER:
-            for (i = 0; i < decorations->spriteColorVariations; i++) {
-                // use watt's Brighter palettes
-                palIdx = decorations->spriteColorVariations * SPR_PAL_BattleWatt_Brighter + i;
-                palIn = decorations->originalPalettesList[palIdx];
-                palOut = decorations->copiedPalettes[0][i];
-                if (palIn != NULL) {
-                    for (j = 0; j < SPR_PAL_SIZE; j++) {
-                        *palOut++ = *palIn++;
+                break;
+            case WATT_BRIGHTER:
+                for (i = 0; i < decorations->spriteColorVariations; i++) {
+                    // use watt's Brighter palettes
+                    palIdx = decorations->spriteColorVariations * SPR_PAL_BattleWatt_Brighter + i;
+                    palIn = decorations->originalPalettesList[palIdx];
+                    palOut = decorations->copiedPalettes[0][i];
+                    if (palIn != NULL) {
+                        for (j = 0; j < SPR_PAL_SIZE; j++) {
+                            *palOut++ = *palIn++;
+                        }
                     }
                 }
-            }
-            break;
-    }
+                break;
+        }
 
-    for (i = 0; i < decorations->originalPalettesCount; i++) {
-        decorations->adjustedPalettes[i] = decorations->copiedPalettes[0][i];
+        for (i = 0; i < decorations->originalPalettesCount; i++) {
+            decorations->adjustedPalettes[i] = decorations->copiedPalettes[0][i];
+        }
     }
 
     if (isNpcSprite == SPRITE_MODE_PLAYER) {
@@ -2808,48 +2937,50 @@ void render_with_watt_attack_palettes(b32 isNpcSprite, ActorPart* part, s32 yaw,
         brightness = WattAttackPalettesAnim[decorations->palAnimState];
     }
 
-    switch (brightness) {
-        case WATT_DEFAULT:
-            for (i = 0; i < decorations->spriteColorVariations; i++) {
-                palIn = decorations->originalPalettesList[i];
-                palOut = decorations->copiedPalettes[0][i];
-                if (palIn != NULL) {
-                    for (j = 0; j < SPR_PAL_SIZE; j++) {
-                        *palOut++ = *palIn++;
+    if (!part_pal_cache_hit(part, brightness, 0)) {
+        switch (brightness) {
+            case WATT_DEFAULT:
+                for (i = 0; i < decorations->spriteColorVariations; i++) {
+                    palIn = decorations->originalPalettesList[i];
+                    palOut = decorations->copiedPalettes[0][i];
+                    if (palIn != NULL) {
+                        for (j = 0; j < SPR_PAL_SIZE; j++) {
+                            *palOut++ = *palIn++;
+                        }
                     }
                 }
-            }
-            break;
-        case WATT_BRIGHTEST:
-            for (i = 0; i < decorations->spriteColorVariations; i++) {
-                // use watt's Brightest palettes
-                palIdx = decorations->spriteColorVariations * SPR_PAL_BattleWatt_Brightest + i;
-                palIn = decorations->originalPalettesList[palIdx];
-                palOut = decorations->copiedPalettes[0][i];
-                if (palIn != NULL) {
-                    for (j = 0; j < SPR_PAL_SIZE; j++) {
-                        *palOut++ = *palIn++;
+                break;
+            case WATT_BRIGHTEST:
+                for (i = 0; i < decorations->spriteColorVariations; i++) {
+                    // use watt's Brightest palettes
+                    palIdx = decorations->spriteColorVariations * SPR_PAL_BattleWatt_Brightest + i;
+                    palIn = decorations->originalPalettesList[palIdx];
+                    palOut = decorations->copiedPalettes[0][i];
+                    if (palIn != NULL) {
+                        for (j = 0; j < SPR_PAL_SIZE; j++) {
+                            *palOut++ = *palIn++;
+                        }
                     }
                 }
-            }
-            break;
-        case WATT_BRIGHTER:
-            for (i = 0; i < decorations->spriteColorVariations; i++) {
-                // use watt's Brighter palettes
-                palIdx = decorations->spriteColorVariations * SPR_PAL_BattleWatt_Brighter + i;
-                palIn = decorations->originalPalettesList[palIdx];
-                palOut = decorations->copiedPalettes[0][i];
-                if (palIn != NULL) {
-                    for (j = 0; j < SPR_PAL_SIZE; j++) {
-                        *palOut++ = *palIn++;
+                break;
+            case WATT_BRIGHTER:
+                for (i = 0; i < decorations->spriteColorVariations; i++) {
+                    // use watt's Brighter palettes
+                    palIdx = decorations->spriteColorVariations * SPR_PAL_BattleWatt_Brighter + i;
+                    palIn = decorations->originalPalettesList[palIdx];
+                    palOut = decorations->copiedPalettes[0][i];
+                    if (palIn != NULL) {
+                        for (j = 0; j < SPR_PAL_SIZE; j++) {
+                            *palOut++ = *palIn++;
+                        }
                     }
                 }
-            }
-            break;
-    }
+                break;
+        }
 
-    for (i = 0; i < decorations->originalPalettesCount; i++) {
-        decorations->adjustedPalettes[i] = decorations->copiedPalettes[0][i];
+        for (i = 0; i < decorations->originalPalettesCount; i++) {
+            decorations->adjustedPalettes[i] = decorations->copiedPalettes[0][i];
+        }
     }
 
     if (isNpcSprite == SPRITE_MODE_PLAYER) {
@@ -2939,31 +3070,33 @@ void render_with_player_debuff_palettes(b32 isNpcSprite, ActorPart* part, s32 ya
                 }
             }
             blendAlpha = decorations->palBlendAlpha / 100;
-            for (i = 0; i < decorations->spriteColorVariations; i++) {
-                if (!isPoison) {
-                    color2 = decorations->originalPalettesList[i];
-                } else {
-                    color2 = decorations->originalPalettesList[decorations->spriteColorVariations * STANDARD_PAL_POISON + i];
-                }
-                color1 = decorations->originalPalettesList[decorations->spriteColorVariations * STANDARD_PAL_DIZZY + i];
-                palOut = decorations->copiedPalettes[0][i];
-
-                for (j = 0; j < SPR_PAL_SIZE; j++) {
-                    u8 r2 = UNPACK_PAL_R(*color2);
-                    u8 g2 = UNPACK_PAL_G(*color2);
-                    u8 b2 = UNPACK_PAL_B(*color2);
-                    u8 r1 = UNPACK_PAL_R(*color1);
-                    u8 g1 = UNPACK_PAL_G(*color1);
-                    u8 b1 = UNPACK_PAL_B(*color1);
-                    u8 a1 = UNPACK_PAL_A(*color1);
-                    color2++;
-                    color1++;
-
-                    r1 = LERP_COMPONENT(r2, r1, blendAlpha);
-                    g1 = LERP_COMPONENT(g2, g1, blendAlpha);
-                    b1 = LERP_COMPONENT(b2, b1, blendAlpha);
+            if (!part_pal_cache_hit(part, 0, blendAlpha)) {
+                for (i = 0; i < decorations->spriteColorVariations; i++) {
+                    if (!isPoison) {
+                        color2 = decorations->originalPalettesList[i];
+                    } else {
+                        color2 = decorations->originalPalettesList[decorations->spriteColorVariations * STANDARD_PAL_POISON + i];
+                    }
+                    color1 = decorations->originalPalettesList[decorations->spriteColorVariations * STANDARD_PAL_DIZZY + i];
+                    palOut = decorations->copiedPalettes[0][i];
 
-                    *palOut++ = PACK_PAL_RGBA(r1, g1, b1, a1);
+                    for (j = 0; j < SPR_PAL_SIZE; j++) {
+                        u8 r2 = UNPACK_PAL_R(*color2);
+                        u8 g2 = UNPACK_PAL_G(*color2);
+                        u8 b2 = UNPACK_PAL_B(*color2);
+                        u8 r1 = UNPACK_PAL_R(*color1);
+                        u8 g1 = UNPACK_PAL_G(*color1);
+                        u8 b1 = UNPACK_PAL_B(*color1);
+                        u8 a1 = UNPACK_PAL_A(*color1);
+                        color2++;
+                        color1++;
+
+                        r1 = LERP_COMPONENT(r2, r1, blendAlpha);
+                        g1 = LERP_COMPONENT(g2, g1, blendAlpha);
+                        b1 = LERP_COMPONENT(b2, b1, blendAlpha);
+
+                        *palOut++ = PACK_PAL_RGBA(r1, g1, b1, a1);
+                    }
                 }
             }
             if (blendAlpha == 255) {
@@ -3066,27 +3199,29 @@ void render_with_pal_blending(b32 isNpcSprite, ActorPart* part, s32 yaw, b32 has
                 }
             }
             blendAlpha = decorations->palBlendAlpha / 100;
-            // blend two palettes
-            color2 = decorations->originalPalettesList[decorations->blendPalA];
-            color1 = decorations->originalPalettesList[decorations->blendPalB];
-            outColor = decorations->adjustedPalettes[0] = decorations->copiedPalettes[0][0];
+            if (!part_pal_cache_hit(part, PAL_SWAP_A_TO_B, blendAlpha)) {
+                // blend two palettes
+                color2 = decorations->originalPalettesList[decorations->blendPalA];
+                color1 = decorations->originalPalettesList[decorations->blendPalB];
+                outColor = decorations->adjustedPalettes[0] = decorations->copiedPalettes[0][0];
 
-            for (j = 0; j < SPR_PAL_SIZE; j++) {
-                r2 = UNPACK_PAL_R(*color2);
-                g2 = UNPACK_PAL_G(*color2);
-                b2 = UNPACK_PAL_B(*color2);
-                r1 = UNPACK_PAL_R(*color1);
-                g1 = UNPACK_PAL_G(*color1);
-                b1 = UNPACK_PAL_B(*color1);
-                a1 = UNPACK_PAL_A(*color1);
-                color2++;
-                color1++;
+                for (j = 0; j < SPR_PAL_SIZE; j++) {
+                    r2 = UNPACK_PAL_R(*color2);
+                    g2 = UNPACK_PAL_G(*color2);
+                    b2 = UNPACK_PAL_B(*color2);
+                    r1 = UNPACK_PAL_R(*color1);
+                    g1 = UNPACK_PAL_G(*color1);
+                    b1 = UNPACK_PAL_B(*color1);
+                    a1 = UNPACK_PAL_A(*color1);
+                    color2++;
+                    color1++;
 
-                r1 = LERP_COMPONENT(r2, r1, blendAlpha);
-                g1 = LERP_COMPONENT(g2, g1, blendAlpha);
-                b1 = LERP_COMPONENT(b2, b1, blendAlpha);
+                    r1 = LERP_COMPONENT(r2, r1, blendAlpha);
+                    g1 = LERP_COMPONENT(g2, g1, blendAlpha);
+                    b1 = LERP_COMPONENT(b2, b1, blendAlpha);
 
-                *outColor++ = PACK_PAL_RGBA(r1, g1, b1, a1);
+                    *outColor++ = PACK_PAL_RGBA(r1, g1, b1, a1);
+                }
             }
 
             if (blendAlpha == 255) {
@@ -3117,28 +3252,30 @@ void render_with_pal_blending(b32 isNpcSprite, ActorPart* part, s32 yaw, b32 has
                 }
             }
             blendAlpha = decorations->palBlendAlpha / 100;
-            // blend two palettes
-            color2 = decorations->originalPalettesList[decorations->blendPalB];
-            color1 = decorations->originalPalettesList[decorations->blendPalA];
-            outColor = decorations->copiedPalettes[0][0];
-            decorations->adjustedPalettes[0] = outColor;
+            if (!part_pal_cache_hit(part, PAL_SWAP_B_TO_A, blendAlpha)) {
+                // blend two palettes
+                color2 = decorations->originalPalettesList[decorations->blendPalB];
+                color1 = decorations->originalPalettesList[decorations->blendPalA];
+                outColor = decorations->copiedPalettes[0][0];
+                decorations->adjustedPalettes[0] = outColor;
 
-            for (j = 0; j < SPR_PAL_SIZE; j++) {
-                r2 = UNPACK_PAL_R(*color2);
-                g2 = UNPACK_PAL_G(*color2);
-                b2 = UNPACK_PAL_B(*color2);
-                r1 = UNPACK_PAL_R(*color1);
-                g1 = UNPACK_PAL_G(*color1);
-                b1 = UNPACK_PAL_B(*color1);
-                a1 = UNPACK_PAL_A(*color1);
-                color2++;
-                color1++;
-
-                r1 = LERP_COMPONENT(r2, r1, blendAlpha);
-                g1 = LERP_COMPONENT(g2, g1, blendAlpha);
-                b1 = LERP_COMPONENT(b2, b1, blendAlpha);
-
-                *outColor++ = PACK_PAL_RGBA(r1, g1, b1, a1);
+                for (j = 0; j < SPR_PAL_SIZE; j++) {
+                    r2 = UNPACK_PAL_R(*color2);
+                    g2 = UNPACK_PAL_G(*color2);
+                    b2 = UNPACK_PAL_B(*color2);
+                    r1 = UNPACK_PAL_R(*color1);
+                    g1 = UNPACK_PAL_G(*color1);
+                    b1 = UNPACK_PAL_B(*color1);
+                    a1 = UNPACK_PAL_A(*color1);
+                    color2++;
+                    color1++;
+
+                    r1 = LERP_COMPONENT(r2, r1, blendAlpha);
+                    g1 = LERP_COMPONENT(g2, g1, blendAlpha);
+                    b1 = LERP_COMPONENT(b2, b1, blendAlpha);
+
+                    *outColor++ = PACK_PAL_RGBA(r1, g1, b1, a1);
+                }
             }
             if (blendAlpha == 255) {
                 decorations->palAnimState = PAL_SWAP_HOLD_A;
@@ -3234,29 +3371,31 @@ void render_with_palset_blending(b32 isNpcSprite, ActorPart* part, s32 yaw, Matr
                 }
             }
             blendAlpha = decorations->palBlendAlpha / 100;
-            // blend all palettes from two palette sets
-            for (i = 0; i < decorations->spriteColorVariations; i++) {
-                color2 = decorations->originalPalettesList[decorations->blendPalA * decorations->spriteColorVariations + i];
-                color1 = decorations->originalPalettesList[decorations->blendPalB * decorations->spriteColorVariations + i];
-                outColor = decorations->copiedPalettes[0][i];
-                decorations->adjustedPalettes[i] = outColor;
+            if (!part_pal_cache_hit(part, PAL_SWAP_A_TO_B, blendAlpha)) {
+                // blend all palettes from two palette sets
+                for (i = 0; i < decorations->spriteColorVariations; i++) {
+                    color2 = decorations->originalPalettesList[decorations->blendPalA * decorations->spriteColorVariations + i];
+                    color1 = decorations->originalPalettesList[decorations->blendPalB * decorations->spriteColorVariations + i];
+                    outColor = decorations->copiedPalettes[0][i];
+                    decorations->adjustedPalettes[i] = outColor;
 
-                for (j = 0; j < SPR_PAL_SIZE; j++) {
-                    r2 = UNPACK_PAL_R(*color2);
-                    g2 = UNPACK_PAL_G(*color2);
-                    b2 = UNPACK_PAL_B(*color2);
-                    r1 = UNPACK_PAL_R(*color1);
-                    g1 = UNPACK_PAL_G(*color1);
-                    b1 = UNPACK_PAL_B(*color1);
-                    a1 = UNPACK_PAL_A(*color1);
-                    color2++;
-                    color1++;
-
-                    r1 = LERP_COMPONENT(r2, r1, blendAlpha);
-                    g1 = LERP_COMPONENT(g2, g1, blendAlpha);
-                    b1 = LERP_COMPONENT(b2, b1, blendAlpha);
-
-                    *outColor++ = PACK_PAL_RGBA(r1, g1, b1, a1);
+                    for (j = 0; j < SPR_PAL_SIZE; j++) {
+                        r2 = UNPACK_PAL_R(*color2);
+                        g2 = UNPACK_PAL_G(*color2);
+                        b2 = UNPACK_PAL_B(*color2);
+                        r1 = UNPACK_PAL_R(*color1);
+                        g1 = UNPACK_PAL_G(*color1);
+                        b1 = UNPACK_PAL_B(*color1);
+                        a1 = UNPACK_PAL_A(*color1);
+                        color2++;
+                        color1++;
+
+                        r1 = LERP_COMPONENT(r2, r1, blendAlpha);
+                        g1 = LERP_COMPONENT(g2, g1, blendAlpha);
+                        b1 = LERP_COMPONENT(b2, b1, blendAlpha);
+
+                        *outColor++ = PACK_PAL_RGBA(r1, g1, b1, a1);
+                    }
                 }
             }
             if (blendAlpha == 255) {
@@ -3286,29 +3425,31 @@ void render_with_palset_blending(b32 isNpcSprite, ActorPart* part, s32 yaw, Matr
                 }
             }
             blendAlpha = decorations->palBlendAlpha / 100;
-            // blend all palettes from two palette sets
-            for (i = 0; i < decorations->spriteColorVariations; i++) {
-                color2 = decorations->originalPalettesList[decorations->blendPalA * decorations->spriteColorVariations + i];
-                color1 = decorations->originalPalettesList[decorations->blendPalB * decorations->spriteColorVariations + i];
-                outColor = decorations->copiedPalettes[0][i];
-                decorations->adjustedPalettes[i] = outColor;
-
-                for (j = 0; j < SPR_PAL_SIZE; j++) {
-                    r2 = UNPACK_PAL_R(*color2);
-                    g2 = UNPACK_PAL_G(*color2);
-                    b2 = UNPACK_PAL_B(*color2);
-                    r1 = UNPACK_PAL_R(*color1);
-                    g1 = UNPACK_PAL_G(*color1);
-                    b1 = UNPACK_PAL_B(*color1);
-                    a1 = UNPACK_PAL_A(*color1);
-                    color2++;
-                    color1++;
-
-                    r1 = LERP_COMPONENT(r2, r1, blendAlpha);
-                    g1 = LERP_COMPONENT(g2, g1, blendAlpha);
-                    b1 = LERP_COMPONENT(b2, b1, blendAlpha);
+            if (!part_pal_cache_hit(part, PAL_SWAP_B_TO_A, blendAlpha)) {
+                // blend all palettes from two palette sets
+                for (i = 0; i < decorations->spriteColorVariations; i++) {
+                    color2 = decorations->originalPalettesList[decorations->blendPalA * decorations->spriteColorVariations + i];
+                    color1 = decorations->originalPalettesList[decorations->blendPalB * decorations->spriteColorVariations + i];
+                    outColor = decorations->copiedPalettes[0][i];
+                    decorations->adjustedPalettes[i] = outColor;
 
-                    *outColor++ = PACK_PAL_RGBA(r1, g1, b1, a1);
+                    for (j = 0; j < SPR_PAL_SIZE; j++) {
+                        r2 = UNPACK_PAL_R(*color2);
+                        g2 = UNPACK_PAL_G(*color2);
+                        b2 = UNPACK_PAL_B(*color2);
+                        r1 = UNPACK_PAL_R(*color1);
+                        g1 = UNPACK_PAL_G(*color1);
+                        b1 = UNPACK_PAL_B(*color1);
+                        a1 = UNPACK_PAL_A(*color1);
+                        color2++;
+                        color1++;
+
+                        r1 = LERP_COMPONENT(r2, r1, blendAlpha);
+                        g1 = LERP_COMPONENT(g2, g1, blendAlpha);
+                        b1 = LERP_COMPONENT(b2, b1, blendAlpha);
+
+                        *outColor++ = PACK_PAL_RGBA(r1, g1, b1, a1);
+                    }
                 }
             }
             if (blendAlpha == 255) {
@@ -16,6 +16,112 @@ Gfx* gMainGfxPos;
 DisplayContext* gDisplayContext;
 Camera gCameras[4];
 
+// Matrices built by update_cameras for the view they were computed from. While the view of a camera stays the same,
+// they are copied back instead of being rebuilt, since other code overwrites the matrices in the Camera itself.
+typedef struct CameraMatrixCache {
+    /* 0x000 */ b8 valid;
+    /* 0x001 */ b8 current; // the camera's matrices this frame are the cached ones
+    /* 0x002 */ b8 perspMtxValid;
+    /* 0x003 */ b8 ortho;
+    /* 0x004 */ Vec3f eye;
+    /* 0x010 */ Vec3f obj;
+    /* 0x01C */ f32 vfov;
+    /* 0x020 */ s16 viewportW;
+    /* 0x022 */ s16 viewportH;
+    /* 0x024 */ s16 nearClip;
+    /* 0x026 */ s16 farClip;
+    /* 0x028 */ u16 perspNorm;
+    /* 0x02C */ Matrix4f mtxPerspective;
+    /* 0x06C */ Matrix4f mtxViewPlayer;
+    /* 0x0AC */ char pad_AC[4];
+    /* 0x0B0 */ Mtx perspMtx;
+    /* 0x0F0 */ LookAt lookAt;
+} CameraMatrixCache; // size = 0x110
+
+BSS CameraMatrixCache CameraMatrixCaches[ARRAY_COUNT(gCameras)];
+
+// State set up before each camera is drawn, apart from the viewport, scissor, and framebuffer
+Gfx CameraRenderSetupGfx[] = {
+    gsSPClearGeometryMode(G_SHADE | G_CULL_BOTH | G_FOG | G_LIGHTING | G_TEXTURE_GEN | G_TEXTURE_GEN_LINEAR | G_LOD
+                          | G_SHADING_SMOOTH),
+    gsSPTexture(0, 0, 0, G_TX_RENDERTILE, G_OFF),
+    gsDPSetCycleType(G_CYC_1CYCLE),
+    gsDPPipelineMode(G_PM_NPRIMITIVE),
+    gsDPSetTextureLOD(G_TL_TILE),
+    gsDPSetTextureLUT(G_TT_NONE),
+    gsDPSetTextureDetail(G_TD_CLAMP),
+    gsDPSetTexturePersp(G_TP_PERSP),
+    gsDPSetTextureFilter(G_TF_BILERP),
+    gsDPSetTextureConvert(G_TC_FILT),
+    gsDPSetCombineMode(G_CC_SHADE, G_CC_SHADE),
+    gsDPSetCombineKey(G_CK_NONE),
+    gsDPSetAlphaCompare(G_AC_NONE),
+    gsDPSetRenderMode(G_RM_OPA_SURF, G_RM_OPA_SURF2),
+    gsDPSetColorDither(G_CD_DISABLE),
+    gsSPClipRatio(FRUSTRATIO_2),
+    gsSPEndDisplayList(),
+};
+
+// Shaking, leading, and the chaos camera effects change the matrices without changing the view
+b32 can_cache_camera_matrices(Camera* cam) {
+    return !(cam->flags & (CAMERA_FLAG_SHAKING | CAMERA_FLAG_LEAD_PLAYER))
+        && !chaosStatus.rotateCamera && !chaosStatus.zoomedOut;
+}
+
+// Restores the matrices of a camera if its view is the same as when they were last built
+b32 reuse_camera_matrices(s32 camID) {
+    Camera* cam = &gCameras[camID];
+    CameraMatrixCache* cache = &CameraMatrixCaches[camID];
+
+    cache->current = FALSE;
+
+    if (!cache->valid || !can_cache_camera_matrices(cam)) {
+        return FALSE;
+    }
+
+    if (cache->ortho != ((cam->flags & CAMERA_FLAG_ORTHO) != 0)
+        || cache->eye.x != cam->lookAt_eye.x || cache->eye.y != cam->lookAt_eye.y || cache->eye.z != cam->lookAt_eye.z
+        || cache->obj.x != cam->lookAt_obj.x || cache->obj.y != cam->lookAt_obj.y || cache->obj.z != cam->lookAt_obj.z
+        || cache->vfov != cam->vfov || cache->viewportW != cam->viewportW || cache->viewportH != cam->viewportH
+        || cache->nearClip != cam->nearClip || cache->farClip != cam->farClip
+    ) {
+        return FALSE;
+    }
+
+    gDisplayContext->lookAt = cache->lookAt;
+    bcopy(cache->mtxViewPlayer, cam->mtxViewPlayer, sizeof(Matrix4f));
+    bcopy(cache->mtxPerspective, cam->mtxPerspective, sizeof(Matrix4f));
+    cam->perspNorm = cache->perspNorm;
+    cache->current = TRUE;
+    return TRUE;
+}
+
+void save_camera_matrices(s32 camID) {
+    Camera* cam = &gCameras[camID];
+    CameraMatrixCache* cache = &CameraMatrixCaches[camID];
+
+    if (!can_cache_camera_matrices(cam)) {
+        cache->valid = FALSE;
+        return;
+    }
+
+    cache->valid = TRUE;
+    cache->current = TRUE;
+    cache->perspMtxValid = FALSE;
+    cache->ortho = (cam->flags & CAMERA_FLAG_ORTHO) != 0;
+    cache->eye = cam->lookAt_eye;
+    cache->obj = cam->lookAt_obj;
+    cache->vfov = cam->vfov;
+    cache->viewportW = cam->viewportW;
+    cache->viewportH = cam->viewportH;
+    cache->nearClip = cam->nearClip;
+    cache->farClip = cam->farClip;
+    cache->perspNorm = cam->perspNorm;
+    cache->lookAt = gDisplayContext->lookAt;
+    bcopy(cam->mtxViewPlayer, cache->mtxViewPlayer, sizeof(Matrix4f));
+    bcopy(cam->mtxPerspective, cache->mtxPerspective, sizeof(Matrix4f));
+}
+
 void update_cameras(void) {
     s32 sx, sy, sz;
     s32 camID;
@@ -54,37 +160,41 @@ void update_cameras(void) {
                 break;
         }
 
-        guLookAtReflectF(cam->mtxViewPlayer, &gDisplayContext->lookAt, cam->lookAt_eye.x, cam->lookAt_eye.y, cam->lookAt_eye.z, cam->lookAt_obj.x, cam->lookAt_obj.y, cam->lookAt_obj.z, 0, 1.0f, 0);
+        if (!reuse_camera_matrices(camID)) {
+            guLookAtReflectF(cam->mtxViewPlayer, &gDisplayContext->lookAt, cam->lookAt_eye.x, cam->lookAt_eye.y, cam->lookAt_eye.z, cam->lookAt_obj.x, cam->lookAt_obj.y, cam->lookAt_obj.z, 0, 1.0f, 0);
 
-        if (!(cam->flags & CAMERA_FLAG_ORTHO)) {
-            if (cam->flags & CAMERA_FLAG_LEAD_PLAYER) {
-                create_camera_leadplayer_matrix(cam);
-            }
+            if (!(cam->flags & CAMERA_FLAG_ORTHO)) {
+                if (cam->flags & CAMERA_FLAG_LEAD_PLAYER) {
+                    create_camera_leadplayer_matrix(cam);
+                }
 
-            guPerspectiveF(cam->mtxPerspective, &cam->perspNorm, cam->vfov, (f32) cam->viewportW / (f32) cam->viewportH, (f32) cam->nearClip, (f32) cam->farClip, 1.0f);
+                guPerspectiveF(cam->mtxPerspective, &cam->perspNorm, cam->vfov, (f32) cam->viewportW / (f32) cam->viewportH, (f32) cam->nearClip, (f32) cam->farClip, 1.0f);
 
-            if (cam->flags & CAMERA_FLAG_SHAKING) {
-                guMtxCatF(cam->mtxViewShaking, cam->mtxPerspective, cam->mtxPerspective);
-            }
+                if (cam->flags & CAMERA_FLAG_SHAKING) {
+                    guMtxCatF(cam->mtxViewShaking, cam->mtxPerspective, cam->mtxPerspective);
+                }
 
-            if (cam->flags & CAMERA_FLAG_LEAD_PLAYER) {
-                guMtxCatF(cam->mtxViewLeading, cam->mtxPerspective, cam->mtxPerspective);
-            }
+                if (cam->flags & CAMERA_FLAG_LEAD_PLAYER) {
+                    guMtxCatF(cam->mtxViewLeading, cam->mtxPerspective, cam->mtxPerspective);
+                }
 
-            if (chaosStatus.rotateCamera) {
-                guMtxCatF(chaosStatus.rotateMtx, cam->mtxPerspective, cam->mtxPerspective);
-            }
+                if (chaosStatus.rotateCamera) {
+                    guMtxCatF(chaosStatus.rotateMtx, cam->mtxPerspective, cam->mtxPerspective);
+                }
 
-            if (chaosStatus.zoomedOut) {
-                guMtxCatF(chaosStatus.zoomedOutMtx, cam->mtxPerspective, cam->mtxPerspective);
-            }
+                if (chaosStatus.zoomedOut) {
+                    guMtxCatF(chaosStatus.zoomedOutMtx, cam->mtxPerspective, cam->mtxPerspective);
+                }
 
-            guMtxCatF(cam->mtxViewPlayer, cam->mtxPerspective, cam->mtxPerspective);
-        } else {
-            f32 w = cam->viewportW;
-            f32 h = cam->viewportH;
+                guMtxCatF(cam->mtxViewPlayer, cam->mtxPerspective, cam->mtxPerspective);
+            } else {
+                f32 w = cam->viewportW;
+                f32 h = cam->viewportH;
+
+                guOrthoF(cam->mtxPerspective, -w * 0.5, w * 0.5, -h * 0.5, h * 0.5, -1000.0f, 1000.0f, 1.0f);
+            }
 
-            guOrthoF(cam->mtxPerspective, -w * 0.5, w * 0.5, -h * 0.5, h * 0.5, -1000.0f, 1000.0f, 1.0f);
+            save_camera_matrices(camID);
         }
 
         get_screen_coords(CAM_DEFAULT, cam->targetPos.x, cam->targetPos.y, cam->targetPos.z, &sx, &sy, &sz);
@@ -128,17 +238,14 @@ void render_frame(s32 isSecondPass) {
         if (camera->fpDoPreRender != NULL) {
             camera->fpDoPreRender(camera);
         } else {
+            CameraMatrixCache* cache = &CameraMatrixCaches[camID];
             s32 ulx;
             s32 uly;
             s32 lrx;
             s32 lry;
 
             gSPViewport(gMainGfxPos++, &camera->vp);
-            gSPClearGeometryMode(gMainGfxPos++, G_SHADE | G_CULL_BOTH | G_FOG | G_LIGHTING | G_TEXTURE_GEN |
-                                    G_TEXTURE_GEN_LINEAR | G_LOD | G_SHADING_SMOOTH);
-            gSPTexture(gMainGfxPos++, 0, 0, 0, G_TX_RENDERTILE, G_OFF);
-            gDPSetCycleType(gMainGfxPos++, G_CYC_1CYCLE);
-            gDPPipelineMode(gMainGfxPos++, G_PM_NPRIMITIVE);
+            gSPDisplayList(gMainGfxPos++, CameraRenderSetupGfx);
 
             ulx = camera->viewportStartX;
             uly = camera->viewportStartY;
@@ -172,18 +279,6 @@ void render_frame(s32 isSecondPass) {
             }
 
             gDPSetScissor(gMainGfxPos++, G_SC_NON_INTERLACE, ulx, uly, lrx, lry);
-            gDPSetTextureLOD(gMainGfxPos++, G_TL_TILE);
-            gDPSetTextureLUT(gMainGfxPos++, G_TT_NONE);
-            gDPSetTextureDetail(gMainGfxPos++, G_TD_CLAMP);
-            gDPSetTexturePersp(gMainGfxPos++, G_TP_PERSP);
-            gDPSetTextureFilter(gMainGfxPos++, G_TF_BILERP);
-            gDPSetTextureConvert(gMainGfxPos++, G_TC_FILT);
-            gDPSetCombineMode(gMainGfxPos++, G_CC_SHADE, G_CC_SHADE);
-            gDPSetCombineKey(gMainGfxPos++, G_CK_NONE);
-            gDPSetAlphaCompare(gMainGfxPos++, G_AC_NONE);
-            gDPSetRenderMode(gMainGfxPos++, G_RM_OPA_SURF, G_RM_OPA_SURF2);
-            gDPSetColorDither(gMainGfxPos++, G_CD_DISABLE);
-            gSPClipRatio(gMainGfxPos++, FRUSTRATIO_2);
             gDPSetColorImage(gMainGfxPos++, G_IM_FMT_RGBA, G_IM_SIZ_16b, SCREEN_WIDTH,
                                 osVirtualToPhysical(nuGfxCfb_ptr));
             gDPPipeSync(gMainGfxPos++);
@@ -192,7 +287,16 @@ void render_frame(s32 isSecondPass) {
                 gSPPerspNormalize(gMainGfxPos++, camera->perspNorm);
             }
 
-            guMtxF2L(camera->mtxPerspective, &gDisplayContext->camPerspMatrix[gCurrentCamID]);
+            // the fixed point matrix only needs converting once for each set of matrices update_cameras builds
+            if (cache->current && cache->perspMtxValid) {
+                gDisplayContext->camPerspMatrix[gCurrentCamID] = cache->perspMtx;
+            } else {
+                guMtxF2L(camera->mtxPerspective, &gDisplayContext->camPerspMatrix[gCurrentCamID]);
+                if (cache->current) {
+                    cache->perspMtx = gDisplayContext->camPerspMatrix[gCurrentCamID];
+                    cache->perspMtxValid = TRUE;
+                }
+            }
             gSPMatrix(gMainGfxPos++, &gDisplayContext->camPerspMatrix[gCurrentCamID], G_MTX_NOPUSH | G_MTX_LOAD |
                         G_MTX_PROJECTION);
         }
@@ -2,6 +2,7 @@
 #include "dx/debug_menu.h"
 #include "dx/utils.h"
 #include "game_modes.h"
+#include "dx/replay.h"
 
 #define MAX_EFFECT_INTERVAL 15
 #define MIN_EFFECT_LENGTH 10
@@ -154,6 +155,7 @@ static void drawEffectList() {
 
 static void activateEffect(s32 effectId) {
     ChaosEffectData *effect = &effectData[effectId];
+    dx_replay_note_chaos_effect(effectId);
     if (!effect->everyFrame) {
         effect->func(effect);
     }
@@ -544,12 +544,7 @@ static b8 canSpawnItem() {
     if (gGameStatus.context != 0) {
         return FALSE;
     }
-    for (s32 i = 0; i < MAX_ITEM_ENTITIES; i++) {
-        if (gCurrentItemEntities[i] == NULL) {
-            return TRUE;
-        }
-    }
-    return FALSE;
+    return has_free_item_entity_slot();
 }
 
 static b8 hasItem(void) {
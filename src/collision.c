@@ -1,5 +1,6 @@
 #include "common.h"
 #include "model.h"
+#include "dx/debug_menu.h"
 
 typedef struct HitFile {
     /* 0x00 */ u32 collisionOffset;
@@ -214,6 +215,10 @@ void load_hit_data(s32 idx, HitFile* hit) {
 
             assetCollisionData = (HitFileHeader*)((void*)hit + collisionOffset);
             collisionData = &gCollisionData;
+
+            #if DX_DEBUG_MENU
+            dx_debug_invalidate_collision(-1);
+            #endif
             break;
         case 1: // Zones
             collisionOffset = map->hitAssetZoneOffset;
@@ -476,6 +481,10 @@ void update_collider_transform(s16 colliderID) {
         triangle->normal.y = normalY * coeff;
         triangle->normal.z = normalZ * coeff;
     }
+
+    #if DX_DEBUG_MENU
+    dx_debug_invalidate_collision(colliderID);
+    #endif
 }
 
 s32 get_collider_flags(s32 colliderID) {
@@ -4,6 +4,7 @@
 #include "libc/xstdio.h"
 #include "gcc/string.h"
 #include "dx/backtrace.h"
+#include "dx/replay.h"
 #include "include_asset.h"
 
 typedef struct {
@@ -411,6 +412,9 @@ void crash_screen_thread_entry(void* unused) {
     } while (faultedThread == NULL);
 
     osStopThread(faultedThread);
+    // deliver whatever was logged right before the crash
+    is_debug_flush_crash();
+    dx_replay_stop();
     crash_screen_draw(faultedThread);
 
     while (TRUE) {}
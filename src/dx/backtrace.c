@@ -318,6 +318,55 @@ int backtrace_thread(void **buffer, int size, OSThread *thread) {
     return ctx.i;
 }
 
+/** @brief Maximum number of entries of the sparse symbol index kept in RAM (see append_symbol_table.py). */
+#define SYMBOL_INDEX_MAX 1024
+
+/** @brief Number of symbols read from ROM at once while scanning between two index entries. */
+#define SYMBOL_CHUNK_COUNT 256
+
+static s32 symtState = 0; // 0 = not loaded yet, 1 = loaded, -1 = no usable symbol table
+static u32 symtRomAddr;
+static SymbolTable symt;
+static u32 symtIndex[SYMBOL_INDEX_MAX] ALIGNED(16);
+
+/** @brief Reads the symbol table header and its sparse index the first time a symbol is looked up. */
+static bool symbol_table_load(void) {
+    static u32 romHeader[0x10] ALIGNED(16);
+
+    if (symtState != 0) {
+        return symtState > 0;
+    }
+    symtState = -1;
+
+    nuPiReadRom(0, &romHeader, sizeof(romHeader));
+    symtRomAddr = romHeader[SYMBOL_TABLE_PTR_ROM_ADDR / sizeof(*romHeader)];
+    if (symtRomAddr == NULL) {
+        osSyncPrintf("address2symbol: no symbols available (SYMBOL_TABLE_PTR is NULL)\n");
+        return false;
+    }
+
+    // Read the header
+    nuPiReadRom(symtRomAddr, &symt, sizeof(SymbolTable));
+    if (symt.magic[0] != 'S' || symt.magic[1] != 'Y' || symt.magic[2] != 'M' || symt.magic[3] != '2') {
+        osSyncPrintf("address2symbol: no symbols available (invalid magic '%c%c%c%c')\n", symt.magic[0], symt.magic[1], symt.magic[2], symt.magic[3]);
+        return false;
+    }
+    if (symt.symbolCount <= 0) {
+        osSyncPrintf("address2symbol: no symbols available (symbolCount=%d)\n", symt.symbolCount);
+        return false;
+    }
+    if (symt.indexStride == 0 || symt.indexCount > SYMBOL_INDEX_MAX
+        || symt.indexCount != (symt.symbolCount + symt.indexStride - 1) / symt.indexStride
+    ) {
+        osSyncPrintf("address2symbol: no symbols available (bad index, stride=%d count=%d)\n", symt.indexStride, symt.indexCount);
+        return false;
+    }
+
+    nuPiReadRom(symt.indexOffset, symtIndex, symt.indexCount * sizeof(*symtIndex));
+    symtState = 1;
+    return true;
+}
+
 /**
  * @brief Uses the symbol table to look up the symbol corresponding to the given address.
  *
@@ -328,52 +377,50 @@ int backtrace_thread(void **buffer, int size, OSThread *thread) {
  * @return Offset into out->address, -1 if not found
  */
 s32 address2symbol(u32 address, Symbol* out) {
-    #define symbolsPerChunk 0x1000
-    #define chunkSize ((sizeof(Symbol) * symbolsPerChunk))
+    static Symbol chunk[SYMBOL_CHUNK_COUNT] ALIGNED(16);
+    s32 lo, hi, mid;
+    u32 i, j, end, count;
 
-    static u32 romHeader[0x10];
-    nuPiReadRom(0, &romHeader, sizeof(romHeader));
-
-    u32 symbolTableRomAddr = romHeader[SYMBOL_TABLE_PTR_ROM_ADDR / sizeof(*romHeader)];
-    if (symbolTableRomAddr == NULL) {
-        osSyncPrintf("address2symbol: no symbols available (SYMBOL_TABLE_PTR is NULL)\n");
+    if (!symbol_table_load()) {
         return -1;
     }
 
-    // Read the header
-    SymbolTable symt;
-    nuPiReadRom(symbolTableRomAddr, &symt, sizeof(SymbolTable));
-    if (symt.magic[0] != 'S' || symt.magic[1] != 'Y' || symt.magic[2] != 'M' || symt.magic[3] != 'S') {
-        osSyncPrintf("address2symbol: no symbols available (invalid magic '%c%c%c%c')\n", symt.magic[0], symt.magic[1], symt.magic[2], symt.magic[3]);
+    // Find the last index entry at or before the address. symtIndex[i] is the address of symbol i * indexStride.
+    if (address < symtIndex[0]) {
         return -1;
     }
-    if (symt.symbolCount <= 0) {
-        osSyncPrintf("address2symbol: no symbols available (symbolCount=%d)\n", symt.symbolCount);
-        return -1;
-    }
-
-    // Read symbols in chunks
-    static Symbol chunk[chunkSize];
-    s32 i;
-    for (i = 0; i < symt.symbolCount; i++) {
-        // Do we need to load the next chunk?
-        if (i % symbolsPerChunk == 0) {
-            u32 chunkAddr = symbolTableRomAddr + sizeof(SymbolTable) + (i / symbolsPerChunk) * chunkSize;
-            nuPiReadRom(chunkAddr, chunk, chunkSize);
+    lo = 0;
+    hi = symt.indexCount;
+    while (hi - lo > 1) {
+        mid = (lo + hi) / 2;
+        if (symtIndex[mid] <= address) {
+            lo = mid;
+        } else {
+            hi = mid;
         }
+    }
 
-        Symbol sym = chunk[i % symbolsPerChunk];
-
-        if (sym.address == address) {
-            *out = sym;
-            return 0;
-        } else if (address < sym.address) {
-            // Symbols are sorted by address, so if we passed the address, we can stop
-            break;
-        } else {
-            // Keep searching, but remember this as the last symbol
-            // incase we don't find an exact match
-            *out = sym;
+    // The symbol is somewhere in the following indexStride symbols
+    i = lo * symt.indexStride;
+    end = MIN(i + symt.indexStride, symt.symbolCount);
+    for (; i < end; i += count) {
+        count = MIN(end - i, SYMBOL_CHUNK_COUNT);
+        nuPiReadRom(symtRomAddr + sizeof(SymbolTable) + i * sizeof(Symbol), chunk, count * sizeof(Symbol));
+
+        for (j = 0; j < count; j++) {
+            Symbol sym = chunk[j];
+
+            if (sym.address == address) {
+                *out = sym;
+                return 0;
+            } else if (address < sym.address) {
+                // Symbols are sorted by address, so if we passed the address, we can stop
+                return address - out->address;
+            } else {
+                // Keep searching, but remember this as the last symbol
+                // incase we don't find an exact match
+                *out = sym;
+            }
         }
     }
     return address - out->address;
@@ -18,10 +18,13 @@ typedef struct Symbol {
 } Symbol;
 
 typedef struct SymbolTable {
-    char magic[4]; // "SYMS"
+    char magic[4]; // "SYM2"
     u32 symbolCount;
+    u32 indexStride; ///< Number of symbols between two entries of the index.
+    u32 indexCount; ///< Number of entries in the index.
+    u32 indexOffset; ///< ROM address of the index, the address of every indexStride'th symbol.
     struct Symbol symbols[0];
-    // then lots of strings
+    // then lots of strings, then the index
 } SymbolTable;
 
 /**
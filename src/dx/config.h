@@ -42,8 +42,45 @@
 /// Press L + D-Pad Up to show/hide the profiler.
 #define USE_PROFILER 1
 
+/// Sends every profiler sample to the IS-Viewer as a binary record each frame, for capturing long sessions.
+/// Decode a capture with tools/profiler_stream.py. Requires USE_PROFILER.
+#define DX_PROFILER_STREAM 0
+
+/// Records controller input from boot and streams it to the IS-Viewer (DX_REPLAY_RECORD), or plays back a
+/// recording converted with tools/replay.py into src/dx/replay_data.inc.c (DX_REPLAY_PLAY). 0 disables both.
+#define DX_REPLAY 0
+
+/// Number of 0x500-byte buffers the audio engine keeps resident for samples streamed from ROM.
+/// Each one is allocated from the audio heap.
+#define DX_AUDIO_DMA_BUFFERS 50
+
+/// How many of those buffers may be pinned to hold the start of frequently played instruments.
+#define DX_AUDIO_DMA_PINNED 12
+
+/// Maximum number of new sight rays enemies may cast toward the player each frame.
+/// Enemies over budget reuse their last result for a few frames.
+#define DX_ENEMY_SIGHT_RAYS_PER_FRAME 4
+
 /// Skip laggy blur operations when opening the pause menu on emulator
-#define DX_PAUSE_LAG_FIX 1
+#define DX_PAUSE_LAG_FIX 0
+
+/// Number of frames the pause menu background blur is spread over. Drawing is held for 4 frames while the
+/// pause menu loads, so this can be at most 3.
+#define DX_PAUSE_BLUR_SLICES 3
+
+/// Size in bytes of the per-frame scratch arena (see src/dx/frame_arena.h).
+#define DX_FRAME_ARENA_SIZE 0x2000
+
+/// Checks every NPC and enemy lookup by ID against a scan of all NPCs and encounters. Slow, for debugging only.
+#define DX_CHECK_NPC_LOOKUP 0
+
+/// Rebuilds battle actor status palettes on every cache hit and checks that the cached ones were identical. Slow, for
+/// debugging only.
+#define DX_CHECK_PAL_CACHE 0
+
+/// Draws the motion blur ghosts of battle actors without sprite shading, and draws fewer of them while frames take
+/// longer than 1/30 s. Several blurred actors at once (e.g. during multi-hit moves) otherwise drop frames.
+#define DX_CHEAP_ACTOR_BLUR 0
 
 #define CHAOS_DEBUG 1
 
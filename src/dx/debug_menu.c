@@ -1645,6 +1645,10 @@ void dx_debug_update_view_collision() {
     if (DebugCollisionPos != DBC_FADE_DIST) {
         if (NAV_LEFT || NAV_RIGHT) {
             DebugCollisionMenu[DebugCollisionPos].state = !DebugCollisionMenu[DebugCollisionPos].state;
+            if (DebugCollisionPos == DBC_EXTRUDE_FACES) {
+                // cached vertex positions depend on this
+                dx_debug_invalidate_collision(-1);
+            }
         }
     } else {
         s32 fadeDist = DebugCollisionMenu[DebugCollisionPos].state;
@@ -1688,9 +1692,12 @@ void dx_debug_add_collision_vtx(Vtx_t* vtxBuffer, Vec3f* vert, Vec3f* normal, s3
 }
 
 #define MAX_DEBUG_TRIS 1024
+#define MAX_DEBUG_CACHE_COLLIDERS 256
+#define NUM_DEBUG_DEPTH_BINS 32
 
 typedef struct DebugTriangle {
     ColliderTriangle* tri;
+    Vtx_t* cached; // base vertices from DebugCacheVtx, NULL if the collider isn't cached
     s16 depth;
     s16 colliderID;
 } DebugTriangle;
@@ -1698,16 +1705,116 @@ typedef struct DebugTriangle {
 DebugTriangle DebugTris[MAX_DEBUG_TRIS];
 s32 DebugTriPos;
 
+// indices into DebugTris, ordered back to front by depth bin
+s16 DebugTriOrder[MAX_DEBUG_TRIS];
+s16 DebugDepthBinStart[NUM_DEBUG_DEPTH_BINS + 1];
+
 Vtx_t DebugVtxBuf[3 * MAX_DEBUG_TRIS];
 s32 DebugVtxPos;
 
+// Vertex positions and colors of collider triangles only change when the map is loaded or the collider is moved by
+// update_collider_transform, so they are built once and only the alpha is filled in each frame. Colliders that
+// don't fit in the cache are built from scratch every frame instead.
+typedef struct DebugColliderCache {
+    s16 firstTri; // into DebugCacheVtx, -1 if not cached
+    b16 valid;
+} DebugColliderCache;
+
+DebugColliderCache DebugColliderCaches[MAX_DEBUG_CACHE_COLLIDERS];
+Vtx_t DebugCacheVtx[3 * MAX_DEBUG_TRIS];
+b32 DebugCollisionCacheReady;
+
+void dx_debug_invalidate_collision(s32 colliderID) {
+    if (colliderID < 0) {
+        DebugCollisionCacheReady = FALSE;
+    } else if (colliderID < MAX_DEBUG_CACHE_COLLIDERS) {
+        DebugColliderCaches[colliderID].valid = FALSE;
+    }
+}
+
+void dx_debug_get_collision_color(ColliderTriangle* tri, s32* r, s32* g, s32* b) {
+    *r = round(fabs(tri->normal.x) * 245.0);
+    *g = round(fabs(tri->normal.y) * 245.0);
+    *b = round(fabs(tri->normal.z) * 245.0);
+}
+
+Vtx_t* dx_debug_get_cached_collider_vtx(s32 colliderID) {
+    Collider* collider = &gCollisionData.colliderList[colliderID];
+    DebugColliderCache* cache;
+    Vtx_t* vtx;
+    s32 r, g, b;
+    s32 i;
+
+    if (!DebugCollisionCacheReady) {
+        s32 next = 0;
+
+        for (i = 0; i < MAX_DEBUG_CACHE_COLLIDERS && i < gCollisionData.numColliders; i++) {
+            cache = &DebugColliderCaches[i];
+            if (next + gCollisionData.colliderList[i].numTriangles <= MAX_DEBUG_TRIS) {
+                cache->firstTri = next;
+                next += gCollisionData.colliderList[i].numTriangles;
+            } else {
+                cache->firstTri = -1;
+            }
+            cache->valid = FALSE;
+        }
+        DebugCollisionCacheReady = TRUE;
+    }
+
+    if (colliderID >= MAX_DEBUG_CACHE_COLLIDERS || DebugColliderCaches[colliderID].firstTri < 0) {
+        return NULL;
+    }
+
+    cache = &DebugColliderCaches[colliderID];
+    vtx = &DebugCacheVtx[3 * cache->firstTri];
+    if (!cache->valid) {
+        for (i = 0; i < collider->numTriangles; i++) {
+            ColliderTriangle* tri = &collider->triangleTable[i];
+
+            dx_debug_get_collision_color(tri, &r, &g, &b);
+            dx_debug_add_collision_vtx(&vtx[3 * i + 0], tri->v1, &tri->normal, r, g, b, 0);
+            dx_debug_add_collision_vtx(&vtx[3 * i + 1], tri->v2, &tri->normal, r, g, b, 0);
+            dx_debug_add_collision_vtx(&vtx[3 * i + 2], tri->v3, &tri->normal, r, g, b, 0);
+        }
+        cache->valid = TRUE;
+    }
+    return vtx;
+}
+
+// TRUE unless all eight corners of the box are outside the same clip plane
+b32 dx_debug_is_aabb_visible(Matrix4f mtx, ColliderBoundingBox* aabb) {
+    u32 outside = 0x3F;
+    s32 i;
+
+    for (i = 0; i < 8 && outside != 0; i++) {
+        f32 outX, outY, outZ, outW;
+        u32 planes = 0;
+
+        transform_point(mtx,
+            (i & 1) ? aabb->max.x : aabb->min.x,
+            (i & 2) ? aabb->max.y : aabb->min.y,
+            (i & 4) ? aabb->max.z : aabb->min.z,
+            1.0f, &outX, &outY, &outZ, &outW);
+
+        if (outX < -outW) planes |= 0x01;
+        if (outX > outW)  planes |= 0x02;
+        if (outY < -outW) planes |= 0x04;
+        if (outY > outW)  planes |= 0x08;
+        if (outZ < -outW) planes |= 0x10;
+        if (outZ > outW)  planes |= 0x20;
+        outside &= planes;
+    }
+
+    return outside == 0;
+}
+
 void dx_debug_draw_collision() {
-    DebugTriangle temp;
     s32 rdpBufPos;
     b32 culling;
     s32 fadeDist;
     s32 i, j;
     s32 dist;
+    s32 minDepth, maxDepth, binRange;
 
     Camera* camera = &gCameras[gCurrentCameraID];
 
@@ -1717,13 +1824,27 @@ void dx_debug_draw_collision() {
 
     // find all collider trianges
     DebugTriPos = 0;
+    minDepth = 0x7FFF;
+    maxDepth = -0x8000;
     for (i = 0; i < gCollisionData.numColliders; i++) {
         Collider* collider = &gCollisionData.colliderList[i];
+        Vtx_t* cached;
 
         if (collider->flags & COLLIDER_FLAG_IGNORE_PLAYER && !DebugCollisionMenu[DBC_SHOW_DISABLED].state) {
             continue;
         }
 
+        if (collider->numTriangles == 0) {
+            continue;
+        }
+
+        // skip colliders entirely outside the view
+        if (collider->aabb != NULL && !dx_debug_is_aabb_visible(camera->mtxPerspective, collider->aabb)) {
+            continue;
+        }
+
+        cached = dx_debug_get_cached_collider_vtx(i);
+
         for (j = 0; j < collider->numTriangles; j++) {
             if (DebugTriPos < MAX_DEBUG_TRIS) {
                 ColliderTriangle* tri = &collider->triangleTable[j];
@@ -1739,8 +1860,12 @@ void dx_debug_draw_collision() {
                     DebugTriPos--;
                 } else {
                     DebugTris[DebugTriPos].tri = tri;
+                    DebugTris[DebugTriPos].cached = (cached != NULL) ? &cached[3 * j] : NULL;
                     DebugTris[DebugTriPos].depth = outZ;
                     DebugTris[DebugTriPos].colliderID = i;
+
+                    minDepth = MIN(minDepth, DebugTris[DebugTriPos].depth);
+                    maxDepth = MAX(maxDepth, DebugTris[DebugTriPos].depth);
                 }
             }
             DebugTriPos++;
@@ -1749,10 +1874,23 @@ void dx_debug_draw_collision() {
 
     ASSERT(DebugTriPos < MAX_DEBUG_TRIS)
 
-    // sort triangles by depth
-#define LESS(i, j) DebugTris[i].depth > DebugTris[j].depth
-#define SWAP(i, j) temp = DebugTris[i], DebugTris[i] = DebugTris[j], DebugTris[j] = temp
-    QSORT(DebugTriPos, LESS, SWAP);
+    // order triangles back to front by coarse depth bins, which is plenty for translucent debug geometry
+    binRange = maxDepth - minDepth + 1;
+    for (i = 0; i <= NUM_DEBUG_DEPTH_BINS; i++) {
+        DebugDepthBinStart[i] = 0;
+    }
+    for (i = 0; i < DebugTriPos; i++) {
+        // bin 0 holds the farthest triangles
+        s32 bin = (maxDepth - DebugTris[i].depth) * NUM_DEBUG_DEPTH_BINS / binRange;
+        DebugDepthBinStart[bin + 1]++;
+    }
+    for (i = 0; i < NUM_DEBUG_DEPTH_BINS; i++) {
+        DebugDepthBinStart[i + 1] += DebugDepthBinStart[i];
+    }
+    for (i = 0; i < DebugTriPos; i++) {
+        s32 bin = (maxDepth - DebugTris[i].depth) * NUM_DEBUG_DEPTH_BINS / binRange;
+        DebugTriOrder[DebugDepthBinStart[bin]++] = i;
+    }
 
     gDPPipeSync(gMainGfxPos++);
     gDPSetCycleType(gMainGfxPos++, G_CYC_1CYCLE);
@@ -1771,11 +1909,13 @@ void dx_debug_draw_collision() {
 
     DebugVtxPos = 0;
     rdpBufPos = 0;
+    fadeDist = DebugCollisionMenu[DBC_FADE_DIST].state;
 
     // build the display list and fill DebugVtxBuf at the same time
     for (i = 0; i < DebugTriPos; i++) {
-        DebugTriangle* debugTri = &DebugTris[i];
+        DebugTriangle* debugTri = &DebugTris[DebugTriOrder[i]];
         ColliderTriangle* tri = debugTri->tri;
+        Vtx_t* vtx;
         s32 r, g, b, a;
 
         b32 highlight = FALSE;
@@ -1814,17 +1954,9 @@ void dx_debug_draw_collision() {
             rdpBufPos = 0;
         }
 
-        if (highlight) {
-            r = g = b = 196;
-        } else {
-            r = round(fabs(tri->normal.x) * 245.0);
-            g = round(fabs(tri->normal.y) * 245.0);
-            b = round(fabs(tri->normal.z) * 245.0);
-        }
         a = 180;
 
         // fade triangles too close to the camera
-        fadeDist = DebugCollisionMenu[DBC_FADE_DIST].state;
         if(fadeDist > 0) {
             dist = debugTri->depth - (fadeDist - 1) * 25;
             if (dist < 20) {
@@ -1836,9 +1968,28 @@ void dx_debug_draw_collision() {
         }
 
         // build vertices for this triangle
-        dx_debug_add_collision_vtx(&DebugVtxBuf[DebugVtxPos++], tri->v1, &tri->normal, r, g, b, a);
-        dx_debug_add_collision_vtx(&DebugVtxBuf[DebugVtxPos++], tri->v2, &tri->normal, r, g, b, a);
-        dx_debug_add_collision_vtx(&DebugVtxBuf[DebugVtxPos++], tri->v3, &tri->normal, r, g, b, a);
+        vtx = &DebugVtxBuf[DebugVtxPos];
+        if (debugTri->cached != NULL) {
+            vtx[0] = debugTri->cached[0];
+            vtx[1] = debugTri->cached[1];
+            vtx[2] = debugTri->cached[2];
+            for (j = 0; j < 3; j++) {
+                if (highlight) {
+                    vtx[j].cn[0] = vtx[j].cn[1] = vtx[j].cn[2] = 196;
+                }
+                vtx[j].cn[3] = a;
+            }
+        } else {
+            if (highlight) {
+                r = g = b = 196;
+            } else {
+                dx_debug_get_collision_color(tri, &r, &g, &b);
+            }
+            dx_debug_add_collision_vtx(&vtx[0], tri->v1, &tri->normal, r, g, b, a);
+            dx_debug_add_collision_vtx(&vtx[1], tri->v2, &tri->normal, r, g, b, a);
+            dx_debug_add_collision_vtx(&vtx[2], tri->v3, &tri->normal, r, g, b, a);
+        }
+        DebugVtxPos += 3;
     }
 
     // done
@@ -16,6 +16,9 @@ void dx_debug_menu_main();
 void dx_debug_console_main();
 void dx_debug_draw_collision();
 
+/// Drops the cached debug geometry of a collider after it moves, or of all colliders if colliderID is -1.
+void dx_debug_invalidate_collision(s32 colliderID);
+
 b32 dx_debug_menu_is_open();
 b32 dx_debug_should_hide_models();
 b32 dx_debug_is_cheat_enabled(DebugCheat cheat);
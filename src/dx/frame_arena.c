@@ -0,0 +1,56 @@
+#include "dx/frame_arena.h"
+
+// Scratch buffers for the current frame, taken from a bump allocator. Buffers are normally released in the reverse
+// order they were taken; anything left over is reclaimed when the arena is reset at the start of the next frame.
+
+// Precedes each frame_temp_alloc buffer so it can be popped again
+typedef struct FrameTempHeader {
+    /* 0x00 */ s32 start;
+    /* 0x04 */ s32 end;
+    /* 0x08 */ char pad_08[8];
+} FrameTempHeader; // size = 0x10
+
+BSS u8 FrameArenaData[DX_FRAME_ARENA_SIZE] ALIGNED(16);
+BSS s32 FrameArenaUsed;
+BSS s32 FrameArenaPeak;
+
+void* frame_temp_alloc(s32 size) {
+    s32 start = FrameArenaUsed;
+    s32 arenaSize = ALIGN16(sizeof(FrameTempHeader) + size);
+    FrameTempHeader* header;
+
+    if (arenaSize > DX_FRAME_ARENA_SIZE - start) {
+        return general_heap_malloc(size);
+    }
+
+    header = (FrameTempHeader*) &FrameArenaData[start];
+    FrameArenaUsed = start + arenaSize;
+    if (FrameArenaUsed > FrameArenaPeak) {
+        FrameArenaPeak = FrameArenaUsed;
+    }
+
+    header->start = start;
+    header->end = FrameArenaUsed;
+    return header + 1;
+}
+
+void frame_temp_free(void* ptr) {
+    FrameTempHeader* header = (FrameTempHeader*)ptr - 1;
+
+    if ((u8*)ptr > FrameArenaData && (u8*)ptr < FrameArenaData + DX_FRAME_ARENA_SIZE) {
+        if (header->end == FrameArenaUsed) {
+            FrameArenaUsed = header->start;
+        }
+        return;
+    }
+
+    general_heap_free(ptr);
+}
+
+void frame_arena_reset(void) {
+    FrameArenaUsed = 0;
+}
+
+s32 frame_arena_get_peak(void) {
+    return FrameArenaPeak;
+}
@@ -0,0 +1,21 @@
+#ifndef _DX_FRAME_ARENA_H_
+#define _DX_FRAME_ARENA_H_
+
+#include "common.h"
+#include "dx/config.h"
+
+/// Allocates a scratch buffer for use within the calling function, released with frame_temp_free.
+/// Falls back to the general heap if the arena is full.
+void* frame_temp_alloc(s32 size);
+
+/// Releases a frame_temp_alloc buffer. Buffers freed in the reverse order they were allocated give their space back
+/// to the arena immediately; anything else is reclaimed when the arena is reset.
+void frame_temp_free(void* ptr);
+
+/// Resets the arena. Called once per frame as drawing starts.
+void frame_arena_reset(void);
+
+/// Most bytes ever in use at once in the arena.
+s32 frame_arena_get_peak(void);
+
+#endif
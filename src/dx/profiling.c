@@ -2,13 +2,16 @@
 
 #include "profiling.h"
 #include "dx/utils.h"
+#include "dx/frame_arena.h"
 #include "game_modes.h"
+#include "npc.h"
 
 #ifdef USE_PROFILER
 
 #define RDP_CYCLE_CONV(x) ((10 * (x)) / 625) // 62.5 million cycles per frame
 
 ProfileTimeData all_profiling_data[PROFILER_TIME_COUNT];
+ProfileTimeData all_profiling_counters[PROFILER_COUNTER_COUNT];
 
 int profile_buffer_index = -1;
 int rsp_buffer_indices[PROFILER_RSP_COUNT];
@@ -187,6 +190,16 @@ void profiler_audio_completed() {
     audio_buffer_index = cur_index;
 }
 
+// must be called before profiler_audio_completed advances the audio buffer index
+void profiler_audio_counter_update(enum ProfilerCounter which, u32 count) {
+    buffer_update(&all_profiling_counters[which], count, audio_buffer_index);
+}
+
+// must be called before profiler_gfx_completed advances the gfx buffer index
+void profiler_gfx_counter_update(enum ProfilerCounter which, u32 count) {
+    buffer_update(&all_profiling_counters[which], count, gfx_buffer_index);
+}
+
 static void update_fps_timer() {
     u32 diff = cur_start - prev_start;
 
@@ -271,15 +284,128 @@ u32 profiler_get_rdp_microseconds() {
     return RDP_CYCLE_CONV(rdp_max_cycles / PROFILING_BUFFER_SIZE);
 }
 
+#if DX_PROFILER_STREAM
+
+extern HeapNode heap_generalHead;
+extern s32 gNumScripts;
+extern struct EffectInstance* gEffectInstances[96];
+
+#define PROFILER_STREAM_MAGIC ASCII_TO_U32('P', 'R', 'F', '1')
+
+// Layout is decoded by tools/profiler_stream.py, keep them in sync.
+typedef struct ProfilerStreamRecord {
+    /* 0x00 */ u32 magic;
+    /* 0x04 */ u16 size;
+    /* 0x06 */ u8 numTimes;
+    /* 0x07 */ u8 numCounters;
+    /* 0x08 */ u32 frame;
+    /* 0x0C */ u32 times[PROFILER_TIME_COUNT]; // CPU cycles, or RDP clocks for the RDP buckets
+    u32 counters[PROFILER_COUNTER_COUNT];
+    u32 heapUsed;
+    u32 heapFree;
+    u32 heapLargestFree;
+    u16 numScripts;
+    u16 numNpcs;
+    u16 numEffects;
+    u16 pad;
+    u32 checksum; // sum of all preceding words
+} ProfilerStreamRecord;
+
+static u32 last_sample(ProfileTimeData* data, int next_index) {
+    return data->counts[(next_index + PROFILING_BUFFER_SIZE - 1) % PROFILING_BUFFER_SIZE];
+}
+
+/// Sends this frame's raw profiler samples to the IS-Viewer as one binary record.
+static void profiler_stream_frame() {
+    static ProfilerStreamRecord record;
+    HeapNode* node;
+    u32* words;
+    u32 sum;
+    int i;
+
+    record.magic = PROFILER_STREAM_MAGIC;
+    record.size = sizeof(record);
+    record.numTimes = PROFILER_TIME_COUNT;
+    record.numCounters = PROFILER_COUNTER_COUNT;
+    record.frame = gGameStatusPtr->frameCounter;
+
+    for (i = 0; i < PROFILER_TIME_COUNT; i++) {
+        record.times[i] = all_profiling_data[i].counts[profile_buffer_index];
+    }
+
+    // these are sampled on their own schedule, so report the most recently completed sample
+#ifdef GFX_PROFILING
+    for (i = PROFILER_TIME_SUB_GFX_START; i < PROFILER_TIME_SUB_GFX_END; i++) {
+        record.times[i] = last_sample(&all_profiling_data[i], gfx_buffer_index);
+    }
+#endif
+#ifdef AUDIO_PROFILING
+    for (i = PROFILER_TIME_SUB_AUDIO_START; i < PROFILER_TIME_SUB_AUDIO_END; i++) {
+        record.times[i] = last_sample(&all_profiling_data[i], audio_buffer_index);
+    }
+#endif
+    record.times[PROFILER_TIME_GFX] = last_sample(&all_profiling_data[PROFILER_TIME_GFX], gfx_buffer_index);
+    record.times[PROFILER_TIME_AUDIO] = last_sample(&all_profiling_data[PROFILER_TIME_AUDIO], audio_buffer_index);
+    record.times[PROFILER_TIME_RSP_GFX] = last_sample(&all_profiling_data[PROFILER_TIME_RSP_GFX],
+        rsp_buffer_indices[PROFILER_RSP_GFX]);
+    record.times[PROFILER_TIME_RSP_AUDIO] = last_sample(&all_profiling_data[PROFILER_TIME_RSP_AUDIO],
+        rsp_buffer_indices[PROFILER_RSP_AUDIO]);
+
+    for (i = 0; i < PROFILER_COUNTER_COUNT; i++) {
+        record.counters[i] = last_sample(&all_profiling_counters[i],
+            i < PROFILER_COUNTER_GFX_START ? audio_buffer_index : gfx_buffer_index);
+    }
+
+    record.heapUsed = record.heapFree = record.heapLargestFree = 0;
+    for (node = &heap_generalHead; node != NULL; node = node->next) {
+        if (node->allocated) {
+            record.heapUsed += node->length;
+        } else {
+            record.heapFree += node->length;
+            record.heapLargestFree = MAX(record.heapLargestFree, node->length);
+        }
+    }
+
+    record.numScripts = gNumScripts;
+    record.numNpcs = 0;
+    for (i = 0; i < MAX_NPCS; i++) {
+        if ((*gCurrentNpcListPtr)[i] != NULL) {
+            record.numNpcs++;
+        }
+    }
+    record.numEffects = 0;
+    for (i = 0; i < ARRAY_COUNT(gEffectInstances); i++) {
+        if (gEffectInstances[i] != NULL) {
+            record.numEffects++;
+        }
+    }
+    record.pad = 0;
+
+    words = (u32*)&record;
+    sum = 0;
+    for (i = 0; i < sizeof(record) / sizeof(u32) - 1; i++) {
+        sum += words[i];
+    }
+    record.checksum = sum;
+
+    is_debug_write(&record, sizeof(record));
+}
+
+#endif
+
 void profiler_print_times() {
     u32 microseconds[PROFILER_TIME_COUNT];
-    char text_buffer_labels[196];
-    char text_buffer_time[196];
+    char text_buffer_labels[256];
+    char text_buffer_time[256];
 
     update_fps_timer();
     update_total_timer();
     update_rdp_timers();
 
+#if DX_PROFILER_STREAM
+    profiler_stream_frame();
+#endif
+
 #ifndef PUPPYPRINT_DEBUG
     static u8 show_profiler = 0;
     if ((gPlayerStatus.pressedButtons & (L_TRIG | U_JPAD)) && (gPlayerStatus.curButtons & L_TRIG) && (gPlayerStatus.curButtons & U_JPAD)) {
@@ -318,7 +444,10 @@ void profiler_print_times() {
             " HUD elements\n"
             " Entities\n"
             " Gfx\n"
-            " Audio\n",
+            "  Shading hit/miss\n"
+            " Audio\n"
+            "  DMA hit/miss/load\n"
+            " Frame arena peak\n",
             1000000.0f / microseconds[PROFILER_TIME_FPS],
             total_cpu, total_cpu / 333
         );
@@ -335,7 +464,10 @@ void profiler_print_times() {
             "%d\n"
             "%d\n"
             "%d\n"
-            "%d\n",
+            "%d/%d\n"
+            "%d\n"
+            "%d/%d/%d\n"
+            "%d/%d\n",
             microseconds[PROFILER_TIME_CONTROLLERS],
             microseconds[PROFILER_TIME_WORKERS],
             microseconds[PROFILER_TIME_TRIGGERS],
@@ -344,7 +476,13 @@ void profiler_print_times() {
             microseconds[PROFILER_TIME_HUD_ELEMENTS],
             microseconds[PROFILER_TIME_ENTITIES],
             microseconds[PROFILER_TIME_GFX],
-            microseconds[PROFILER_TIME_AUDIO] * 2 // audio is 60Hz, so double the average
+            all_profiling_counters[PROFILER_COUNTER_SHADING_CACHE_HITS].total / PROFILING_BUFFER_SIZE,
+            all_profiling_counters[PROFILER_COUNTER_SHADING_CACHE_MISSES].total / PROFILING_BUFFER_SIZE,
+            microseconds[PROFILER_TIME_AUDIO] * 2, // audio is 60Hz, so double the average
+            all_profiling_counters[PROFILER_COUNTER_AUDIO_DMA_HITS].total / PROFILING_BUFFER_SIZE,
+            all_profiling_counters[PROFILER_COUNTER_AUDIO_DMA_MISSES].total / PROFILING_BUFFER_SIZE,
+            all_profiling_counters[PROFILER_COUNTER_AUDIO_DMA_LOADS].total / PROFILING_BUFFER_SIZE,
+            frame_arena_get_peak(), DX_FRAME_ARENA_SIZE
         );
 
         switch (get_game_mode()) {
@@ -100,6 +100,17 @@ enum ProfilerRSPTime {
     PROFILER_RSP_COUNT
 };
 
+/// Per-frame event counts, averaged like the timers.
+enum ProfilerCounter {
+    PROFILER_COUNTER_AUDIO_DMA_HITS,
+    PROFILER_COUNTER_AUDIO_DMA_MISSES,
+    PROFILER_COUNTER_AUDIO_DMA_LOADS,
+    PROFILER_COUNTER_GFX_START,
+    PROFILER_COUNTER_SHADING_CACHE_HITS = PROFILER_COUNTER_GFX_START,
+    PROFILER_COUNTER_SHADING_CACHE_MISSES,
+    PROFILER_COUNTER_COUNT // Must be last!
+};
+
 enum ProfilerDeltaTime {
     PROFILER_DELTA_COLLISION,
 #ifdef PUPPYPRINT_DEBUG
@@ -121,6 +132,7 @@ typedef struct {
     u32 total;
 } ProfileTimeData;
 extern ProfileTimeData all_profiling_data[PROFILER_TIME_COUNT];
+extern ProfileTimeData all_profiling_counters[PROFILER_COUNTER_COUNT];
 
 void profiler_update(enum ProfilerTime which, u32 delta);
 void profiler_print_times();
@@ -132,6 +144,8 @@ void profiler_gfx_started();
 void profiler_gfx_completed();
 void profiler_audio_started();
 void profiler_audio_completed();
+void profiler_audio_counter_update(enum ProfilerCounter which, u32 count);
+void profiler_gfx_counter_update(enum ProfilerCounter which, u32 count);
 #ifdef PUPPYPRINT_DEBUG
 void profiler_collision_reset();
 void profiler_collision_completed();
@@ -162,6 +176,8 @@ static ALWAYS_INLINE void profiler_rsp_yielded() {
 #define profiler_rsp_resumed()
 #define profiler_audio_started()
 #define profiler_audio_completed()
+#define profiler_audio_counter_update(which, count)
+#define profiler_gfx_counter_update(which, count)
 #define profiler_rsp_yielded()
 #define profiler_collision_reset()
 #define profiler_collision_completed()
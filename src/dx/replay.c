@@ -0,0 +1,142 @@
+#include "dx/replay.h"
+
+#if DX_REPLAY
+
+// Recordings are streamed to the IS-Viewer as binary records, which tools/replay.py turns into replay_data.inc.c
+// for playback. Starting from boot with the same seed and the same controller input, the game runs the same way
+// again, so a session can be replayed on two builds and their profiler streams compared.
+
+#define REPLAY_MAGIC_START ASCII_TO_U32('R', 'P', 'L', 'S')
+#define REPLAY_MAGIC_FRAMES ASCII_TO_U32('R', 'P', 'L', 'F')
+#define REPLAY_MAGIC_CHAOS ASCII_TO_U32('R', 'P', 'L', 'C')
+
+#define REPLAY_CHUNK_FRAMES 64
+
+BSS u32 ReplayFrameIndex;
+BSS b32 ReplayStarted;
+BSS b32 ReplayStopped;
+
+#if DX_REPLAY == DX_REPLAY_RECORD
+
+typedef struct ReplayFrameChunk {
+    /* 0x00 */ u32 magic;
+    /* 0x04 */ u32 firstFrame;
+    /* 0x08 */ u32 numFrames;
+    /* 0x0C */ ReplayFrame frames[REPLAY_CHUNK_FRAMES];
+} ReplayFrameChunk; // size = 0x10C
+
+BSS ReplayFrameChunk ReplayChunk;
+
+b32 dx_replay_update_input(OSContPad* contData, b32 handleInput) {
+    ReplayFrame* frame;
+
+    if (ReplayStopped) {
+        return handleInput;
+    }
+
+    if (!ReplayStarted) {
+        u32 start[2] = { REPLAY_MAGIC_START, gRandSeed };
+
+        is_debug_write(start, sizeof(start));
+        ReplayStarted = TRUE;
+    }
+
+    if (ReplayChunk.numFrames == 0) {
+        ReplayChunk.magic = REPLAY_MAGIC_FRAMES;
+        ReplayChunk.firstFrame = ReplayFrameIndex;
+    }
+
+    frame = &ReplayChunk.frames[ReplayChunk.numFrames++];
+    if (handleInput) {
+        frame->buttons = contData->button;
+        frame->stickX = contData->stick_x;
+        frame->stickY = contData->stick_y;
+    } else {
+        // no controller, recorded as a neutral pad
+        frame->buttons = 0;
+        frame->stickX = 0;
+        frame->stickY = 0;
+    }
+
+    if (ReplayChunk.numFrames == REPLAY_CHUNK_FRAMES) {
+        is_debug_write(&ReplayChunk, sizeof(ReplayChunk));
+        ReplayChunk.numFrames = 0;
+    }
+
+    ReplayFrameIndex++;
+    return handleInput;
+}
+
+void dx_replay_note_chaos_effect(s32 effectID) {
+    u32 event[3] = { REPLAY_MAGIC_CHAOS, ReplayFrameIndex, effectID };
+
+    if (ReplayStopped) {
+        return;
+    }
+    is_debug_write(event, sizeof(event));
+}
+
+void dx_replay_stop(void) {
+    if (ReplayStopped) {
+        return;
+    }
+    ReplayStopped = TRUE;
+
+    // the last chunk is sent at full size, its frame count tells how much of it is used
+    if (ReplayChunk.numFrames != 0) {
+        is_debug_write(&ReplayChunk, sizeof(ReplayChunk));
+        ReplayChunk.numFrames = 0;
+    }
+}
+
+#else
+
+#include "dx/replay_data.inc.c"
+
+BSS s32 ReplayNextChaosEvent;
+
+b32 dx_replay_update_input(OSContPad* contData, b32 handleInput) {
+    ReplayFrame* frame;
+
+    if (!ReplayStarted) {
+        gRandSeed = ReplaySeed;
+        ReplayStarted = TRUE;
+    }
+
+    if (ReplayFrameIndex >= ARRAY_COUNT(ReplayFrames)) {
+        if (ReplayFrameIndex == ARRAY_COUNT(ReplayFrames)) {
+            osSyncPrintf("replay: finished after %d frames\n", ReplayFrameIndex);
+            ReplayFrameIndex++;
+        }
+        return handleInput;
+    }
+
+    frame = &ReplayFrames[ReplayFrameIndex++];
+    contData->button = frame->buttons;
+    contData->stick_x = frame->stickX;
+    contData->stick_y = frame->stickY;
+    return TRUE;
+}
+
+void dx_replay_note_chaos_effect(s32 effectID) {
+    ReplayChaosEvent* expected;
+
+    if (ReplayFrameIndex > ARRAY_COUNT(ReplayFrames)) {
+        return;
+    }
+
+    // the event list always ends with an entry that can't match
+    expected = &ReplayChaosEvents[MIN(ReplayNextChaosEvent, ARRAY_COUNT(ReplayChaosEvents) - 1)];
+    if (expected->frame != ReplayFrameIndex || expected->effect != effectID) {
+        osSyncPrintf("replay: desync at frame %d, chaos effect %d activated\n", ReplayFrameIndex, effectID);
+        return;
+    }
+    ReplayNextChaosEvent++;
+}
+
+void dx_replay_stop(void) {
+}
+
+#endif
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef _DX_REPLAY_H_
+#define _DX_REPLAY_H_
+
+#include "common.h"
+#include "dx/config.h"
+
+#define DX_REPLAY_RECORD 1
+#define DX_REPLAY_PLAY 2
+
+typedef struct ReplayFrame {
+    /* 0x00 */ u16 buttons;
+    /* 0x02 */ s8 stickX;
+    /* 0x03 */ s8 stickY;
+} ReplayFrame; // size = 0x04
+
+typedef struct ReplayChaosEvent {
+    /* 0x00 */ u32 frame;
+    /* 0x04 */ u16 effect;
+    /* 0x06 */ u16 pad;
+} ReplayChaosEvent; // size = 0x08
+
+#if DX_REPLAY
+/// Records the controller state read this frame, or replaces it with the recorded one.
+/// Returns TRUE if contData holds input that should be handled.
+b32 dx_replay_update_input(OSContPad* contData, b32 handleInput);
+
+/// Records a chaos effect activation, or checks it against the recording during playback.
+void dx_replay_note_chaos_effect(s32 effectID);
+
+/// Ends a recording, sending the frames that don't fill a whole chunk yet. Called on reset and on crash.
+void dx_replay_stop(void);
+#else
+#define dx_replay_update_input(contData, handleInput) (handleInput)
+#define dx_replay_note_chaos_effect(effectID)
+#define dx_replay_stop()
+#endif
+
+#endif
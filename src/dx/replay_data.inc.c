@@ -0,0 +1,10 @@
+/* This file is auto-generated by tools/replay.py. Do not edit. */
+
+u32 ReplaySeed = 0x00000001;
+
+ReplayFrame ReplayFrames[] = {
+};
+
+ReplayChaosEvent ReplayChaosEvents[] = {
+    { 0xFFFFFFFF, 0xFFFF }, // end
+};
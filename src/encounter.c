@@ -180,6 +180,16 @@ b8 PendingPartnerAbilityResume;
 b8 LastBattleStartedBySpin;
 s16 gFirstStrikeMessagePos;
 
+// enemies further than this from both the player and partner can't pass any contact or first strike test
+#define ENEMY_NEAR_DIST 100.0f
+// offscreen enemies further than this from the player only check whether they came onscreen every few frames
+#define ENEMY_DORMANT_DIST 500.0f
+#define ENEMY_DORMANT_INTERVAL 8
+// the player can't cover this much ground in one frame without a warp or teleport, which rechecks dormant enemies
+#define ENEMY_TELEPORT_DIST 50.0f
+
+BSS f32 EnemyTierPlayerX;
+BSS f32 EnemyTierPlayerZ;
 BSS s32 WorldMerleeEffectsTime;
 BSS f32 WorldMerleeBasePosY;
 BSS EffectInstance* WorldMerleeOrbEffect;
@@ -478,6 +488,17 @@ API_CALLABLE(OnFleeBattleDrops) {
     return --script->functionTemp[1] == 0;
 }
 
+// Whether the enemy is close enough to a point that any contact test against it might pass. Checks the hitbox position
+// as well as the NPC's own, since the contact tests use it instead while it is active.
+b32 enemy_is_near(Enemy* enemy, Npc* npc, f32 x, f32 z) {
+    f32 nearDist = ENEMY_NEAR_DIST + npc->collisionDiameter / 2 + abs(enemy->unk_DC);
+
+    if (dist2D(npc->pos.x, npc->pos.z, x, z) < nearDist) {
+        return TRUE;
+    }
+    return enemy->hitboxIsActive && dist2D(enemy->unk_10.x, enemy->unk_10.z, x, z) < nearDist;
+}
+
 void update_encounters_neutral(void) {
     EncounterStatus* currentEncounter = &gCurrentEncounter;
     PlayerStatus* playerStatus = &gPlayerStatus;
@@ -511,6 +532,7 @@ void update_encounters_neutral(void) {
     f32 playerColRadius = 14.0f;
     f32 playerColHeight = 18.0f;
 
+    b32 recheckDormant;
     f32 dx, dz;
     f32 angle1, angle2;
 
@@ -532,6 +554,10 @@ void update_encounters_neutral(void) {
     playerZ = playerStatus->pos.z;
     playerYaw = playerStatus->spriteFacingAngle;
 
+    recheckDormant = dist2D(playerX, playerZ, EnemyTierPlayerX, EnemyTierPlayerZ) > ENEMY_TELEPORT_DIST;
+    EnemyTierPlayerX = playerX;
+    EnemyTierPlayerZ = playerZ;
+
     if (playerYaw < 180.0f) {
         playerYaw = clamp_angle(camera->curYaw - 90.0f);
     } else {
@@ -563,6 +589,7 @@ void update_encounters_neutral(void) {
             }
             npc = get_npc_unsafe(enemy->npcID);
             if (enemy->aiSuspendTime != 0) {
+                enemy->activityTier = ENEMY_ACTIVITY_ACTIVE;
                 if (!(gOverrideFlags & GLOBAL_OVERRIDES_40)) {
                     enemy->aiSuspendTime--;
                     suspendTime = enemy->aiSuspendTime;
@@ -598,8 +625,19 @@ void update_encounters_neutral(void) {
                     }
                 }
             } else if (!(enemy->flags & ENEMY_FLAG_ACTIVE_WHILE_OFFSCREEN)) {
+                if (enemy->activityTier == ENEMY_ACTIVITY_DORMANT && enemy->activityTimer != 0 && !recheckDormant) {
+                    enemy->activityTimer--;
+                    continue;
+                }
+
                 get_screen_coords(gCurrentCameraID, npc->pos.x, npc->pos.y, npc->pos.z, &screenX, &screenY, &screenZ);
                 if ((screenX < -160 || screenX > 480 || screenY < -120 || screenY > 360 || screenZ < 0) && !(enemy->flags & ENEMY_FLAG_PASSIVE)) {
+                    if (dist2D(npc->pos.x, npc->pos.z, playerX, playerZ) > ENEMY_DORMANT_DIST) {
+                        enemy->activityTier = ENEMY_ACTIVITY_DORMANT;
+                        enemy->activityTimer = ENEMY_DORMANT_INTERVAL;
+                    } else {
+                        enemy->activityTier = ENEMY_ACTIVITY_ACTIVE;
+                    }
                     npc->flags |= NPC_FLAG_SUSPENDED;
                     enemy->flags |= ENEMY_FLAG_SUSPENDED;
                     script = get_script_by_id(enemy->auxScriptID);
@@ -638,6 +676,15 @@ void update_encounters_neutral(void) {
             if (enemy->flags & ENEMY_FLAG_SUSPENDED) {
                 continue;
             }
+
+            if (enemy_is_near(enemy, npc, playerX, playerZ)
+                || (wPartnerNpc != NULL && enemy_is_near(enemy, npc, wPartnerNpc->pos.x, wPartnerNpc->pos.z))
+            ) {
+                enemy->activityTier = ENEMY_ACTIVITY_NEAR;
+            } else {
+                enemy->activityTier = ENEMY_ACTIVITY_ACTIVE;
+            }
+
             if (enemy->flags & ENEMY_FLAG_PASSIVE) {
                 if (!(enemy->flags & ENEMY_FLAG_DO_NOT_AUTO_FACE_PLAYER)) {
                     if (npc == playerStatus->encounteredNPC) {
@@ -673,6 +720,7 @@ void update_encounters_neutral(void) {
                 || (enemy->flags & ENEMY_FLAG_PASSIVE)
                 || (gOverrideFlags & (GLOBAL_OVERRIDES_DISABLE_BATTLES | GLOBAL_OVERRIDES_200 | GLOBAL_OVERRIDES_400 | GLOBAL_OVERRIDES_800))
                 || is_picking_up_item()
+                || enemy->activityTier != ENEMY_ACTIVITY_NEAR
             ) {
                 continue;
             }
@@ -2486,6 +2534,8 @@ void create_encounters(void) {
 
     switch (gEncounterSubState) {
         case ENCOUNTER_SUBSTATE_CREATE_INIT:
+            // enemies of the previous map may have been freed along with their heap
+            basic_ai_forget_sight(NULL);
             if (currentEncounter->resetMapEncounterFlags != 1) {
                 // check for current map among most recently visited
                 for (i = 0; i < ARRAY_COUNT(currentEncounter->recentMaps); i++) {
@@ -2506,6 +2556,7 @@ void create_encounters(void) {
                 currentEncounter->recentMaps[i] = mapID;
             }
 
+            clear_enemy_lookup();
             e = 0;
             totalNpcCount = 0;
             while (TRUE) {
@@ -2626,6 +2677,8 @@ void create_encounters(void) {
                     newNpc->homePos.z = newNpc->pos.z;
                     set_npc_yaw(newNpc, npcData->yaw);
                     enemy->savedNpcYaw = 12345;
+                    enemy->activityTier = ENEMY_ACTIVITY_ACTIVE;
+                    enemy->activityTimer = 0;
                     if (newNpc->collisionDiameter >= 24.0) {
                         newNpc->shadowScale = newNpc->collisionDiameter / 24.0;
                     } else {
@@ -22,6 +22,25 @@ BSS s32 entity_fog_alpha;
 BSS s32 entity_fog_dist_min;
 BSS s32 entity_fog_dist_max;
 
+#define ENTITY_SETUP_CACHE_SIZE 8
+
+typedef struct EntityModelSetupGfx {
+    /* 0x00 */ b8 valid;
+    /* 0x01 */ b8 fog;
+    /* 0x02 */ s8 renderMode;
+    /* 0x03 */ char pad_03;
+    /* 0x04 */ u8 fogColor[4];
+    /* 0x08 */ s16 fogMin;
+    /* 0x0A */ s16 fogMax;
+    /* 0x0C */ u16 lastFrame;
+    /* 0x0E */ char pad_0E[2];
+    /* 0x10 */ Gfx gfx[16];
+} EntityModelSetupGfx; // size = 0x90
+
+// One set per display context, so an entry is only rebuilt once the display list that last used it has been drawn.
+// An entry already emitted this frame is never rebuilt, since models drawn earlier still point at it.
+BSS EntityModelSetupGfx EntityModelSetupCache[2][ENTITY_SETUP_CACHE_SIZE];
+
 extern Gfx Gfx_RM1_SURFACE_OPA[];
 extern Gfx Gfx_RM1_DECAL_OPA[];
 extern Gfx Gfx_RM1_INTERSECTING_OPA[];
@@ -61,6 +80,11 @@ void clear_entity_models(void) {
         (*gCurrentEntityModelList)[i] = NULL;
     }
 
+    for (i = 0; i < ENTITY_SETUP_CACHE_SIZE; i++) {
+        EntityModelSetupCache[0][i].valid = FALSE;
+        EntityModelSetupCache[1][i].valid = FALSE;
+    }
+
     gEntityModelCount = 0;
     entity_fog_enabled = 0;
     entity_fog_red = 10;
@@ -179,6 +203,9 @@ void exec_entity_model_commandlist(s32 idx) {
             if (!(entityModel->flags & ENTITY_MODEL_FLAG_HIDDEN)) {
                 if (!(entityModel->flags & ENTITY_MODEL_FLAG_DISABLE_SCRIPT)) {
                     entityModel->flags &= ~ENTITY_MODEL_FLAG_100;
+                    if (entityModel->flags & ENTITY_MODEL_FLAG_IDLE_SCRIPT) {
+                        return;
+                    }
                     entityModel->nextFrameTime -= entityModel->timeScale;
                     if (entityModel->nextFrameTime <= 0.0f) {
                         while (step_entity_model_commandlist(entityModel));
@@ -200,6 +227,10 @@ s32 step_entity_model_commandlist(EntityModel* entityModel) {
         case ENTITY_MODEL_SCRIPT_OP_Draw: // set display list ptr
             entityModel->nextFrameTime = (f32) *curPos++;
             entityModel->gfx.displayList = (Gfx*) *curPos++;
+            // restarting right back onto this draw would only set the same display list again
+            if (*curPos == ENTITY_MODEL_SCRIPT_OP_Restart && entityModel->cmdListSavedPos == entityModel->cmdListReadPos) {
+                entityModel->flags |= ENTITY_MODEL_FLAG_IDLE_SCRIPT;
+            }
             entityModel->cmdListReadPos = (EntityModelScript*) curPos;
             break;
         case ENTITY_MODEL_SCRIPT_OP_Restart: // restore saved position
@@ -241,6 +272,147 @@ void make_entity_model_mtx_flipZ(Matrix4f mtx) {
     mtx[3][3] = 1.0f;
 }
 
+static Gfx* build_entity_model_setup_gfx(Gfx* gfxPos, s32 renderMode, b32 fog) {
+    gDPPipeSync(gfxPos++);
+    gDPSetRenderMode(gfxPos++, G_RM_TEX_EDGE, G_RM_TEX_EDGE2);
+    gDPSetPrimColor(gfxPos++, 0, 0, 255, 255, 255, 255);
+    gDPSetCombineMode(gfxPos++, G_CC_MODULATEIA_PRIM, G_CC_MODULATEIA_PRIM);
+    gDPSetAlphaCompare(gfxPos++, G_AC_NONE);
+    gSPSetOtherMode(gfxPos++, G_SETOTHERMODE_H, G_MDSFT_ALPHADITHER, 18, G_AD_DISABLE | G_CD_DISABLE | G_CK_NONE | G_TC_FILT | G_TF_POINT | G_TT_NONE | G_TL_TILE | G_TD_CLAMP | G_TP_NONE | G_CYC_1CYCLE);
+
+    switch (fog) {
+        case FALSE:
+            switch (renderMode) {
+                case RENDER_MODE_SURFACE_OPA:
+                    gSPDisplayList(gfxPos++, Gfx_RM1_SURFACE_OPA);
+                    break;
+                case RENDER_MODE_DECAL_OPA:
+                    gSPDisplayList(gfxPos++, Gfx_RM1_DECAL_OPA);
+                    break;
+                case RENDER_MODE_INTERSECTING_OPA:
+                    gSPDisplayList(gfxPos++, Gfx_RM1_INTERSECTING_OPA);
+                    break;
+                case RENDER_MODE_ALPHATEST:
+                    gSPDisplayList(gfxPos++, Gfx_RM1_ALPHATEST);
+                    break;
+                case RENDER_MODE_SURFACE_XLU_LAYER1:
+                case RENDER_MODE_SURFACE_XLU_LAYER2:
+                case RENDER_MODE_SURFACE_XLU_LAYER3:
+                    gSPDisplayList(gfxPos++, Gfx_RM1_SURFACE_XLU);
+                    break;
+                case RENDER_MODE_SURFACE_XLU_NO_AA:
+                    gSPDisplayList(gfxPos++, Gfx_RM1_SURFACE_XLU_NO_AA);
+                    break;
+                case RENDER_MODE_DECAL_XLU:
+                case RENDER_MODE_DECAL_XLU_AHEAD:
+                    gSPDisplayList(gfxPos++, Gfx_RM1_DECAL_XLU);
+                    break;
+                case RENDER_MODE_DECAL_XLU_NO_AA:
+                case RENDER_MODE_SHADOW:
+                    gSPDisplayList(gfxPos++, Gfx_RM1_DECAL_XLU_NO_AA);
+                    break;
+                case RENDER_MODE_INTERSECTING_XLU:
+                    gSPDisplayList(gfxPos++, Gfx_RM1_INTERSECTING_XLU);
+                    break;
+                case RENDER_MODE_PASS_THROUGH:
+                    gSPDisplayList(gfxPos++, Gfx_RM1_PASS_THROUGH);
+                    break;
+                case RENDER_MODE_ALPHATEST_ONESIDED:
+                    gSPDisplayList(gfxPos++, Gfx_RM1_ALPHATEST_ONESIDED);
+                    break;
+                case RENDER_MODE_SURFACE_OPA_NO_ZB:
+                case RENDER_MODE_SURFACE_OPA_NO_ZB_BEHIND:
+                    gSPDisplayList(gfxPos++, Gfx_RM1_SURFACE_OPA_NO_ZB);
+                    break;
+                case RENDER_MODE_ALPHATEST_NO_ZB:
+                case RENDER_MODE_ALPHATEST_NO_ZB_BEHIND:
+                    gSPDisplayList(gfxPos++, Gfx_RM1_ALPHATEST_NO_ZB);
+                    break;
+                case RENDER_MODE_SURFACE_XLU_NO_ZB:
+                case RENDER_MODE_SURFACE_XLU_NO_ZB_BEHIND:
+                    gSPDisplayList(gfxPos++, Gfx_RM1_SURFACE_XLU_NO_ZB);
+                    break;
+                case RENDER_MODE_CLOUD_NO_ZCMP:
+                    gSPDisplayList(gfxPos++, Gfx_RM1_CLOUD_NO_ZCMP);
+                    break;
+            }
+            break;
+        case TRUE:
+            switch (renderMode) {
+                case RENDER_MODE_SURFACE_OPA:
+                    gSPDisplayList(gfxPos++, Gfx_RM3_SURFACE_OPA);
+                    break;
+                case RENDER_MODE_DECAL_OPA:
+                    gSPDisplayList(gfxPos++, Gfx_RM3_DECAL_OPA);
+                    break;
+                case RENDER_MODE_INTERSECTING_OPA:
+                    gSPDisplayList(gfxPos++, Gfx_RM3_INTERSECTING_OPA);
+                    break;
+                case RENDER_MODE_ALPHATEST:
+                    gSPDisplayList(gfxPos++, Gfx_RM3_ALPHATEST);
+                    break;
+                case RENDER_MODE_SURFACE_XLU_LAYER1:
+                    gSPDisplayList(gfxPos++, Gfx_RM3_SURFACE_XLU);
+                    break;
+                case RENDER_MODE_DECAL_XLU:
+                    gSPDisplayList(gfxPos++, Gfx_RM3_DECAL_XLU);
+                    break;
+                case RENDER_MODE_INTERSECTING_XLU:
+                    gSPDisplayList(gfxPos++, Gfx_RM3_INTERSECTING_XLU);
+                    break;
+            }
+            gDPSetFogColor(gfxPos++, entity_fog_red, entity_fog_green, entity_fog_blue, entity_fog_alpha);
+            gSPFogPosition(gfxPos++, entity_fog_dist_min, entity_fog_dist_max);
+            break;
+    }
+    gSPClearGeometryMode(gfxPos++, G_LIGHTING);
+    if (!fog) {
+        gDPSetCombineMode(gfxPos++, G_CC_MODULATEIA, G_CC_MODULATEIA);
+    } else {
+        gDPSetCombineMode(gfxPos++, PM_CC_42, PM_CC2_MULTIPLY_SHADE);
+    }
+    return gfxPos;
+}
+
+// Appends the render setup shared by every entity model drawn with the same render mode and fog state. It is built
+// once per display context and called from there, or written inline if its cache entry is already in use this frame.
+void append_entity_model_setup_gfx(s32 renderMode, b32 fog) {
+    EntityModelSetupGfx* entry;
+    Gfx* gfxPos;
+
+    entry = &EntityModelSetupCache[gCurrentDisplayContextIndex][(renderMode * 2 + fog) % ENTITY_SETUP_CACHE_SIZE];
+    if (entry->valid && entry->renderMode == renderMode && entry->fog == fog
+        && (!fog || (entry->fogColor[0] == entity_fog_red && entry->fogColor[1] == entity_fog_green
+            && entry->fogColor[2] == entity_fog_blue && entry->fogColor[3] == entity_fog_alpha
+            && entry->fogMin == entity_fog_dist_min && entry->fogMax == entity_fog_dist_max))
+    ) {
+        entry->lastFrame = gGameStatusPtr->frameCounter;
+        gSPDisplayList(gMainGfxPos++, entry->gfx);
+        return;
+    }
+
+    if (entry->valid && entry->lastFrame == gGameStatusPtr->frameCounter) {
+        gMainGfxPos = build_entity_model_setup_gfx(gMainGfxPos, renderMode, fog);
+        return;
+    }
+
+    gfxPos = build_entity_model_setup_gfx(entry->gfx, renderMode, fog);
+    gSPEndDisplayList(gfxPos++);
+    ASSERT(gfxPos <= &entry->gfx[ARRAY_COUNT(entry->gfx)]);
+
+    entry->valid = TRUE;
+    entry->lastFrame = gGameStatusPtr->frameCounter;
+    entry->renderMode = renderMode;
+    entry->fog = fog;
+    entry->fogColor[0] = entity_fog_red;
+    entry->fogColor[1] = entity_fog_green;
+    entry->fogColor[2] = entity_fog_blue;
+    entry->fogColor[3] = entity_fog_alpha;
+    entry->fogMin = entity_fog_dist_min;
+    entry->fogMax = entity_fog_dist_max;
+    gSPDisplayList(gMainGfxPos++, entry->gfx);
+}
+
 void appendGfx_entity_model(EntityModel* model) {
     Matrix4f mtx;
     Matrix4f mtx2;
@@ -251,104 +423,8 @@ void appendGfx_entity_model(EntityModel* model) {
     gSPMatrix(gMainGfxPos++, &gDisplayContext->matrixStack[gMatrixListPos++], G_MTX_PUSH | G_MTX_LOAD | G_MTX_MODELVIEW);
     if (!(model->flags & ENTITY_MODEL_FLAG_USE_IMAGE)) {
         if (!(model->flags & ENTITY_MODEL_FLAG_10000)) {
-            gDPPipeSync(gMainGfxPos++);
-            gDPSetRenderMode(gMainGfxPos++, G_RM_TEX_EDGE, G_RM_TEX_EDGE2);
-            gDPSetPrimColor(gMainGfxPos++, 0, 0, 255, 255, 255, 255);
-            gDPSetCombineMode(gMainGfxPos++, G_CC_MODULATEIA_PRIM, G_CC_MODULATEIA_PRIM);
-            gDPSetAlphaCompare(gMainGfxPos++, G_AC_NONE);
-            gSPSetOtherMode(gMainGfxPos++, G_SETOTHERMODE_H, G_MDSFT_ALPHADITHER, 18, G_AD_DISABLE | G_CD_DISABLE | G_CK_NONE | G_TC_FILT | G_TF_POINT | G_TT_NONE | G_TL_TILE | G_TD_CLAMP | G_TP_NONE | G_CYC_1CYCLE);
-
-            switch (entity_fog_enabled && !(model->flags & ENTITY_MODEL_FLAG_FOG_DISABLED)) {
-                case FALSE:
-                    switch (model->renderMode) {
-                        case RENDER_MODE_SURFACE_OPA:
-                            gSPDisplayList(gMainGfxPos++, Gfx_RM1_SURFACE_OPA);
-                            break;
-                        case RENDER_MODE_DECAL_OPA:
-                            gSPDisplayList(gMainGfxPos++, Gfx_RM1_DECAL_OPA);
-                            break;
-                        case RENDER_MODE_INTERSECTING_OPA:
-                            gSPDisplayList(gMainGfxPos++, Gfx_RM1_INTERSECTING_OPA);
-                            break;
-                        case RENDER_MODE_ALPHATEST:
-                            gSPDisplayList(gMainGfxPos++, Gfx_RM1_ALPHATEST);
-                            break;
-                        case RENDER_MODE_SURFACE_XLU_LAYER1:
-                        case RENDER_MODE_SURFACE_XLU_LAYER2:
-                        case RENDER_MODE_SURFACE_XLU_LAYER3:
-                            gSPDisplayList(gMainGfxPos++, Gfx_RM1_SURFACE_XLU);
-                            break;
-                        case RENDER_MODE_SURFACE_XLU_NO_AA:
-                            gSPDisplayList(gMainGfxPos++, Gfx_RM1_SURFACE_XLU_NO_AA);
-                            break;
-                        case RENDER_MODE_DECAL_XLU:
-                        case RENDER_MODE_DECAL_XLU_AHEAD:
-                            gSPDisplayList(gMainGfxPos++, Gfx_RM1_DECAL_XLU);
-                            break;
-                        case RENDER_MODE_DECAL_XLU_NO_AA:
-                        case RENDER_MODE_SHADOW:
-                            gSPDisplayList(gMainGfxPos++, Gfx_RM1_DECAL_XLU_NO_AA);
-                            break;
-                        case RENDER_MODE_INTERSECTING_XLU:
-                            gSPDisplayList(gMainGfxPos++, Gfx_RM1_INTERSECTING_XLU);
-                            break;
-                        case RENDER_MODE_PASS_THROUGH:
-                            gSPDisplayList(gMainGfxPos++, Gfx_RM1_PASS_THROUGH);
-                            break;
-                        case RENDER_MODE_ALPHATEST_ONESIDED:
-                            gSPDisplayList(gMainGfxPos++, Gfx_RM1_ALPHATEST_ONESIDED);
-                            break;
-                        case RENDER_MODE_SURFACE_OPA_NO_ZB:
-                        case RENDER_MODE_SURFACE_OPA_NO_ZB_BEHIND:
-                            gSPDisplayList(gMainGfxPos++, Gfx_RM1_SURFACE_OPA_NO_ZB);
-                            break;
-                        case RENDER_MODE_ALPHATEST_NO_ZB:
-                        case RENDER_MODE_ALPHATEST_NO_ZB_BEHIND:
-                            gSPDisplayList(gMainGfxPos++, Gfx_RM1_ALPHATEST_NO_ZB);
-                            break;
-                        case RENDER_MODE_SURFACE_XLU_NO_ZB:
-                        case RENDER_MODE_SURFACE_XLU_NO_ZB_BEHIND:
-                            gSPDisplayList(gMainGfxPos++, Gfx_RM1_SURFACE_XLU_NO_ZB);
-                            break;
-                        case RENDER_MODE_CLOUD_NO_ZCMP:
-                            gSPDisplayList(gMainGfxPos++, Gfx_RM1_CLOUD_NO_ZCMP);
-                            break;
-                    }
-                    break;
-                case TRUE:
-                    switch (model->renderMode) {
-                        case RENDER_MODE_SURFACE_OPA:
-                            gSPDisplayList(gMainGfxPos++, Gfx_RM3_SURFACE_OPA);
-                            break;
-                        case RENDER_MODE_DECAL_OPA:
-                            gSPDisplayList(gMainGfxPos++, Gfx_RM3_DECAL_OPA);
-                            break;
-                        case RENDER_MODE_INTERSECTING_OPA:
-                            gSPDisplayList(gMainGfxPos++, Gfx_RM3_INTERSECTING_OPA);
-                            break;
-                        case RENDER_MODE_ALPHATEST:
-                            gSPDisplayList(gMainGfxPos++, Gfx_RM3_ALPHATEST);
-                            break;
-                        case RENDER_MODE_SURFACE_XLU_LAYER1:
-                            gSPDisplayList(gMainGfxPos++, Gfx_RM3_SURFACE_XLU);
-                            break;
-                        case RENDER_MODE_DECAL_XLU:
-                            gSPDisplayList(gMainGfxPos++, Gfx_RM3_DECAL_XLU);
-                            break;
-                        case RENDER_MODE_INTERSECTING_XLU:
-                            gSPDisplayList(gMainGfxPos++, Gfx_RM3_INTERSECTING_XLU);
-                            break;
-                    }
-                    gDPSetFogColor(gMainGfxPos++, entity_fog_red, entity_fog_green, entity_fog_blue, entity_fog_alpha);
-                    gSPFogPosition(gMainGfxPos++, entity_fog_dist_min, entity_fog_dist_max);
-                    break;
-            }
-            gSPClearGeometryMode(gMainGfxPos++, G_LIGHTING);
-            if (!entity_fog_enabled || (model->flags & ENTITY_MODEL_FLAG_FOG_DISABLED)) {
-                gDPSetCombineMode(gMainGfxPos++, G_CC_MODULATEIA, G_CC_MODULATEIA);
-            } else {
-                gDPSetCombineMode(gMainGfxPos++, PM_CC_42, PM_CC2_MULTIPLY_SHADE);
-            }
+            append_entity_model_setup_gfx(model->renderMode,
+                entity_fog_enabled && !(model->flags & ENTITY_MODEL_FLAG_FOG_DISABLED));
         }
         if (model->vertexArray != NULL) {
             gSPSegment(gMainGfxPos++, D_80154374, VIRTUAL_TO_PHYSICAL(model->vertexArray));
@@ -403,14 +479,18 @@ void appendGfx_entity_model(EntityModel* model) {
 }
 
 
+// Reads the Z translation from a fixed point matrix, which is all the render task sort needs from it
+static f32 get_entity_model_mtx_pos_z(Mtx* mtx) {
+    s16* intPart = (s16*) mtx->m;
+    u16* fracPart = (u16*) mtx->m + 16;
+
+    return (f32) ((intPart[14] << 16) | fracPart[14]) / 65536.0f;
+}
+
 void draw_entity_model_A(s32 modelIdx, Mtx* transformMtx) {
     EntityModel* model;
     RenderTask rt;
     RenderTask* rtPtr = &rt;
-    Camera* camera = &gCameras[gCurrentCamID];
-    Matrix4f mtx;
-    f32 x, y, z, w;
-    f32 inX, inY, inZ;
 
     if ((gGameStatusPtr->context == CONTEXT_WORLD) || (modelIdx & BATTLE_ENTITY_ID_BIT)) {
         modelIdx &= ~BATTLE_ENTITY_ID_BIT;
@@ -423,15 +503,10 @@ void draw_entity_model_A(s32 modelIdx, Mtx* transformMtx) {
                         if (!(model->flags & ENTITY_MODEL_FLAG_40) && (model->flags & (1 << gCurrentCamID))) {
                             model->transform = *transformMtx;
                             model->vertexArray = NULL;
-                            guMtxL2F(mtx, transformMtx);
-                            inX = mtx[3][0];
-                            inY = mtx[3][1];
-                            inZ = mtx[3][2];
-                            transform_point(camera->mtxPerspective, inX, inY, inZ, 1.0f, &x, &y, &z, &w);
                             rtPtr->renderMode = model->renderMode;
                             rtPtr->appendGfxArg = model;
                             rtPtr->appendGfx = (void(*)(void*))appendGfx_entity_model;
-                            rtPtr->dist = ((u32)(model->flags & 0xF000) >> 8) + inZ;
+                            rtPtr->dist = ((u32)(model->flags & 0xF000) >> 8) + get_entity_model_mtx_pos_z(transformMtx);
                             queue_render_task(rtPtr);
                         }
                     }
@@ -445,10 +520,6 @@ void draw_entity_model_B(s32 modelIdx, Mtx* transformMtx, s32 vertexSegment, Vec
     EntityModel* model;
     RenderTask rt;
     RenderTask* rtPtr = &rt;
-    Camera* camera = &gCameras[gCurrentCamID];
-    Matrix4f mtx;
-    f32 x, y, z, w;
-    f32 inX, inY, inZ;
 
     if ((gGameStatusPtr->context == CONTEXT_WORLD) || (modelIdx & BATTLE_ENTITY_ID_BIT)) {
         modelIdx &= ~BATTLE_ENTITY_ID_BIT;
@@ -462,15 +533,10 @@ void draw_entity_model_B(s32 modelIdx, Mtx* transformMtx, s32 vertexSegment, Vec
                             model->transform = *transformMtx;
                             D_80154374 = vertexSegment;
                             model->vertexArray = vertexArray;
-                            guMtxL2F(mtx, transformMtx);
-                            inX = mtx[3][0];
-                            inY = mtx[3][1];
-                            inZ = mtx[3][2];
-                            transform_point(camera->mtxPerspective, inX, inY, inZ, 1.0f, &x, &y, &z, &w);
                             rtPtr->renderMode = model->renderMode;
                             rtPtr->appendGfxArg = model;
                             rtPtr->appendGfx = (void(*)(void*))appendGfx_entity_model;
-                            rtPtr->dist = ((u32)(model->flags & 0xF000) >> 8) + inZ;
+                            rtPtr->dist = ((u32)(model->flags & 0xF000) >> 8) + get_entity_model_mtx_pos_z(transformMtx);
                             queue_render_task(rtPtr);
                         }
                     }
@@ -718,6 +784,7 @@ void set_entity_model_render_command_list(s32 idx, EntityModelScript* cmdList) {
         entityModel->cmdListSavedPos = cmdList;
         entityModel->nextFrameTime = 1.0f;
         entityModel->timeScale = 1.0f;
+        entityModel->flags &= ~ENTITY_MODEL_FLAG_IDLE_SCRIPT;
     }
 }
 
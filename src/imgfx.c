@@ -2,6 +2,7 @@
 #include "ld_addrs.h"
 #include "sprite.h"
 #include "imgfx.h"
+#include "dx/frame_arena.h"
 
 
 #if VERSION_JP // TODO remove once segments are split
@@ -1300,11 +1301,11 @@ void imgfx_mesh_anim_update(ImgFXState* state) {
     }
 
     // find the current + next keyframe vertex data
-    curKeyframe = heap_malloc(header->vtxCount * sizeof(ImgFXVtx));
+    curKeyframe = frame_temp_alloc(header->vtxCount * sizeof(ImgFXVtx));
     romStart = (u8*)((s32)imgfx_data_ROM_START + (s32) header->keyframesOffset + curKeyIdx * header->vtxCount * sizeof(ImgFXVtx));
     dma_copy(romStart, romStart + header->vtxCount * sizeof(ImgFXVtx), curKeyframe);
     if (keyframeInterval > 1) {
-        nextKeyframe = heap_malloc(header->vtxCount * sizeof(*nextKeyframe));
+        nextKeyframe = frame_temp_alloc(header->vtxCount * sizeof(*nextKeyframe));
         romStart = (u8*)((s32)imgfx_data_ROM_START + (s32) header->keyframesOffset + nextKeyIdx * header->vtxCount * sizeof(ImgFXVtx));
         dma_copy(romStart, romStart + header->vtxCount * sizeof(ImgFXVtx), nextKeyframe);
     }
@@ -1371,10 +1372,11 @@ void imgfx_mesh_anim_update(ImgFXState* state) {
     state->firstVtxIdx = 0;
     state->lastVtxIdx = header->vtxCount - 1;
 
-    heap_free(curKeyframe);
+    // freed in reverse order so the arena space is handed back
     if (nextKeyframe != NULL) {
-        heap_free(nextKeyframe);
+        frame_temp_free(nextKeyframe);
     }
+    frame_temp_free(curKeyframe);
 
     if (animStep == 0 || gGameStatusPtr->frameCounter % animStep != 0) {
         return;
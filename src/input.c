@@ -1,6 +1,7 @@
 #include "common.h"
 #include "nu/nusys.h"
 #include "chaos.h"
+#include "dx/replay.h"
 
 OSContPad D_8009A5B8;
 BSS s16 D_8009A6A0;
@@ -46,6 +47,8 @@ void update_input(void) {
         nuContDataGet(contData, 0);
     }
 
+    handleInput = dx_replay_update_input(contData, handleInput);
+
     if (gGameStatusPtr->demoState != DEMO_STATE_NONE) {
         if (gGameStatusPtr->demoState < DEMO_STATE_CHANGE_MAP
             && (contData->button & (BUTTON_A | BUTTON_B | BUTTON_Z | BUTTON_START))
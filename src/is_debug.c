@@ -16,7 +16,16 @@ typedef struct {
 
 char* is_debug_print(char* arg0, const char* str, size_t count);
 
+BSS OSMesgQueue ISLogLockQueue;
+BSS OSMesg ISLogLockMsg;
+BSS b32 ISLogLockReady;
+
 void is_debug_init(void) {
+    // holds a single message while nobody is writing to the IS-Viewer
+    osCreateMesgQueue(&ISLogLockQueue, &ISLogLockMsg, 1);
+    osSendMesg(&ISLogLockQueue, NULL, OS_MESG_NOBLOCK);
+    ISLogLockReady = TRUE;
+
     osEPiWriteIo(nuPiCartHandle, (u32) &gISVDbgPrnAdrs->put, 0);
     osEPiWriteIo(nuPiCartHandle, (u32) &gISVDbgPrnAdrs->get, 0);
     osEPiWriteIo(nuPiCartHandle, (u32) &gISVDbgPrnAdrs->magic, ASCII_TO_U32('I', 'S', '6', '4'));
@@ -43,54 +52,168 @@ void rmonPrintf(const char* fmt, ...) {
     _Printf(is_debug_print, NULL, fmt, args);
 }
 
-char* is_debug_print(char* arg0, const char* str, size_t count) {
-    u32 data;
-    s32 pos;
-    s32 start;
-    s32 end;
+// Printed text is collected in RAM and copied to the IS-Viewer in blocks, once per frame or whenever the buffer fills
+// up, rather than with two PI accesses per character. Text which can't be delivered is counted and reported instead.
+// Writes to the IS-Viewer are serialized, so a thread that finds the buffer full waits for a flush in progress.
+#define IS_LOG_BUFFER_SIZE 0x800
+
+BSS char ISLogBuffer[IS_LOG_BUFFER_SIZE];
+BSS s32 ISLogLength;
+BSS u32 ISLogDroppedBytes;
+BSS b32 ISLogCrashed;
+
+static b32 is_debug_write_block(const void* data, size_t count);
 
-    osEPiReadIo(nuPiCartHandle, (u32) &gISVDbgPrnAdrs->magic, &data);
-    if (data != ASCII_TO_U32('I', 'S', '6', '4')) {
-        return (char*) 1;
+// Returns TRUE if the lock was taken and must be released with is_debug_unlock.
+static b32 is_debug_lock(void) {
+    if (!ISLogLockReady || ISLogCrashed) {
+        // nothing else is running, or the thread holding the lock may be the one that crashed
+        return FALSE;
     }
-    osEPiReadIo(nuPiCartHandle, (u32) &gISVDbgPrnAdrs->get, &data);
-    pos = data;
-    osEPiReadIo(nuPiCartHandle, (u32) &gISVDbgPrnAdrs->put, &data);
-    start = data;
-    end = start + count;
-    if (end >= 0xffe0) {
-        end -= 0xffe0;
-        if (pos < end || start < pos) {
-            return (char*) 1;
+    osRecvMesg(&ISLogLockQueue, NULL, OS_MESG_BLOCK);
+    return TRUE;
+}
+
+static void is_debug_unlock(b32 locked) {
+    if (locked) {
+        osSendMesg(&ISLogLockQueue, NULL, OS_MESG_NOBLOCK);
+    }
+}
+
+static void is_debug_flush_locked(void) {
+    static char droppedMsg[] = "\n[is_debug: ???????? bytes dropped]\n";
+    u32 saved;
+    u32 dropped;
+    s32 length;
+    s32 i;
+
+    if (ISLogDroppedBytes != 0) {
+        dropped = ISLogDroppedBytes;
+        for (i = 7; i >= 0; i--) {
+            droppedMsg[12 + i] = "0123456789ABCDEF"[dropped & 0xF];
+            dropped >>= 4;
         }
-    } else {
-        if (start < pos && pos < end) {
-            return (char*) 1;
+        if (is_debug_write_block(droppedMsg, sizeof(droppedMsg) - 1)) {
+            ISLogDroppedBytes = 0;
         }
     }
+
+    length = ISLogLength;
+    if (length != 0) {
+        if (!is_debug_write_block(ISLogBuffer, length)) {
+            ISLogDroppedBytes += length;
+        }
+
+        // keep anything other threads appended while the block was being written
+        saved = __osDisableInt();
+        ISLogLength -= length;
+        if (ISLogLength != 0) {
+            bcopy(&ISLogBuffer[length], ISLogBuffer, ISLogLength);
+        }
+        __osRestoreInt(saved);
+    }
+}
+
+void is_debug_flush(void) {
+    b32 locked = is_debug_lock();
+
+    is_debug_flush_locked();
+    is_debug_unlock(locked);
+}
+
+void is_debug_flush_crash(void) {
+    ISLogCrashed = TRUE;
+    is_debug_flush_locked();
+}
+
+char* is_debug_print(char* arg0, const char* str, size_t count) {
+    u32 saved;
+
     while (count) {
-        u8 c = *str;
+        saved = __osDisableInt();
+        while (count && ISLogLength < IS_LOG_BUFFER_SIZE) {
+            if (*str != 0) {
+                ISLogBuffer[ISLogLength++] = *str;
+            }
+            str++;
+            count--;
+        }
+        __osRestoreInt(saved);
 
-        if (c != 0) {
-            u32 addr = (u32) &gISVDbgPrnAdrs->data + (start & 0xffffffc);
-            s32 shift = ((3 - (start & 3)) * 8);
+        if (count) {
+            is_debug_flush();
+        }
+    }
+    return (char*) 1;
+}
 
-            osEPiReadIo(nuPiCartHandle, addr, &data);
-            osEPiWriteIo(nuPiCartHandle, addr, (data & ~(0xff << shift)) | ((u8)*str << shift));
+// Copies a block to the IS-Viewer buffer, or nothing at all if the whole block doesn't fit.
+static b32 is_debug_write_block(const void* data, size_t count) {
+    const u8* bytes = data;
+    u32 word;
+    s32 pos;
+    s32 start;
+    s32 avail;
 
+    osEPiReadIo(nuPiCartHandle, (u32) &gISVDbgPrnAdrs->magic, &word);
+    if (word != ASCII_TO_U32('I', 'S', '6', '4')) {
+        // no IS-Viewer attached, nobody is reading anyway
+        return TRUE;
+    }
+    osEPiReadIo(nuPiCartHandle, (u32) &gISVDbgPrnAdrs->get, &word);
+    pos = word;
+    osEPiReadIo(nuPiCartHandle, (u32) &gISVDbgPrnAdrs->put, &word);
+    start = word;
+
+    avail = pos - start - 1;
+    if (avail < 0) {
+        avail += 0xffe0;
+    }
+    if (count > avail) {
+        return FALSE;
+    }
+
+    while (count) {
+        u32 addr = (u32) &gISVDbgPrnAdrs->data + (start & 0xffffffc);
+
+        if ((start & 3) == 0 && count >= 4 && start + 4 <= 0xffe0) {
+            // whole aligned words don't need to be read back first
+            osEPiWriteIo(nuPiCartHandle, addr, (bytes[0] << 24) | (bytes[1] << 16) | (bytes[2] << 8) | bytes[3]);
+            start += 4;
+            bytes += 4;
+            count -= 4;
+        } else {
+            s32 shift = ((3 - (start & 3)) * 8);
+
+            osEPiReadIo(nuPiCartHandle, addr, &word);
+            osEPiWriteIo(nuPiCartHandle, addr, (word & ~(0xff << shift)) | (*bytes << shift));
             start++;
-            if (start >= 0xffe0) {
-                start -= 0xffe0;
-            }
+            bytes++;
+            count--;
+        }
+
+        if (start >= 0xffe0) {
+            start -= 0xffe0;
         }
-        count--;
-        str++;
     }
     osEPiWriteIo(nuPiCartHandle, (u32)&gISVDbgPrnAdrs->put, start);
-    return (char*) 1;
+    return TRUE;
+}
+
+/// Writes raw bytes to the IS-Viewer buffer. Unlike is_debug_print, zero bytes are kept, so this can carry binary
+/// records. Any buffered text is flushed first to keep the output in order.
+void is_debug_write(const void* data, size_t count) {
+    b32 locked = is_debug_lock();
+
+    is_debug_flush_locked();
+    if (!is_debug_write_block(data, count)) {
+        ISLogDroppedBytes += count;
+    }
+    is_debug_unlock(locked);
 }
 
 void is_debug_panic(const char* message) {
+    is_debug_flush();
     crash_screen_set_assert_info(message);
     *(volatile u32*)0 = 0; // Crash so we can see the crash screen
 }
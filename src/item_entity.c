@@ -14,6 +14,11 @@
 #include "sprite/player.h"
 
 #define MAX_ITEM_ENTITIES 256
+#define ITEM_ENTITY_MASK_WORDS (MAX_ITEM_ENTITIES / 32)
+
+// generous bounds used to skip items far outside the view before queueing them for rendering
+#define ITEM_CULL_HALF_WIDTH 24.0f
+#define ITEM_CULL_HEIGHT 40.0f
 
 extern SparkleScript SparkleScript_Coin;
 
@@ -53,6 +58,12 @@ BSS EffectInstance* ItemPickupGotOutline;
 BSS MessagePrintState* GotItemTutorialPrinter;
 BSS b32 GotItemTutorialClosed;
 
+// one bit per slot of WorldItemEntities / BattleItemEntities that is in use, so loops over the item entities only
+// visit live ones, still in slot order
+BSS u32 WorldItemEntityMask[ITEM_ENTITY_MASK_WORDS];
+BSS u32 BattleItemEntityMask[ITEM_ENTITY_MASK_WORDS];
+BSS u32* gCurrentItemEntityMask;
+
 void item_entity_update(ItemEntity*);
 void appendGfx_item_entity(void*);
 void draw_item_entities(void);
@@ -216,6 +227,57 @@ void draw_coin_sparkles(ItemEntity* item) {
     gDPPipeSync(gMainGfxPos++);
 }
 
+/// Returns the first item entity slot in use at or after index, or MAX_ITEM_ENTITIES if there is none.
+s32 next_item_entity_index(s32 index) {
+    u32 bits;
+
+    while (index < MAX_ITEM_ENTITIES) {
+        bits = gCurrentItemEntityMask[index / 32] >> (index % 32);
+        if (bits != 0) {
+            while (!(bits & 1)) {
+                bits >>= 1;
+                index++;
+            }
+            return index;
+        }
+        index = (index | 31) + 1;
+    }
+    return MAX_ITEM_ENTITIES;
+}
+
+b32 has_free_item_entity_slot(void) {
+    s32 i;
+
+    for (i = 0; i < ITEM_ENTITY_MASK_WORDS; i++) {
+        if (gCurrentItemEntityMask[i] != 0xFFFFFFFF) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+s32 find_free_item_entity_index(void) {
+    s32 i, j;
+
+    for (i = 0; i < ITEM_ENTITY_MASK_WORDS; i++) {
+        if (gCurrentItemEntityMask[i] != 0xFFFFFFFF) {
+            for (j = 0; gCurrentItemEntityMask[i] & (1U << j); j++) {
+            }
+            return i * 32 + j;
+        }
+    }
+    return MAX_ITEM_ENTITIES;
+}
+
+void set_item_entity_slot(s32 index, ItemEntity* item) {
+    gCurrentItemEntities[index] = item;
+    if (item != NULL) {
+        gCurrentItemEntityMask[index / 32] |= 1U << (index % 32);
+    } else {
+        gCurrentItemEntityMask[index / 32] &= ~(1U << (index % 32));
+    }
+}
+
 ItemEntity* get_item_entity(s32 itemEntityIndex) {
     return gCurrentItemEntities[itemEntityIndex];
 }
@@ -245,13 +307,18 @@ void clear_item_entity_data(void) {
 
     if (gGameStatusPtr->context == CONTEXT_WORLD) {
         gCurrentItemEntities = WorldItemEntities;
+        gCurrentItemEntityMask = WorldItemEntityMask;
     } else {
         gCurrentItemEntities = BattleItemEntities;
+        gCurrentItemEntityMask = BattleItemEntityMask;
     }
 
     for (i = 0; i < MAX_ITEM_ENTITIES; i++) {
         gCurrentItemEntities[i] = NULL;
     }
+    for (i = 0; i < ITEM_ENTITY_MASK_WORDS; i++) {
+        gCurrentItemEntityMask[i] = 0;
+    }
 
     ItemEntitiesCreated = 0;
     CoinSparkleCenterX = 0;
@@ -274,8 +341,10 @@ void clear_item_entity_data(void) {
 void init_item_entity_list(void) {
     if (gGameStatusPtr->context == CONTEXT_WORLD) {
         gCurrentItemEntities = WorldItemEntities;
+        gCurrentItemEntityMask = WorldItemEntityMask;
     } else {
         gCurrentItemEntities = BattleItemEntities;
+        gCurrentItemEntityMask = BattleItemEntityMask;
     }
 
     isPickingUpItem = FALSE;
@@ -421,16 +490,12 @@ s32 make_item_entity(s32 itemID, f32 x, f32 y, f32 z, s32 itemSpawnMode, s32 pic
         }
     }
 
-    for (i = 0; i < MAX_ITEM_ENTITIES; i++) {
-        if (gCurrentItemEntities[i] == NULL) {
-            break;
-        }
-    }
-
+    i = find_free_item_entity_index();
     ASSERT(i < MAX_ITEM_ENTITIES);
 
     id = i;
-    gCurrentItemEntities[id] = item = heap_malloc(sizeof(*item));
+    item = heap_malloc(sizeof(*item));
+    set_item_entity_slot(id, item);
     ItemEntitiesCreated++;
     ASSERT(item != NULL);
 
@@ -698,15 +763,12 @@ s32 make_item_entity_at_player(s32 itemID, s32 category, s32 pickupMsgFlags) {
     f32 depth;
     s32 id;
 
-    for (i = 0; i < MAX_ITEM_ENTITIES; i++) {
-        if (gCurrentItemEntities[i] == NULL) {
-            break;
-        }
-    }
+    i = find_free_item_entity_index();
     ASSERT(i < MAX_ITEM_ENTITIES);
     id = i;
 
-    gCurrentItemEntities[id] = item = heap_malloc(sizeof(*item));
+    item = heap_malloc(sizeof(*item));
+    set_item_entity_slot(id, item);
     ItemEntitiesCreated++;
     ASSERT(item != NULL);
 
@@ -830,7 +892,7 @@ void update_item_entities(void) {
         return;
     }
 
-    for (i = 0; i < MAX_ITEM_ENTITIES; i++) {
+    for (i = next_item_entity_index(0); i < MAX_ITEM_ENTITIES; i = next_item_entity_index(i + 1)) {
         item = gCurrentItemEntities[i];
 
         if (item != NULL && item->flags != 0) {
@@ -1054,13 +1116,41 @@ void appendGfx_item_entity(void* data) {
     }
 }
 
+/// TRUE unless every corner of a box around the item is outside the same side of the view frustum.
+b32 is_item_entity_in_view(ItemEntity* item, Camera* camera) {
+    u32 outside = 0x3F;
+    s32 i;
+
+    for (i = 0; i < 8 && outside != 0; i++) {
+        f32 outX, outY, outZ, outW;
+        u32 planes = 0;
+
+        transform_point(camera->mtxPerspective,
+            item->pos.x + ((i & 1) ? ITEM_CULL_HALF_WIDTH : -ITEM_CULL_HALF_WIDTH),
+            item->pos.y + ((i & 2) ? ITEM_CULL_HEIGHT : -ITEM_CULL_HALF_WIDTH),
+            item->pos.z + ((i & 4) ? ITEM_CULL_HALF_WIDTH : -ITEM_CULL_HALF_WIDTH),
+            1.0f, &outX, &outY, &outZ, &outW);
+
+        if (outX < -outW) planes |= 0x01;
+        if (outX > outW)  planes |= 0x02;
+        if (outY < -outW) planes |= 0x04;
+        if (outY > outW)  planes |= 0x08;
+        if (outZ < -outW) planes |= 0x10;
+        if (outZ > outW)  planes |= 0x20;
+        outside &= planes;
+    }
+
+    return outside == 0;
+}
+
 void draw_item_entities(void) {
     RenderTask rt;
     RenderTask* rtPtr = &rt;
     RenderTask* retTask;
+    Camera* camera = &gCameras[gCurrentCamID];
     s32 i;
 
-    for (i = 0; i < MAX_ITEM_ENTITIES; i++) {
+    for (i = next_item_entity_index(0); i < MAX_ITEM_ENTITIES; i = next_item_entity_index(i + 1)) {
         ItemEntity* item = gCurrentItemEntities[i];
 
         if (item != NULL
@@ -1068,7 +1158,9 @@ void draw_item_entities(void) {
             && !(item->flags & ITEM_ENTITY_FLAG_HIDDEN)
             && (item->flags & (1 << gCurrentCamID))
             && !(item->flags & ITEM_ENTITY_FLAG_INVISIBLE)
-            && (item->renderGroup == -1 || ItemEntityRenderGroup == item->renderGroup))
+            && (item->renderGroup == -1 || ItemEntityRenderGroup == item->renderGroup)
+            // reflections are drawn mirrored below the floor, so keep everything when they're on
+            && ((gOverrideFlags & GLOBAL_OVERRIDES_ENABLE_FLOOR_REFLECTION) || is_item_entity_in_view(item, camera)))
         {
             if (!(item->flags & ITEM_ENTITY_FLAG_TRANSPARENT)) {
                 rtPtr->renderMode = RENDER_MODE_ALPHATEST;
@@ -1091,7 +1183,7 @@ void draw_ui_item_entities(void) {
         return;
     }
 
-    for (s32 i = 0; i < MAX_ITEM_ENTITIES; i++) {
+    for (s32 i = next_item_entity_index(0); i < MAX_ITEM_ENTITIES; i = next_item_entity_index(i + 1)) {
         ItemEntity* item = gCurrentItemEntities[i];
 
         if (item != NULL && item->flags != 0) {
@@ -1126,8 +1218,7 @@ void render_item_entities(void) {
     u8 r1, g1, b1, a1;
     s32 alpha;
 
-    // needed to move 'i++' to the bottom
-    for (i = 0; i < MAX_ITEM_ENTITIES;) {
+    for (i = next_item_entity_index(0); i < MAX_ITEM_ENTITIES;) {
         ItemEntity* item = gCurrentItemEntities[i];
         if (item != NULL) {
             if ((item->flags != 0)) {
@@ -1249,14 +1340,14 @@ void render_item_entities(void) {
                 }
             }
         }
-        i++;
+        i = next_item_entity_index(i + 1);
     }
 }
 
 void remove_item_entity_by_reference(ItemEntity* entity) {
     s32 index;
 
-    for (index = 0; index < MAX_ITEM_ENTITIES; index++) {
+    for (index = next_item_entity_index(0); index < MAX_ITEM_ENTITIES; index = next_item_entity_index(index + 1)) {
         if (gCurrentItemEntities[index] == entity) {
             break;
         }
@@ -1280,7 +1371,7 @@ void remove_item_entity_by_reference(ItemEntity* entity) {
 
         heap_free(gCurrentItemEntities[index]);
         isPickingUpItem = FALSE;
-        gCurrentItemEntities[index] = NULL;
+        set_item_entity_slot(index, NULL);
     }
 }
 
@@ -1299,7 +1390,7 @@ void remove_item_entity_by_index(s32 index) {
     }
 
     heap_free(gCurrentItemEntities[index]);
-    gCurrentItemEntities[index] = NULL;
+    set_item_entity_slot(index, NULL);
     isPickingUpItem = FALSE;
 }
 
@@ -1397,6 +1488,14 @@ b32 test_item_player_collision(ItemEntity* item) {
         return FALSE;
     }
 
+    // Items out of reach of both the player and the hammer (which is 24 units in front of the player) can't be hit,
+    // so skip working out where the hammer is. Coin-heavy drops can leave lots of items around.
+    dist = playerStatus->colliderDiameter / 4 + 13.5f + 24.0f + 14.0f;
+    if (fabsf(item->pos.x - playerStatus->pos.x) > dist || fabsf(item->pos.z - playerStatus->pos.z) > dist) {
+        item->flags &= ~ITEM_ENTITY_FLAG_JUST_SPAWNED;
+        return FALSE;
+    }
+
     hitDetected = FALSE;
     playerX = playerStatus->pos.x;
     playerY = playerStatus->pos.y;
@@ -1490,7 +1589,7 @@ s32 test_item_entity_position(f32 x, f32 y, f32 z, f32 dist) {
         return -1;
     }
 
-    for (i = 0; i < MAX_ITEM_ENTITIES; i++){
+    for (i = next_item_entity_index(0); i < MAX_ITEM_ENTITIES; i = next_item_entity_index(i + 1)) {
         item = gCurrentItemEntities[i];
 
         if (item == NULL) {
@@ -1,6 +1,7 @@
 #include "common.h"
 #include "nu/nusys.h"
 #include "dx/profiling.h"
+#include "dx/replay.h"
 
 // TODO move these somewhere else...
 u8 nuYieldBuf[NU_GFX_YIELD_BUF_SIZE];
@@ -45,6 +46,9 @@ extern DisplayContext DisplayContexts[2];
 u16* ResetFrameBufferArray;
 u16* nuGfxZBuffer;
 
+// CPU time taken to update and draw the last frame, or 0xFFFFFFFF if it was dropped because the RDP fell behind
+u32 gLastFrameCycles;
+
 void gfx_task_end_callback(void* unk) {
     profiler_rsp_completed(PROFILER_RSP_GFX);
 }
@@ -119,6 +123,8 @@ void gfxRetrace_Callback(s32 gfxTaskNum) {
     } else {
         D_80073E0A ^= 1;
         if (D_80073E0A == 0) {
+            u32 frameStart = osGetCount();
+
             step_game_loop();
             D_80073E08 = 1;
 
@@ -126,6 +132,9 @@ void gfxRetrace_Callback(s32 gfxTaskNum) {
                 D_80073E08 = 0;
                 gfx_task_background();
                 gfx_draw_frame();
+                gLastFrameCycles = osGetCount() - frameStart;
+            } else {
+                gLastFrameCycles = 0xFFFFFFFF;
             }
         }
     }
@@ -206,4 +215,5 @@ void appendGfx_reset_tile_pattern(void) {
 void gfxPreNMI_Callback(void) {
     ResetGameState = RESET_STATE_INIT;
     nuContRmbForceStop();
+    dx_replay_stop();
 }
@@ -7,6 +7,7 @@
 #include "game_modes.h"
 #include "dx/profiling.h"
 #include "dx/debug_menu.h"
+#include "dx/frame_arena.h"
 #include "chaos.h"
 
 s32 gOverrideFlags;
@@ -166,11 +167,14 @@ void step_game_loop(void) {
 
     // Unused rand_int used to advance the global random seed each visual frame
     rand_int(1);
+
+    is_debug_flush();
 }
 
 void gfx_task_background(void) {
     gDisplayContext = &DisplayContexts[gCurrentDisplayContextIndex];
     gMainGfxPos = &gDisplayContext->backgroundGfx[0];
+    frame_arena_reset();
 
     gfx_init_state();
     gfx_draw_background();
@@ -266,6 +270,10 @@ void gfx_draw_frame(void) {
 
     GFX_PROFILER_COMPLETE(PROFILER_TIME_SUB_GFX_FRONT_UI);
 
+    profiler_gfx_counter_update(PROFILER_COUNTER_SHADING_CACHE_HITS, SpriteShadingCacheHits);
+    profiler_gfx_counter_update(PROFILER_COUNTER_SHADING_CACHE_MISSES, SpriteShadingCacheMisses);
+    SpriteShadingCacheHits = SpriteShadingCacheMisses = 0;
+
     profiler_gfx_completed();
     profiler_print_times();
 
@@ -1329,6 +1329,9 @@ BSS ModelNode* wModelTreeRoot;
 BSS ModelNode* bModelTreeRoot;
 BSS ModelTreeInfoList wModelTreeNodeInfo;
 BSS ModelTreeInfoList bModelTreeNodeInfo;
+BSS ClonedModelIndexList wClonedModelIndices;
+BSS ClonedModelIndexList bClonedModelIndices;
+BSS ClonedModelIndexList* gCurrentClonedModelIndices;
 
 BSS s8 wBackgroundTintMode;
 BSS s8 bBackgroundTintMode;
@@ -2372,6 +2375,7 @@ void clear_model_data(void) {
         gCurrentModelTreeRoot = &wModelTreeRoot;
         gCurrentModelLocalVtxBuffers = &wModelLocalVtxBuffers;
         gCurrentModelTreeNodeInfo = &wModelTreeNodeInfo;
+        gCurrentClonedModelIndices = &wClonedModelIndices;
         gBackgroundTintModePtr = &wBackgroundTintMode;
         ShroudTintAmt = 0;
         ShroudTintR = 0;
@@ -2386,6 +2390,7 @@ void clear_model_data(void) {
         gCurrentModelTreeRoot = &bModelTreeRoot;
         gCurrentModelLocalVtxBuffers = &bModelLocalVtxBuffers;
         gCurrentModelTreeNodeInfo = &bModelTreeNodeInfo;
+        gCurrentClonedModelIndices = &bClonedModelIndices;
         gBackgroundTintModePtr = &bBackgroundTintMode;
         gFogSettings = &bFogSettings;
     }
@@ -2409,6 +2414,11 @@ void clear_model_data(void) {
         (*gCurrentModelTreeNodeInfo)[i].modelIndex = -1;
         (*gCurrentModelTreeNodeInfo)[i].treeDepth = 0;
         (*gCurrentModelTreeNodeInfo)[i].textureID = 0;
+        (*gCurrentModelTreeNodeInfo)[i].transformGroupIndex = -1;
+    }
+
+    for (i = 0; i < ARRAY_COUNT(*gCurrentClonedModelIndices); i++) {
+        (*gCurrentClonedModelIndices)[i] = -1;
     }
 
     *gBackgroundTintModePtr = ENV_TINT_NONE;
@@ -2437,6 +2447,7 @@ void init_model_data(void) {
         gCurrentModelTreeRoot = &wModelTreeRoot;
         gCurrentModelLocalVtxBuffers = &wModelLocalVtxBuffers;
         gCurrentModelTreeNodeInfo = &wModelTreeNodeInfo;
+        gCurrentClonedModelIndices = &wClonedModelIndices;
         gBackgroundTintModePtr = &wBackgroundTintMode;
         gFogSettings = &wFogSettings;
     } else {
@@ -2447,6 +2458,7 @@ void init_model_data(void) {
         gCurrentModelTreeRoot = &bModelTreeRoot;
         gCurrentModelLocalVtxBuffers = &bModelLocalVtxBuffers;
         gCurrentModelTreeNodeInfo = &bModelTreeNodeInfo;
+        gCurrentClonedModelIndices = &bClonedModelIndices;
         gBackgroundTintModePtr = &bBackgroundTintMode;
         gFogSettings = &bFogSettings;
     }
@@ -3397,9 +3409,15 @@ void load_model_transforms(ModelNode* model, ModelNode* parent, Matrix4f mdlTran
 s32 get_model_list_index_from_tree_index(s32 treeIndex) {
     s32 i;
 
-    if (treeIndex < MAX_MODELS) {
+    if (treeIndex < ARRAY_COUNT(*gCurrentModelTreeNodeInfo)) {
         u8 modelIndex = (*gCurrentModelTreeNodeInfo)[treeIndex].modelIndex;
 
+        if (modelIndex != (u8)-1) {
+            return modelIndex;
+        }
+    } else if (treeIndex >= CLONED_MODEL(0) && treeIndex < CLONED_MODEL(MAX_CLONED_MODEL_IDS)) {
+        u8 modelIndex = (*gCurrentClonedModelIndices)[treeIndex - CLONED_MODEL(0)];
+
         if (modelIndex != (u8)-1) {
             return modelIndex;
         }
@@ -3416,15 +3434,8 @@ s32 get_model_list_index_from_tree_index(s32 treeIndex) {
 }
 
 s32 get_transform_group_index(s32 modelID) {
-    ModelTransformGroup* group;
-    s32 i;
-
-    for (i = 0; i < MAX_MODEL_TRANSFORM_GROUPS; i++) {
-        group = get_transform_group(i);
-
-        if (group != NULL && group->groupModelID == modelID) {
-            return i;
-        }
+    if (modelID >= 0 && modelID < ARRAY_COUNT(*gCurrentModelTreeNodeInfo)) {
+        return (*gCurrentModelTreeNodeInfo)[modelID].transformGroupIndex;
     }
 
     return -1;
@@ -3534,6 +3545,11 @@ void mdl_make_transform_group(u16 modelID) {
         }
 
         (*gCurrentTransformGroups)[i] = newMtg = heap_malloc(sizeof(*newMtg));
+        if (modelID < ARRAY_COUNT(*gCurrentModelTreeNodeInfo)
+            && (*gCurrentModelTreeNodeInfo)[modelID].transformGroupIndex < 0
+        ) {
+            (*gCurrentModelTreeNodeInfo)[modelID].transformGroupIndex = i;
+        }
         newMtg->flags = TRANSFORM_GROUP_FLAG_VALID;
         newMtg->groupModelID = modelID;
         newMtg->minChildModelIndex = get_model_list_index_from_tree_index(mtg_MinChild);
@@ -3632,6 +3648,14 @@ void clone_model(u16 srcModelID, u16 newModelID) {
     (*gCurrentModels)[i] = newModel = heap_malloc(sizeof(*newModel));
     *newModel = *srcModel;
     newModel->modelID = newModelID;
+
+    if (newModelID >= CLONED_MODEL(0) && newModelID < CLONED_MODEL(MAX_CLONED_MODEL_IDS)) {
+        u8* clonedIndex = &(*gCurrentClonedModelIndices)[newModelID - CLONED_MODEL(0)];
+
+        if (*clonedIndex == (u8)-1) {
+            *clonedIndex = i;
+        }
+    }
 }
 
 void mdl_group_set_visibility(u16 treeIndex, s32 flags, s32 mode) {
@@ -2,6 +2,7 @@
 #include "ld_addrs.h"
 #include "message_ids.h"
 #include "sprite.h"
+#include "dx/frame_arena.h"
 
 #include "charset/charset.h"
 #include "charset/postcard.png.h"
@@ -1523,7 +1524,7 @@ void set_message_text_var(s32 msgID, s32 index) {
     u8* msgVars;
 
     if (msgID >= 0) {
-        mallocSpace = general_heap_malloc(0x400);
+        mallocSpace = frame_temp_alloc(0x400);
         dma_load_msg(msgID, mallocSpace);
         msgID = (s32)mallocSpace;
     }
@@ -1543,7 +1544,7 @@ void set_message_text_var(s32 msgID, s32 index) {
     }
 
     if (mallocSpace != NULL) {
-        general_heap_free(mallocSpace);
+        frame_temp_free(mallocSpace);
     }
 }
 
@@ -1716,7 +1717,7 @@ void get_msg_properties(s32 msgID, s32* height, s32* width, s32* maxLineChars, s
     }
 
     if (msgID >= 0) {
-        buffer = general_heap_malloc(0x400);
+        buffer = frame_temp_alloc(0x400);
         dma_load_msg(msgID, buffer);
         message = buffer;
     } else {
@@ -1926,7 +1927,7 @@ void get_msg_properties(s32 msgID, s32* height, s32* width, s32* maxLineChars, s
     } while (!stop);
 
     if (buffer != NULL) {
-        general_heap_free(buffer);
+        frame_temp_free(buffer);
     }
 
     for (i = 0; i < lineIndex; i++) {
@@ -2014,7 +2015,7 @@ void draw_msg(s32 msgID, s32 posX, s32 posY, s32 opacity, s32 palette, u8 style)
         if (msgID < 0) {
             printer->srcBuffer = (u8*)msgID;
         } else {
-            mallocSpace = general_heap_malloc(0x400);
+            mallocSpace = frame_temp_alloc(0x400);
             dma_load_msg(msgID, mallocSpace);
             printer->srcBuffer = mallocSpace;
             get_msg_properties((s32) printer->srcBuffer, 0, &width, 0, 0, 0, 0, charset);
@@ -2053,7 +2054,7 @@ void draw_msg(s32 msgID, s32 posX, s32 posY, s32 opacity, s32 palette, u8 style)
         appendGfx_message(printer, (s16)posX, (s16)posY, 0, 0, flags, opacity & 0xFF);
 
         if (mallocSpace != NULL) {
-            general_heap_free(mallocSpace);
+            frame_temp_free(mallocSpace);
         }
     }
 }
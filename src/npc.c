@@ -14,6 +14,12 @@ static NpcList gBattleNpcList;
 NpcList* gCurrentNpcListPtr;
 static b8 gNpcPlayerCollisionsEnabled;
 
+// Lookup tables from an NPC ID (by its low byte) to its slot in the current NPC list and to its enemy. IDs are written
+// to npcID after the NPC is created and may change later, so an entry is only used while it still matches and is
+// refreshed by a scan otherwise.
+static s8 gNpcSlotByID[256];
+static Enemy* gEnemyByNpcID[256];
+
 #define PAL_ANIM_END 0xFF
 
 enum PalSwapState {
@@ -73,6 +79,7 @@ void clear_npcs(void) {
 
     gNpcCount = 0;
     gNpcPlayerCollisionsEnabled = TRUE;
+    clear_npc_lookup();
 }
 
 void init_npc_list(void) {
@@ -84,6 +91,52 @@ void init_npc_list(void) {
 
     gNpcCount = 0;
     gNpcPlayerCollisionsEnabled = TRUE;
+    clear_npc_lookup();
+}
+
+void clear_npc_lookup(void) {
+    s32 i;
+
+    for (i = 0; i < ARRAY_COUNT(gNpcSlotByID); i++) {
+        gNpcSlotByID[i] = -1;
+    }
+}
+
+static s32 scan_npc_slot(s32 npcID) {
+    s32 i;
+    Npc* npc;
+
+    for (i = 0; i < MAX_NPCS; i++) {
+        npc = (*gCurrentNpcListPtr)[i];
+        if (npc != NULL && npc->flags != 0 && npc->npcID == npcID) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static s32 find_npc_slot(s32 npcID) {
+    s32 slot = gNpcSlotByID[npcID & 0xFF];
+    Npc* npc;
+
+    if (slot >= 0) {
+        npc = (*gCurrentNpcListPtr)[slot];
+        if (npc == NULL || npc->flags == 0 || npc->npcID != npcID) {
+            slot = -1;
+        }
+    }
+
+    if (slot < 0) {
+        slot = scan_npc_slot(npcID);
+        if (slot >= 0) {
+            gNpcSlotByID[npcID & 0xFF] = slot;
+        }
+    }
+
+#if DX_CHECK_NPC_LOOKUP
+    ASSERT_MSG(slot == scan_npc_slot(npcID), "NPC lookup for ID %d found slot %d", npcID, slot);
+#endif
+    return slot;
 }
 
 s32 create_npc_impl(NpcBlueprint* blueprint, AnimID* animList, s32 isPeachNpc) {
@@ -102,6 +155,9 @@ s32 create_npc_impl(NpcBlueprint* blueprint, AnimID* animList, s32 isPeachNpc) {
     gNpcCount++;
     ASSERT(npc != NULL);
 
+    // the new NPC may share an ID with one in a later slot, which a lookup must no longer return
+    clear_npc_lookup();
+
     npc->flags = blueprint->flags | (NPC_FLAG_TOUCHES_GROUND | NPC_FLAG_DIRTY_SHADOW | NPC_FLAG_HAS_SHADOW | NPC_FLAG_ENABLED);
     if (isPeachNpc) {
         npc->flags |= NPC_FLAG_NO_ANIMS_LOADED;
@@ -228,6 +284,10 @@ void free_npc_by_index(s32 listIndex) {
                 disable_npc_blur(npc);
             }
 
+            if (gNpcSlotByID[npc->npcID & 0xFF] == listIndex) {
+                gNpcSlotByID[npc->npcID & 0xFF] = -1;
+            }
+
             heap_free((*gCurrentNpcListPtr)[listIndex]);
             (*gCurrentNpcListPtr)[listIndex] = NULL;
             gNpcCount--;
@@ -257,14 +317,17 @@ void free_npc(Npc* npc) {
         disable_npc_blur(npc);
     }
 
-    heap_free(npc);
-
     for (i = 0; i < MAX_NPCS; i++) {
         if ((*gCurrentNpcListPtr)[i] == npc) {
             break;
         }
     }
 
+    if (gNpcSlotByID[npc->npcID & 0xFF] == i) {
+        gNpcSlotByID[npc->npcID & 0xFF] = -1;
+    }
+
+    heap_free(npc);
     (*gCurrentNpcListPtr)[i] = NULL;
     gNpcCount--;
 }
@@ -997,35 +1060,19 @@ void npc_move_heading(Npc* npc, f32 speed, f32 yaw) {
 }
 
 Npc* get_npc_unsafe(s32 npcID) {
-    s32 i;
-    Npc* npc;
-
-    for (i = 0; i < MAX_NPCS; i++) {
-        npc = (*gCurrentNpcListPtr)[i];
-        if (npc != NULL && npc->flags != 0 && npc->npcID == npcID) {
-            break;
-        }
-    }
-    ASSERT(i < MAX_NPCS);
+    s32 i = find_npc_slot(npcID);
 
-    return npc;
+    ASSERT(i >= 0);
+    return (*gCurrentNpcListPtr)[i];
 }
 
 Npc* get_npc_safe(s32 npcID) {
-    s32 i;
-    Npc* npc;
+    s32 i = find_npc_slot(npcID);
 
-    for (i = 0; i < MAX_NPCS; i++) {
-        npc = (*gCurrentNpcListPtr)[i];
-        if (npc != NULL && npc->flags != 0 && npc->npcID == npcID) {
-            break;
-        }
-    }
-    if (i >= MAX_NPCS) {
+    if (i < 0) {
         return NULL;
     }
-
-    return npc;
+    return (*gCurrentNpcListPtr)[i];
 }
 
 void enable_npc_shadow(Npc* npc) {
@@ -2200,6 +2247,7 @@ void init_encounter_status(void) {
     for (i = 0; i < ARRAY_COUNT(currentEncounter->encounterList); i++) {
         currentEncounter->encounterList[i] = 0;
     }
+    clear_enemy_lookup();
 
     currentEncounter->flags = ENCOUNTER_FLAG_NONE;
     currentEncounter->numEncounters = 0;
@@ -2233,6 +2281,7 @@ void clear_encounter_status(void) {
     for (i = 0; i < ARRAY_COUNT(currentEncounter->encounterList); i++) {
         currentEncounter->encounterList[i] = 0;
     }
+    clear_enemy_lookup();
 
     if (gGameStatusPtr->didAreaChange) {
         for (i = 0; i < ARRAY_COUNT(currentEncounter->defeatFlags); i++) {
@@ -2439,6 +2488,11 @@ void kill_enemy(Enemy* enemy) {
         COPY_set_defeated(encounterStatus->mapID, encounter->encounterID + i);
     }
 
+    if (gEnemyByNpcID[enemy->npcID & 0xFF] == enemy) {
+        gEnemyByNpcID[enemy->npcID & 0xFF] = NULL;
+    }
+
+    basic_ai_forget_sight(enemy);
     heap_free(enemy);
 }
 
@@ -2541,26 +2595,15 @@ void bind_npc_interact(s32 npcID, EvtScript* npcInteractBytecode) {
     }
 }
 
-Enemy* get_enemy(s32 npcID) {
-    EncounterStatus* currentEncounterStatus = &gCurrentEncounter;
+void clear_enemy_lookup(void) {
     s32 i;
-    s32 j;
 
-    for (i = 0; i < currentEncounterStatus->numEncounters; i++) {
-        Encounter* currentEncounter = currentEncounterStatus->encounterList[i];
-        if (currentEncounter != NULL) {
-            for (j = 0; j < currentEncounter->count; j++) {
-                Enemy* currentEnemy = currentEncounter->enemy[j];
-                if ((currentEnemy != NULL) && (currentEnemy->npcID == npcID)) {
-                    return currentEnemy;
-                }
-            }
-        }
+    for (i = 0; i < ARRAY_COUNT(gEnemyByNpcID); i++) {
+        gEnemyByNpcID[i] = NULL;
     }
-    PANIC();
 }
 
-Enemy* get_enemy_safe(s32 npcID) {
+static Enemy* scan_enemy(s32 npcID) {
     EncounterStatus* currentEncounterStatus = &gCurrentEncounter;
     s32 i;
     s32 j;
@@ -2579,3 +2622,32 @@ Enemy* get_enemy_safe(s32 npcID) {
     }
     return NULL;
 }
+
+static Enemy* find_enemy(s32 npcID) {
+    Enemy* enemy = gEnemyByNpcID[npcID & 0xFF];
+
+    if (enemy == NULL || enemy->npcID != npcID) {
+        enemy = scan_enemy(npcID);
+        if (enemy != NULL) {
+            gEnemyByNpcID[npcID & 0xFF] = enemy;
+        }
+    }
+
+#if DX_CHECK_NPC_LOOKUP
+    ASSERT_MSG(enemy == scan_enemy(npcID), "Enemy lookup for ID %d is stale", npcID);
+#endif
+    return enemy;
+}
+
+Enemy* get_enemy(s32 npcID) {
+    Enemy* enemy = find_enemy(npcID);
+
+    if (enemy == NULL) {
+        PANIC();
+    }
+    return enemy;
+}
+
+Enemy* get_enemy_safe(s32 npcID) {
+    return find_enemy(npcID);
+}
@@ -177,6 +177,10 @@ s32 spr_get_npc_color_variations(s32 npcSpriteID);
 
 void create_shading_palette(Matrix4f mtx, s32 uls, s32 ult, s32 lrs, s32 lrt, s32 alpha, s32);
 
+/// Shaded sprites drawn with reused and with recomputed light terms, reset after each frame is drawn.
+extern s32 SpriteShadingCacheHits;
+extern s32 SpriteShadingCacheMisses;
+
 SpriteAnimData* spr_load_sprite(s32 idx, s32 arg1, s32 arg2);
 
 #endif
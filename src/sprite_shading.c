@@ -11,6 +11,30 @@ BSS SpriteShadingProfile wSpriteShadingProfileAux;
 BSS SpriteShadingProfile bSpriteShadingProfileAux;
 BSS PAL_BIN SpriteShadingPalette[16];
 
+// Light terms are reused for sprites whose position, orientation and facing haven't changed since they were last
+// computed, as long as the shading profile is the same. Lights are often moved by writing to the profile directly, so
+// instead of tracking every write, the profile is compared against a snapshot once per frame.
+#define SHADING_CACHE_SIZE 32
+
+typedef struct SpriteShadingCacheEntry {
+    /* 0x00 */ Vec3f pos;
+    /* 0x0C */ Vec3f facingAxis; // third column of the sprite matrix
+    /* 0x18 */ f32 facingDir;
+    /* 0x1C */ u32 revision;
+    /* 0x20 */ Vec3f shadowDir;
+    /* 0x2C */ Vec3f shadowColor;
+    /* 0x38 */ Vec3f highlightColor;
+} SpriteShadingCacheEntry; // size = 0x44
+
+BSS SpriteShadingCacheEntry SpriteShadingCache[SHADING_CACHE_SIZE];
+BSS SpriteShadingProfile SpriteShadingSnapshot;
+BSS SpriteShadingProfile* SpriteShadingSnapshotProfile;
+BSS s32 SpriteShadingSnapshotFrame;
+BSS u32 SpriteShadingRevision;
+
+s32 SpriteShadingCacheHits;
+s32 SpriteShadingCacheMisses;
+
 void appendGfx_shading_palette(Matrix4f mtx, s32 uls, s32 ult, s32 lrs, s32 lrt, s32 alpha,
                              f32 shadowX, f32 shadowY, f32 shadowZ,
                              s32 shadowR, s32 shadowG, s32 shadowB,
@@ -63,9 +87,40 @@ void sprite_shading_set_light_source(u32 idx, s8 flags, f32 x, f32 y, f32 z, u8
     }
 }
 
+// bumps SpriteShadingRevision if the active shading profile changed since the last check
+void sprite_shading_update_revision(void) {
+    u32* cur = (u32*)gSpriteShadingProfile;
+    u32* saved = (u32*)&SpriteShadingSnapshot;
+    s32 i;
+
+    if (gSpriteShadingProfile == SpriteShadingSnapshotProfile
+        && gGameStatusPtr->frameCounter == SpriteShadingSnapshotFrame
+    ) {
+        return;
+    }
+
+    SpriteShadingSnapshotFrame = gGameStatusPtr->frameCounter;
+
+    if (gSpriteShadingProfile == SpriteShadingSnapshotProfile) {
+        for (i = 0; i < sizeof(SpriteShadingSnapshot) / sizeof(u32); i++) {
+            if (cur[i] != saved[i]) {
+                break;
+            }
+        }
+        if (i == sizeof(SpriteShadingSnapshot) / sizeof(u32)) {
+            return;
+        }
+    }
+
+    SpriteShadingSnapshotProfile = gSpriteShadingProfile;
+    SpriteShadingSnapshot = *gSpriteShadingProfile;
+    SpriteShadingRevision++;
+}
+
 void create_shading_palette(Matrix4f mtx, s32 uls, s32 ult, s32 lrs, s32 lrt, s32 alpha, s32 otherModeLBits) {
     Camera* camera = &gCameras[gCurrentCameraID];
     SpriteShadingLightSource* lightSource;
+    SpriteShadingCacheEntry* entry;
     f32 shadowDirX, shadowDirY, shadowDirZ;
     f32 posX, posY, posZ;
     f32 facingDir;
@@ -89,6 +144,8 @@ void create_shading_palette(Matrix4f mtx, s32 uls, s32 ult, s32 lrs, s32 lrt, s3
     f32 Pxz, Pzz;
     s32 i;
 
+    sprite_shading_update_revision();
+
     shadowDirX = 0.0f;
     shadowDirY = 0.0f;
     shadowDirZ = 0.0f;
@@ -126,6 +183,27 @@ void create_shading_palette(Matrix4f mtx, s32 uls, s32 ult, s32 lrs, s32 lrt, s3
         facingDir = -1.0f;
     }
 
+    entry = &SpriteShadingCache[((s32)posX * 3 + (s32)posY * 5 + (s32)posZ * 7) & (SHADING_CACHE_SIZE - 1)];
+    if (entry->revision == SpriteShadingRevision
+        && entry->pos.x == posX && entry->pos.y == posY && entry->pos.z == posZ
+        && entry->facingAxis.x == Mxz && entry->facingAxis.y == Myz && entry->facingAxis.z == Mzz
+        && entry->facingDir == facingDir
+    ) {
+        SpriteShadingCacheHits++;
+        appendGfx_shading_palette(
+            mtx,
+            uls, ult, lrs, lrt,
+            alpha,
+            entry->shadowDir.x, entry->shadowDir.y, entry->shadowDir.z,
+            entry->shadowColor.x, entry->shadowColor.y, entry->shadowColor.z,
+            entry->highlightColor.x, entry->highlightColor.y, entry->highlightColor.z,
+            gSpriteShadingProfile->ambientPower,
+            otherModeLBits
+        );
+        return;
+    }
+    SpriteShadingCacheMisses++;
+
     for (i = 0; i < ARRAY_COUNT(gSpriteShadingProfile->sources); i++) {
         lightSource = &gSpriteShadingProfile->sources[i];
         if (lightSource->flags & LIGHT_SOURCE_ENABLED) {
@@ -244,33 +322,41 @@ void create_shading_palette(Matrix4f mtx, s32 uls, s32 ult, s32 lrs, s32 lrt, s3
         qz = -Mxz;
     }
 
+    entry->revision = SpriteShadingRevision;
+    entry->pos.x = posX;
+    entry->pos.y = posY;
+    entry->pos.z = posZ;
+    entry->facingAxis.x = Mxz;
+    entry->facingAxis.y = Myz;
+    entry->facingAxis.z = Mzz;
+    entry->facingDir = facingDir;
+    entry->shadowDir.x = shadowDirX;
+    entry->shadowDir.y = shadowDirY;
+    entry->shadowDir.z = shadowDirZ;
+    entry->shadowColor.x = shadowColorR;
+    entry->shadowColor.y = shadowColorG;
+    entry->shadowColor.z = shadowColorB;
+
     if (qx * shadowDirX + qy * shadowDirY + qz * shadowDirZ > 0.0f) {
-        appendGfx_shading_palette(
-            mtx,
-            uls, ult, lrs, lrt,
-            alpha,
-            shadowDirX, shadowDirY, shadowDirZ,
-            shadowColorR, shadowColorG, shadowColorB,
-            gSpriteShadingProfile->ambientColor.r + commonColorR + backColorR,
-            gSpriteShadingProfile->ambientColor.g + commonColorG + backColorG,
-            gSpriteShadingProfile->ambientColor.b + commonColorB + backColorB,
-            gSpriteShadingProfile->ambientPower,
-            otherModeLBits
-        );
+        entry->highlightColor.x = gSpriteShadingProfile->ambientColor.r + commonColorR + backColorR;
+        entry->highlightColor.y = gSpriteShadingProfile->ambientColor.g + commonColorG + backColorG;
+        entry->highlightColor.z = gSpriteShadingProfile->ambientColor.b + commonColorB + backColorB;
     } else {
-        appendGfx_shading_palette(
-            mtx,
-            uls, ult, lrs, lrt,
-            alpha,
-            shadowDirX, shadowDirY, shadowDirZ,
-            shadowColorR, shadowColorG, shadowColorB,
-            gSpriteShadingProfile->ambientColor.r + commonColorR + frontColorR,
-            gSpriteShadingProfile->ambientColor.g + commonColorG + frontColorG,
-            gSpriteShadingProfile->ambientColor.b + commonColorB + frontColorB,
-            gSpriteShadingProfile->ambientPower,
-            otherModeLBits
-        );
+        entry->highlightColor.x = gSpriteShadingProfile->ambientColor.r + commonColorR + frontColorR;
+        entry->highlightColor.y = gSpriteShadingProfile->ambientColor.g + commonColorG + frontColorG;
+        entry->highlightColor.z = gSpriteShadingProfile->ambientColor.b + commonColorB + frontColorB;
     }
+
+    appendGfx_shading_palette(
+        mtx,
+        uls, ult, lrs, lrt,
+        alpha,
+        shadowDirX, shadowDirY, shadowDirZ,
+        shadowColorR, shadowColorG, shadowColorB,
+        entry->highlightColor.x, entry->highlightColor.y, entry->highlightColor.z,
+        gSpriteShadingProfile->ambientPower,
+        otherModeLBits
+    );
 }
 
 void appendGfx_shading_palette(
@@ -83,6 +83,8 @@ s32 D_80078168[] = {
 BSS PopupMessage D_800A0BC0[32];
 BSS s32 D_800A0F40;
 BSS HudStatusIcon* D_800A0F44;
+// One bit per icon set with a load, unload, or fade out still to be handled by update_all_status_icons
+BSS u32 StatusIconsPendingTasks[MAX_ICONS / 32];
 
 extern HudScript HES_Item_KeyGift;
 extern HudScript HES_AsleepBegin;
@@ -348,17 +350,46 @@ void init_all_status_icons(void) {
 
         for (i = 0; i < MAX_ICONS; i++, icons++)
             icons->flags = 0;
+
+        for (i = 0; i < ARRAY_COUNT(StatusIconsPendingTasks); i++) {
+            StatusIconsPendingTasks[i] = 0;
+        }
     }
 }
 
+void queue_status_icon_task(s32 iconID) {
+    StatusIconsPendingTasks[iconID / 32] |= 1U << (iconID % 32);
+}
+
+b32 status_icon_has_pending_task(HudStatusIcon* icon) {
+    return icon->status1.activeTask == STATUS_ICON_TASK_LOAD || icon->status1.removingTask != STATUS_ICON_TASK_NONE
+        || icon->status2.activeTask == STATUS_ICON_TASK_LOAD || icon->status2.removingTask != STATUS_ICON_TASK_NONE
+        || icon->status3.activeTask == STATUS_ICON_TASK_LOAD || icon->status3.removingTask != STATUS_ICON_TASK_NONE
+        || icon->status4.activeTask == STATUS_ICON_TASK_LOAD || icon->status4.removingTask != STATUS_ICON_TASK_NONE
+        || icon->boostJump.removing == 1 || icon->boostHammer.removing == 1;
+}
+
 void update_all_status_icons(void* data) {
     PopupMessage* popup = data;
     HudStatusIcon* icon;
     int i;
     s32 elementID;
+    u32 pending;
 
-    for (i = 0, icon = D_800A0F44; i < MAX_ICONS; i++, icon++) {
+    // only sets queued by a create or remove call are visited, and they stay queued until their tasks are done
+    for (i = 0; i < MAX_ICONS; i++) {
+        pending = StatusIconsPendingTasks[i / 32];
+        if (pending == 0) {
+            i |= 31;
+            continue;
+        }
+        if (!(pending & (1U << (i % 32)))) {
+            continue;
+        }
+
+        icon = &D_800A0F44[i];
         if (icon->flags == 0) {
+            StatusIconsPendingTasks[i / 32] &= ~(1U << (i % 32));
             continue;
         }
 
@@ -577,6 +608,10 @@ void update_all_status_icons(void* data) {
                 }
             }
         }
+
+        if (!status_icon_has_pending_task(icon)) {
+            StatusIconsPendingTasks[i / 32] &= ~(1U << (i % 32));
+        }
     }
 }
 
@@ -588,7 +623,9 @@ void draw_all_status_icons(void* data) {
     s32 screenX, screenY, screenZ;
     s32 isActiveDrawn, iconCounter;
     s32 offsetY;
+    s32 boostScreenX, boostScreenY;
     Camera* camera = &gCameras[gCurrentCameraID];
+    f32 radiusAngle = clamp_angle(camera->curYaw + 90);
     int i;
 
     gDPSetScissor(gMainGfxPos++, G_SC_NON_INTERLACE, 12, 20, SCREEN_WIDTH - 12, SCREEN_HEIGHT - 20);
@@ -622,7 +659,7 @@ void draw_all_status_icons(void* data) {
                 y = icon->worldPos.y + icon->status1OffsetY;
                 z = icon->worldPos.z;
 
-                add_vec2D_polar(&x, &z, icon->status1Radius, clamp_angle(camera->curYaw + 90));
+                add_vec2D_polar(&x, &z, icon->status1Radius, radiusAngle);
                 get_screen_coords(gCurrentCameraID, x, y, z, &screenX, &screenY, &screenZ);
                 elementId = icon->status1.activeElementID;
                 hud_element_set_render_pos(elementId, screenX - 8, screenY - 8);
@@ -645,7 +682,7 @@ void draw_all_status_icons(void* data) {
             y = icon->worldPos.y + icon->status1OffsetY;
             z = icon->worldPos.z;
 
-            add_vec2D_polar(&x, &z, icon->status1Radius, clamp_angle(camera->curYaw + 90));
+            add_vec2D_polar(&x, &z, icon->status1Radius, radiusAngle);
             get_screen_coords(gCurrentCameraID, x, y, z, &screenX, &screenY, &screenZ);
             elementId = icon->status1.removingElementID;
             hud_element_set_render_pos(elementId, screenX - 8, screenY - 8);
@@ -668,7 +705,7 @@ void draw_all_status_icons(void* data) {
                 y = icon->worldPos.y + icon->status2OffsetY + offsetY;
                 z = icon->worldPos.z;
 
-                add_vec2D_polar(&x, &z, icon->status2Radius, clamp_angle(camera->curYaw + 90));
+                add_vec2D_polar(&x, &z, icon->status2Radius, radiusAngle);
                 get_screen_coords(gCurrentCameraID, x, y, z, &screenX, &screenY, &screenZ);
                 elementId = icon->status2.activeElementID;
                 hud_element_set_render_pos(elementId, screenX - 8, screenY - 8);
@@ -696,7 +733,7 @@ void draw_all_status_icons(void* data) {
             y = icon->worldPos.y + icon->status2OffsetY + offsetY;
             z = icon->worldPos.z;
 
-            add_vec2D_polar(&x, &z, icon->status2Radius, clamp_angle(camera->curYaw + 90));
+            add_vec2D_polar(&x, &z, icon->status2Radius, radiusAngle);
             get_screen_coords(gCurrentCameraID, x, y, z, &screenX, &screenY, &screenZ);
             elementId = icon->status2.removingElementID;
             hud_element_set_render_pos(elementId, screenX - 8, screenY - 8);
@@ -721,7 +758,7 @@ void draw_all_status_icons(void* data) {
                 y = icon->worldPos.y + icon->status3OffsetY + offsetY;
                 z = icon->worldPos.z;
 
-                add_vec2D_polar(&x, &z, icon->status3Radius, clamp_angle(camera->curYaw + 90));
+                add_vec2D_polar(&x, &z, icon->status3Radius, radiusAngle);
                 get_screen_coords(gCurrentCameraID, x, y, z, &screenX, &screenY, &screenZ);
                 elementId = icon->status3.activeElementID;
                 hud_element_set_render_pos(elementId, screenX - 8, screenY - 8);
@@ -751,7 +788,7 @@ void draw_all_status_icons(void* data) {
             y = icon->worldPos.y + icon->status3OffsetY + offsetY;
             z = icon->worldPos.z;
 
-            add_vec2D_polar(&x, &z, icon->status3Radius, clamp_angle(camera->curYaw + 90));
+            add_vec2D_polar(&x, &z, icon->status3Radius, radiusAngle);
             get_screen_coords(gCurrentCameraID, x, y, z, &screenX, &screenY, &screenZ);
             elementId = icon->status3.removingElementID;
             hud_element_set_render_pos(elementId, screenX - 8, screenY - 8);
@@ -780,7 +817,7 @@ void draw_all_status_icons(void* data) {
                 y = icon->worldPos.y + icon->status4OffsetY + offsetY;
                 z = icon->worldPos.z;
 
-                add_vec2D_polar(&x, &z, icon->status4Radius, clamp_angle(camera->curYaw + 90));
+                add_vec2D_polar(&x, &z, icon->status4Radius, radiusAngle);
                 get_screen_coords(gCurrentCameraID, x, y, z, &screenX, &screenY, &screenZ);
                 elementId = icon->status4.activeElementID;
                 hud_element_set_render_pos(elementId, screenX - 8, screenY - 8);
@@ -813,13 +850,22 @@ void draw_all_status_icons(void* data) {
             y = icon->worldPos.y + icon->status4OffsetY + offsetY;
             z = icon->worldPos.z;
 
-            add_vec2D_polar(&x, &z, icon->status4Radius, clamp_angle(camera->curYaw + 90));
+            add_vec2D_polar(&x, &z, icon->status4Radius, radiusAngle);
             get_screen_coords(gCurrentCameraID, x, y, z, &screenX, &screenY, &screenZ);
             elementId = icon->status4.removingElementID;
             hud_element_set_render_pos(elementId, screenX - 8, screenY - 8);
             hud_element_draw_next(elementId);
         }
 
+        // the boost and alert icons all sit around the same point, which is projected once for the set
+        if (icon->boostJump.active || icon->boostJump.removing || icon->boostHammer.active
+            || icon->boostHammer.removing || icon->boostPartner.active || icon->surprise.active
+            || icon->peril.active || icon->danger.active
+        ) {
+            get_screen_coords(gCurrentCameraID, icon->worldPos.x, icon->worldPos.y + icon->offsetY, icon->worldPos.z,
+                              &boostScreenX, &boostScreenY, &screenZ);
+        }
+
         do {
             if (icon->boostJump.active) {
                 if (icon->flags & STATUS_ICON_FLAG_BOOST_JUMP) {
@@ -827,12 +873,8 @@ void draw_all_status_icons(void* data) {
                 } else if (icon->flags & STATUS_ICON_FLAG_BATTLE || gGameStatusPtr->context != CONTEXT_BATTLE) {
                     hud_element_clear_flags(icon->boostJump.activeElementID, HUD_ELEMENT_FLAG_DISABLED);
 
-                    x = icon->worldPos.x;
-                    z = icon->worldPos.z;
-
-                    get_screen_coords(gCurrentCameraID, x, icon->worldPos.y + icon->offsetY, z, &screenX, &screenY, &screenZ);
                     elementId = icon->boostJump.activeElementID;
-                    hud_element_set_render_pos(elementId, screenX + 2, screenY - 12);
+                    hud_element_set_render_pos(elementId, boostScreenX + 2, boostScreenY - 12);
                     hud_element_draw_next(elementId);
                 }
             }
@@ -841,12 +883,8 @@ void draw_all_status_icons(void* data) {
         if (icon->boostJump.removing) {
             hud_element_clear_flags(icon->prevIndexBoostJump, HUD_ELEMENT_FLAG_DISABLED);
 
-            x = icon->worldPos.x;
-            z = icon->worldPos.z;
-
-            get_screen_coords(gCurrentCameraID, x, icon->worldPos.y + icon->offsetY, z, &screenX, &screenY, &screenZ);
             elementId = icon->prevIndexBoostJump;
-            hud_element_set_render_pos(elementId, screenX + 2, screenY - 12);
+            hud_element_set_render_pos(elementId, boostScreenX + 2, boostScreenY - 12);
             hud_element_draw_next(elementId);
         }
 
@@ -857,12 +895,8 @@ void draw_all_status_icons(void* data) {
                 } else if (icon->flags & STATUS_ICON_FLAG_BATTLE || gGameStatusPtr->context != CONTEXT_BATTLE) {
                     hud_element_clear_flags(icon->boostHammer.activeElementID, HUD_ELEMENT_FLAG_DISABLED);
 
-                    x = icon->worldPos.x;
-                    z = icon->worldPos.z;
-
-                    get_screen_coords(gCurrentCameraID, x, icon->worldPos.y + icon->offsetY, z, &screenX, &screenY, &screenZ);
                     elementId = icon->boostHammer.activeElementID;
-                    hud_element_set_render_pos(elementId, screenX + 2, screenY - 12);
+                    hud_element_set_render_pos(elementId, boostScreenX + 2, boostScreenY - 12);
                     hud_element_draw_next(elementId);
                 }
             }
@@ -871,12 +905,8 @@ void draw_all_status_icons(void* data) {
         if (icon->boostHammer.removing) {
             hud_element_clear_flags(icon->prevIndexBoostHammer, HUD_ELEMENT_FLAG_DISABLED);
 
-            x = icon->worldPos.x;
-            z = icon->worldPos.z;
-
-            get_screen_coords(gCurrentCameraID, x, icon->worldPos.y + icon->offsetY, z, &screenX, &screenY, &screenZ);
             elementId = icon->prevIndexBoostHammer;
-            hud_element_set_render_pos(elementId, screenX + 2, screenY - 12);
+            hud_element_set_render_pos(elementId, boostScreenX + 2, boostScreenY - 12);
             hud_element_draw_next(elementId);
         }
 
@@ -887,12 +917,8 @@ void draw_all_status_icons(void* data) {
                 } else if (icon->flags & STATUS_ICON_FLAG_BATTLE || gGameStatusPtr->context != CONTEXT_BATTLE) {
                     hud_element_clear_flags(icon->boostPartner.activeElementID, HUD_ELEMENT_FLAG_DISABLED);
 
-                    x = icon->worldPos.x;
-                    z = icon->worldPos.z;
-
-                    get_screen_coords(gCurrentCameraID, x, icon->worldPos.y + icon->offsetY, z, &screenX, &screenY, &screenZ);
                     elementId = icon->boostPartner.activeElementID;
-                    hud_element_set_render_pos(elementId, screenX + 2, screenY - 12);
+                    hud_element_set_render_pos(elementId, boostScreenX + 2, boostScreenY - 12);
                     hud_element_draw_next(elementId);
                 }
             }
@@ -905,12 +931,8 @@ void draw_all_status_icons(void* data) {
                 } else if (icon->flags & STATUS_ICON_FLAG_BATTLE || gGameStatusPtr->context != CONTEXT_BATTLE) {
                     hud_element_clear_flags(icon->surprise.activeElementID, HUD_ELEMENT_FLAG_DISABLED);
 
-                    x = icon->worldPos.x;
-                    z = icon->worldPos.z;
-
-                    get_screen_coords(gCurrentCameraID, x, icon->worldPos.y + icon->offsetY, z, &screenX, &screenY, &screenZ);
                     elementId = icon->surprise.activeElementID;
-                    hud_element_set_render_pos(elementId, screenX + 2, screenY - 15);
+                    hud_element_set_render_pos(elementId, boostScreenX + 2, boostScreenY - 15);
                     hud_element_draw_next(elementId);
                 }
             }
@@ -923,12 +945,8 @@ void draw_all_status_icons(void* data) {
                 } else if (icon->flags & STATUS_ICON_FLAG_BATTLE || gGameStatusPtr->context != CONTEXT_BATTLE) {
                     hud_element_clear_flags(icon->peril.activeElementID, HUD_ELEMENT_FLAG_DISABLED);
 
-                    x = icon->worldPos.x;
-                    z = icon->worldPos.z;
-
-                    get_screen_coords(gCurrentCameraID, x, icon->worldPos.y + icon->offsetY, z, &screenX, &screenY, &screenZ);
                     elementId = icon->peril.activeElementID;
-                    hud_element_set_render_pos(elementId, screenX + 2, screenY - 16);
+                    hud_element_set_render_pos(elementId, boostScreenX + 2, boostScreenY - 16);
                     hud_element_draw_next(elementId);
                 }
             }
@@ -941,12 +959,8 @@ void draw_all_status_icons(void* data) {
                 } else if (icon->flags & STATUS_ICON_FLAG_BATTLE || gGameStatusPtr->context != CONTEXT_BATTLE) {
                     hud_element_clear_flags(icon->danger.activeElementID, HUD_ELEMENT_FLAG_DISABLED);
 
-                    x = icon->worldPos.x;
-                    z = icon->worldPos.z;
-
-                    get_screen_coords(gCurrentCameraID, x, icon->worldPos.y + icon->offsetY, z, &screenX, &screenY, &screenZ);
                     elementId = icon->danger.activeElementID;
-                    hud_element_set_render_pos(elementId, screenX + 2, screenY - 16);
+                    hud_element_set_render_pos(elementId, boostScreenX + 2, boostScreenY - 16);
                     hud_element_draw_next(elementId);
                 }
             }
@@ -1008,6 +1022,7 @@ s32 create_status_icon_set(void) {
     icon->surprise.active = 0;
     icon->peril.active = 0;
     icon->danger.active = 0;
+    StatusIconsPendingTasks[i / 32] &= ~(1U << (i % 32));
 
     return i;
 }
@@ -1059,6 +1074,7 @@ void create_status_debuff(s32 iconID, s32 statusID) {
         remove_status_debuff(iconID);
         statusIcon->status1.active = statusID;
         statusIcon->status1.activeTask = STATUS_ICON_TASK_LOAD;
+        queue_status_icon_task(iconID);
     }
 }
 
@@ -1072,6 +1088,7 @@ void remove_status_debuff(s32 iconID) {
         statusIcon->status1.activeTask = STATUS_ICON_TASK_NONE;
         statusIcon->status1.frameCounter = 10;
         statusIcon->status1.removingElementID = statusIcon->status1.activeElementID;
+        queue_status_icon_task(iconID);
     }
 }
 
@@ -1089,6 +1106,7 @@ void create_status_static(s32 iconID, s32 statusID) {
         remove_status_static(iconID);
         statusIcon->status2.active = statusID;
         statusIcon->status2.activeTask = 1;
+        queue_status_icon_task(iconID);
     }
 }
 
@@ -1102,6 +1120,7 @@ void remove_status_static(s32 iconID) {
         statusIcon->status2.activeTask = FALSE;
         statusIcon->status2.frameCounter = 10;
         statusIcon->status2.removingElementID = statusIcon->status2.activeElementID;
+        queue_status_icon_task(iconID);
     }
 }
 
@@ -1119,6 +1138,7 @@ void create_status_transparent(s32 iconID, s32 statusID) {
         remove_status_transparent(iconID);
         statusIcon->status3.active = statusID;
         statusIcon->status3.activeTask = 1;
+        queue_status_icon_task(iconID);
     }
 }
 
@@ -1132,6 +1152,7 @@ void remove_status_transparent(s32 iconID) {
         statusIcon->status3.activeTask = FALSE;
         statusIcon->status3.frameCounter = 10;
         statusIcon->status3.removingElementID = statusIcon->status3.activeElementID;
+        queue_status_icon_task(iconID);
     }
 }
 
@@ -1148,6 +1169,7 @@ void create_status_chill_out(s32 iconID) {
     if (!statusIcon->status4.active) {
         statusIcon->status4.active = TRUE;
         statusIcon->status4.activeTask = TRUE;
+        queue_status_icon_task(iconID);
     }
 }
 
@@ -1161,6 +1183,7 @@ void remove_status_chill_out(s32 iconID) {
         statusIcon->status4.activeTask = FALSE;
         statusIcon->status4.frameCounter = 10;
         statusIcon->status4.removingElementID = statusIcon->status4.activeElementID;
+        queue_status_icon_task(iconID);
     }
 }
 
@@ -1193,6 +1216,7 @@ void remove_status_icon_boost_jump(s32 iconID) {
         statusIcon->boostJump.removing = TRUE;
         statusIcon->prevIndexBoostJump = hudElemIndex;
         hud_element_set_script(hudElemIndex, &HES_BoostJumpEnd);
+        queue_status_icon_task(iconID);
     }
 }
 
@@ -1225,6 +1249,7 @@ void remove_status_icon_boost_hammer(s32 iconID) {
         statusIcon->boostHammer.removing = FALSE;
         statusIcon->prevIndexBoostHammer = hudElemIndex;
         hud_element_set_script(hudElemIndex, &HES_BoostHammerEnd);
+        queue_status_icon_task(iconID);
     }
 }
 
@@ -6,6 +6,12 @@ BSS TriggerList wTriggerList;
 BSS TriggerList bTriggerList;
 BSS TriggerList* gCurrentTriggerListPtr;
 
+// The interact prompt checks ask should_collider_allow_interact about the same wall every frame for as long as the
+// player stands against it, so the last answer is kept until the trigger list changes.
+BSS s32 InteractTriggerCacheCollider;
+BSS b32 InteractTriggerCacheResult;
+BSS b32 InteractTriggerCacheValid;
+
 void default_trigger_on_activate(Trigger* self) {
     self->flags |= TRIGGER_ACTIVATED;
 }
@@ -25,6 +31,7 @@ void clear_trigger_data(void) {
     }
 
     gTriggerCount = 0;
+    InteractTriggerCacheValid = FALSE;
     collisionStatus->pushingAgainstWall = NO_COLLIDER;
     collisionStatus->curFloor = NO_COLLIDER;
     collisionStatus->lastTouchedFloor = NO_COLLIDER;
@@ -50,6 +57,7 @@ void init_trigger_list(void) {
     }
 
     gTriggerCount = 0;
+    InteractTriggerCacheValid = FALSE;
 }
 
 Trigger* create_trigger(TriggerBlueprint* bp) {
@@ -68,6 +76,7 @@ Trigger* create_trigger(TriggerBlueprint* bp) {
 
     (*gCurrentTriggerListPtr)[i] = trigger = heap_malloc(sizeof(*trigger));
     gTriggerCount++;
+    InteractTriggerCacheValid = FALSE;
 
     ASSERT(trigger != NULL);
 
@@ -248,6 +257,7 @@ void delete_trigger(Trigger* toDelete) {
     if (i < ARRAY_COUNT(*gCurrentTriggerListPtr)) {
         heap_free((*gCurrentTriggerListPtr)[i]);
         (*gCurrentTriggerListPtr)[i] = NULL;
+        InteractTriggerCacheValid = FALSE;
     }
 }
 
@@ -285,6 +295,14 @@ s32 should_collider_allow_interact(s32 colliderID) {
         return FALSE;
     }
 
+    if (InteractTriggerCacheValid && InteractTriggerCacheCollider == colliderID) {
+        return InteractTriggerCacheResult;
+    }
+
+    InteractTriggerCacheValid = TRUE;
+    InteractTriggerCacheCollider = colliderID;
+    InteractTriggerCacheResult = FALSE;
+
     for (i = 0; i < ARRAY_COUNT(*gCurrentTriggerListPtr); i++) {
         Trigger* trigger = (*gCurrentTriggerListPtr)[i];
 
@@ -293,8 +311,9 @@ s32 should_collider_allow_interact(s32 colliderID) {
             && trigger->location.colliderID == colliderID
             && trigger->flags & TRIGGER_WALL_PRESS_A
         ) {
-            return TRUE;
+            InteractTriggerCacheResult = TRUE;
+            break;
         }
     }
-    return FALSE;
+    return InteractTriggerCacheResult;
 }
@@ -20,8 +20,33 @@ typedef struct WindowGroup {
     /* 0x01 */ u8 max;
 } WindowGroup; // size = 0x02
 
+#define WINDOW_BOX_CACHE_SLOTS 16
+#define WINDOW_BOX_CACHE_GFX 80
+
+// Commands draw_box emitted for the frame of a window that is not rotated or scaled, replayed while none of the
+// parameters they were built from change
+typedef struct WindowBoxCacheEntry {
+    /* 0x00 */ b8 valid;
+    /* 0x01 */ s8 windowID;
+    /* 0x02 */ u8 opacity;
+    /* 0x03 */ u8 darkening;
+    /* 0x04 */ s32 flags;
+    /* 0x08 */ WindowStyle style;
+    /* 0x0C */ s16 posX;
+    /* 0x0E */ s16 posY;
+    /* 0x10 */ s16 width;
+    /* 0x12 */ s16 height;
+    /* 0x14 */ u16 lastFrame;
+    /* 0x16 */ char pad_16[2];
+    /* 0x18 */ Gfx gfx[WINDOW_BOX_CACHE_GFX];
+} WindowBoxCacheEntry; // size = 0x298
+
 Window gWindows[64];
 
+// One set per display context, so an entry is only rewritten once the display list that last used it has been drawn.
+// Windows share slots, but an entry already emitted this frame is never rewritten.
+BSS WindowBoxCacheEntry WindowBoxCache[2][WINDOW_BOX_CACHE_SLOTS];
+
 WindowStyle gWindowStyles[64] = {
     { WINDOW_STYLE_3 }, { WINDOW_STYLE_3 }, { WINDOW_STYLE_11 }, { WINDOW_STYLE_12 },
     { WINDOW_STYLE_13 }, { WINDOW_STYLE_14 }, { WINDOW_STYLE_3 }, { WINDOW_STYLE_21 },
@@ -138,6 +163,11 @@ void clear_windows(void) {
     for (i = 0; i < ARRAY_COUNT(gWindows); i++) {
         gWindows[i].flags = 0;
     }
+
+    for (i = 0; i < WINDOW_BOX_CACHE_SLOTS; i++) {
+        WindowBoxCache[0][i].valid = FALSE;
+        WindowBoxCache[1][i].valid = FALSE;
+    }
 }
 
 void update_windows(void) {
@@ -214,6 +244,60 @@ void unused_main_menu_window_darkening(s32 windowID, s32* flags, s32* posX, s32*
     }
 }
 
+// Draws the frame of a window that is not rotated or scaled, replaying the commands from the last time it was drawn
+// the same way. Returns TRUE if the box is offscreen, like draw_box.
+b32 draw_cached_window_box(s32 windowID, s32 flags, WindowStyle style, s32 posX, s32 posY, s32 width, s32 height,
+                           u8 opacity, u8 darkening) {
+    WindowBoxCacheEntry* entry = &WindowBoxCache[gCurrentDisplayContextIndex][windowID % WINDOW_BOX_CACHE_SLOTS];
+    Gfx* start;
+    Gfx* end;
+    s32 numGfx;
+
+    if (entry->valid && entry->windowID == windowID && entry->flags == flags
+        && entry->style.customStyle == style.customStyle
+        && entry->posX == posX && entry->posY == posY && entry->width == width && entry->height == height
+        && entry->opacity == opacity && entry->darkening == darkening
+    ) {
+        entry->lastFrame = gGameStatusPtr->frameCounter;
+        gSPDisplayList(gMainGfxPos++, entry->gfx);
+        return FALSE;
+    }
+
+    if (entry->valid && entry->lastFrame == gGameStatusPtr->frameCounter) {
+        // still referenced by a window drawn earlier this frame
+        return draw_box(flags, style, posX, posY, 0, width, height, opacity, darkening, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f,
+                        NULL, NULL, NULL, 0, 0, NULL);
+    }
+
+    entry->valid = FALSE;
+    start = gMainGfxPos;
+    if (draw_box(flags, style, posX, posY, 0, width, height, opacity, darkening, 1.0f, 1.0f, 0.0f, 0.0f, 0.0f,
+                 NULL, NULL, NULL, 0, 0, NULL)) {
+        return TRUE;
+    }
+
+    // keep room for the end command
+    numGfx = gMainGfxPos - start;
+    if (numGfx < ARRAY_COUNT(entry->gfx)) {
+        bcopy(start, entry->gfx, numGfx * sizeof(Gfx));
+        end = &entry->gfx[numGfx];
+        gSPEndDisplayList(end);
+
+        entry->valid = TRUE;
+        entry->lastFrame = gGameStatusPtr->frameCounter;
+        entry->windowID = windowID;
+        entry->flags = flags;
+        entry->style = style;
+        entry->posX = posX;
+        entry->posY = posY;
+        entry->width = width;
+        entry->height = height;
+        entry->opacity = opacity;
+        entry->darkening = darkening;
+    }
+    return FALSE;
+}
+
 void render_windows(s32* windowsArray, s32 parent, s32 flags, s32 baseX, s32 baseY, s32 opacity, s32 darkening, f32 (*rotScaleMtx)[4]) {
     Window* window;
     Window* childWindow;
@@ -227,6 +311,7 @@ void render_windows(s32* windowsArray, s32 parent, s32 flags, s32 baseX, s32 bas
     f32 scaleX, scaleY, rotX, rotY, rotZ;
     s32 childDarkening, childOpacity;
     s32 boxFlags;
+    b32 boxOffscreen;
     s32 boxTranslateX;
     s32 boxTranslateY;
     s32 fpUpdateIdx;
@@ -330,9 +415,21 @@ void render_windows(s32* windowsArray, s32 parent, s32 flags, s32 baseX, s32 bas
             boxFlags |= DRAW_FLAG_ANIMATED_BACKGROUND;
         }
 
-        if (draw_box(boxFlags, windowStyle, posX, posY, posZ, width, height, childOpacity, childDarkening,
-                    scaleX, scaleY, rotX, rotY, rotZ, fpDrawContents, drawContentsArg0, rotScaleMtx,
-                    boxTranslateX, boxTranslateY, outMtx) == 0) {
+        if (!(boxFlags & (DRAW_FLAG_ROTSCALE | DRAW_FLAG_ANIMATED_BACKGROUND))) {
+            // only the frame is cached, contents are drawn every time
+            boxOffscreen = draw_cached_window_box(childWindowID, boxFlags, windowStyle, posX, posY, width, height,
+                                                  childOpacity, childDarkening);
+            if (!boxOffscreen && fpDrawContents != NULL) {
+                ((void (*)(s32, s32, s32, s32, s32, s32, s32)) fpDrawContents)((s32) drawContentsArg0, posX, posY,
+                    width, height, (u8) childOpacity, (u8) childDarkening);
+            }
+        } else {
+            boxOffscreen = draw_box(boxFlags, windowStyle, posX, posY, posZ, width, height, childOpacity,
+                                    childDarkening, scaleX, scaleY, rotX, rotY, rotZ, fpDrawContents,
+                                    drawContentsArg0, rotScaleMtx, boxTranslateX, boxTranslateY, outMtx);
+        }
+
+        if (!boxOffscreen) {
             if (childFlags == 0 && rotScaleMtx == 0) {
                 outMtx = NULL;
             }
@@ -0,0 +1,42 @@
+#ifndef _AUDIO_HOST_H_
+#define _AUDIO_HOST_H_
+
+// Interface between main.c, which only sees the host C library, and the files built against the engine headers.
+// Plain C types only: the engine headers redefine the libultra types and lay out their structs big-endian.
+
+// --- engine side (host_os.c, host_rom.c, rsp.c) ---
+
+/// Byte-swaps the words of the SBN image which the engine reads through plain integer pointers, maps it at
+/// ROM address 0 and runs create_audio_system. Returns 0 on success.
+int audio_host_init(unsigned char* rom, unsigned int romSize);
+
+/// Sample rate of the output, as returned by osAiSetFrequency. Valid after audio_host_init.
+int audio_host_output_rate(void);
+
+/// Runs the audio manager thread for the given number of retraces (60 per second).
+/// The song is loaded and started ahead of the first retrace. Returns 0 on success.
+int audio_host_run(int songID, int variation, int numRetraces);
+
+/// Byte-swaps the words of the image which the engine reads through plain integer pointers (host_rom.c).
+int audio_host_prepare_rom(unsigned char* rom, unsigned int romSize);
+
+/// Runs an audio command list the way the n_aspMain microcode would, with the engine's RDRAM as memory.
+void audio_host_rsp_run(const void* cmdList, unsigned int size);
+
+// --- host side (main.c) ---
+
+/// Receives every buffer the engine passes to osAiSetNextBuffer: big-endian interleaved stereo s16 samples.
+void host_output(const unsigned char* data, unsigned int size);
+
+/// Called for each audio frame with the time alAudioFrame took to build it, in nanoseconds.
+void host_frame_built(long long cpuTime);
+
+/// Called for each command list with the time the RSP stand-in took to run it, in nanoseconds.
+void host_task_done(long long rspTime);
+
+/// CPU time used by the calling thread, in nanoseconds.
+long long host_clock(void);
+
+void host_error(const char* message);
+
+#endif
@@ -0,0 +1,234 @@
+// Stand-ins for the libultra and nusys services used by the audio engine, built with the engine headers.
+// The audio manager thread runs on the caller's stack: each retrace message is handed out by osRecvMesg,
+// and audio tasks sent to the scheduler are run at once by the RSP stand-in.
+
+// system headers keep the host layout, <string.h> is left out as it clashes with libultra's bcopy
+#pragma scalar_storage_order default
+#include <setjmp.h>
+#include <stdint.h>
+#pragma scalar_storage_order big-endian
+
+#include "common.h"
+#include "nu/nusys.h"
+#include "audio.h"
+#include "audio/private.h"
+#include "chaos.h"
+#include "dx/profiling.h"
+#include "audio_host.h"
+
+// the engine stores RDRAM addresses in 24-bit command fields and in s32 variables
+#define HOST_RDRAM_LIMIT 0x1000000
+
+u8 AuHeapBase[AUDIO_HEAP_SIZE] ALIGNED(16);
+NUSched nusched;
+OSPiHandle* nuPiCartHandle;
+ChaosStatus chaosStatus;
+
+extern u16 DummyInstrumentPredictor[32];
+u64 n_aspMain_text_bin[1];
+u64 n_aspMain_data_bin[1];
+
+static u8* HostRom;
+static u32 HostRomSize;
+static OSMesgQueue* HostRetraceQueue;
+static void (*HostAudioThreadEntry)(void*);
+static NUScMsg HostRetraceMsg = NU_SC_RETRACE_MSG;
+static s32 HostRetraceCount;
+static s32 HostNumRetraces;
+static s32 HostSongID;
+static s32 HostSongVariation;
+static s32 HostOutputRate;
+static s32 HostAiQueuedSamples;
+static s64 HostFrameStart;
+static u32 HostRandState;
+static jmp_buf HostExit;
+
+static void host_read_rom(u32 romAddr, void* dest, u32 size) {
+    u32 avail = 0;
+
+    if (romAddr < HostRomSize) {
+        avail = MIN(size, HostRomSize - romAddr);
+        __builtin_memcpy(dest, &HostRom[romAddr], avail);
+    }
+    // sample streaming reads whole DMA buffers, which may run past the end of the image
+    __builtin_memset((u8*)dest + avail, 0, size - avail);
+}
+
+static void host_start_song(void) {
+    s32 songName = au_song_load(HostSongID, 0);
+
+    if ((u32)songName <= 0xFFFF) {
+        host_error("song could not be loaded");
+        longjmp(HostExit, 2);
+    }
+    au_song_start_variation(songName, HostSongVariation);
+}
+
+int audio_host_init(unsigned char* rom, unsigned int romSize) {
+    s32 i;
+
+    if ((uintptr_t)&AuHeapBase[AUDIO_HEAP_SIZE] > HOST_RDRAM_LIMIT) {
+        host_error("audio heap lies above 16 MB, the harness must be linked without PIE");
+        return 1;
+    }
+
+    HostRom = rom;
+    HostRomSize = romSize;
+    if (audio_host_prepare_rom(rom, romSize) != 0) {
+        return 1;
+    }
+
+    // the RSP reads this codebook as big-endian data, but as a plain array it was laid out in host order
+    for (i = 0; i < ARRAY_COUNT(DummyInstrumentPredictor); i++) {
+        u16 value = DummyInstrumentPredictor[i];
+
+        ((u8*)DummyInstrumentPredictor)[i * 2] = value >> 8;
+        ((u8*)DummyInstrumentPredictor)[i * 2 + 1] = value;
+    }
+
+    nusched.retraceCount = 1;
+    create_audio_system();
+    return 0;
+}
+
+int audio_host_output_rate(void) {
+    return HostOutputRate;
+}
+
+int audio_host_run(int songID, int variation, int numRetraces) {
+    HostSongID = songID;
+    HostSongVariation = variation;
+    HostNumRetraces = numRetraces;
+    HostRetraceCount = 0;
+
+    if (setjmp(HostExit) == 0) {
+        HostAudioThreadEntry(NULL);
+    }
+    return HostRetraceCount == HostNumRetraces ? 0 : 1;
+}
+
+// --- libultra ---
+
+void osCreateThread(OSThread* thread, OSId id, void (*entry)(void*), void* arg, void* sp, OSPri pri) {
+    HostAudioThreadEntry = entry;
+}
+
+void osStartThread(OSThread* thread) {
+}
+
+void osCreateMesgQueue(OSMesgQueue* mq, OSMesg* msg, s32 count) {
+    mq->validCount = 0;
+    mq->first = 0;
+    mq->msgCount = count;
+    mq->msg = msg;
+}
+
+s32 osSendMesg(OSMesgQueue* mq, OSMesg msg, s32 flag) {
+    if (mq == &nusched.audioRequestMQ) {
+        NUScTask* task = msg;
+        s64 start = host_clock();
+
+        audio_host_rsp_run(task->list.t.data_ptr, task->list.t.data_size);
+        host_task_done(host_clock() - start);
+    }
+    return 0;
+}
+
+s32 osRecvMesg(OSMesgQueue* mq, OSMesg* msg, s32 flag) {
+    if (mq != HostRetraceQueue) {
+        // task completion, already done by the time osSendMesg returned
+        return 0;
+    }
+
+    if (HostRetraceCount == HostNumRetraces) {
+        longjmp(HostExit, 1);
+    }
+    if (HostRetraceCount == 0) {
+        host_start_song();
+    }
+    HostRetraceCount++;
+
+    // the AI plays out one retrace worth of samples
+    HostAiQueuedSamples -= ((s64)HostRetraceCount * HostOutputRate) / 60
+        - ((s64)(HostRetraceCount - 1) * HostOutputRate) / 60;
+    if (HostAiQueuedSamples < 0) {
+        HostAiQueuedSamples = 0;
+    }
+
+    *msg = &HostRetraceMsg;
+    return 0;
+}
+
+OSIntMask osSetIntMask(OSIntMask mask) {
+    return OS_IM_ALL;
+}
+
+u32 osVirtualToPhysical(void* addr) {
+    return (u32)(uintptr_t)addr;
+}
+
+s32 osAiSetFrequency(u32 frequency) {
+    // the DAC runs at the NTSC video clock divided by an integer, as on hardware
+    u32 dacRate = (u32)((f32)VI_NTSC_CLOCK / frequency + 0.5f);
+
+    HostOutputRate = VI_NTSC_CLOCK / dacRate;
+    return HostOutputRate;
+}
+
+u32 osAiGetStatus(void) {
+    return 0;
+}
+
+u32 osAiGetLength(void) {
+    return HostAiQueuedSamples * 4;
+}
+
+s32 osAiSetNextBuffer(void* buf, u32 size) {
+    host_output(buf, size);
+    HostAiQueuedSamples += size / 4;
+    return 0;
+}
+
+s32 osEPiStartDma(OSPiHandle* handle, OSIoMesg* mb, s32 direction) {
+    // completes at once, nothing waits on the return queue
+    host_read_rom(mb->devAddr, mb->dramAddr, mb->size);
+    return 0;
+}
+
+// --- nusys ---
+
+void nuPiReadRom(u32 rom_addr, void* buf_ptr, u32 size) {
+    host_read_rom(rom_addr, buf_ptr, size);
+}
+
+void nuScAddClient(NUScClient* c, OSMesgQueue* mq, NUScMsg msgType) {
+    HostRetraceQueue = mq;
+}
+
+// --- game ---
+
+s32 rand_int(s32 max) {
+    if (max < 0) {
+        max = -max;
+    }
+    // fixed seed, so renders are reproducible
+    HostRandState = HostRandState * 1103515245 + 12345;
+    return ((HostRandState >> 16) & 0x7FFF) % (max + 1);
+}
+
+void profiler_audio_started(void) {
+    HostFrameStart = host_clock();
+}
+
+void profiler_audio_completed(void) {
+    host_frame_built(host_clock() - HostFrameStart);
+}
+
+void profiler_audio_counter_update(enum ProfilerCounter which, u32 count) {
+}
+
+void profiler_rsp_started(enum ProfilerRSPTime which) {
+}
+
+void profiler_rsp_completed(enum ProfilerRSPTime which) {
+}
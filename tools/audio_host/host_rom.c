@@ -0,0 +1,272 @@
+// Host side handling of the SBN image. The engine headers are compiled with big-endian struct layout, so file
+// data read through struct fields needs no conversion. What remains is done here:
+//  - words the engine reads through plain integer pointers are swapped to host order before the image is used
+//  - au_load_BK_to_bank is replaced, since a BK instrument record no longer matches the host Instrument struct
+
+// system headers keep the host layout, <string.h> is left out as it clashes with libultra's bcopy
+#pragma scalar_storage_order default
+#include <stdint.h>
+#include <stdlib.h>
+#pragma scalar_storage_order big-endian
+
+#include "common.h"
+#include "audio.h"
+#include "audio/private.h"
+#include "audio_host.h"
+
+#define AL_HEADER_SIG_BK 0x424B
+#define AL_HEADER_SIG_CR 0x4352
+
+#define HOST_MAX_INSTRUMENT_GROUPS 96
+
+// BK instrument record, as Instrument is laid out on the N64
+typedef struct BKInstrument {
+    /* 0x00 */ u32 base;
+    /* 0x04 */ u32 wavDataLength;
+    /* 0x08 */ u32 loopPredictor;
+    /* 0x0C */ s32 loopStart;
+    /* 0x10 */ s32 loopEnd;
+    /* 0x14 */ s32 loopCount;
+    /* 0x18 */ u32 predictor;
+    /* 0x1C */ u16 dc_bookSize;
+    /* 0x1E */ u16 keyBase;
+    /* 0x20 */ s32 outputRate;
+    /* 0x24 */ u8 type;
+    /* 0x25 */ u8 unk_25;
+    /* 0x26 */ s8 unk_26;
+    /* 0x27 */ s8 unk_27;
+    /* 0x28 */ s8 unk_28;
+    /* 0x29 */ s8 unk_29;
+    /* 0x2A */ s8 unk_2A;
+    /* 0x2B */ s8 unk_2B;
+    /* 0x2C */ u32 envelopes;
+} BKInstrument; // size = 0x30
+
+// instruments unpacked from the banks loaded into each group
+typedef struct HostInstrumentGroup {
+    InstrumentGroup* group;
+    Instrument instruments[16];
+} HostInstrumentGroup;
+
+static HostInstrumentGroup HostInstrumentGroups[HOST_MAX_INSTRUMENT_GROUPS];
+static s32 HostNumInstrumentGroups;
+
+static u8* HostImage;
+static u32 HostImageSize;
+// one flag per halfword of the image which has already been swapped
+static u8* HostSwapped;
+
+static u32 host_read_be32(u32 pos) {
+    u8* p = &HostImage[pos];
+
+    return (p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+static void host_swap16(u32 pos) {
+    u16 value;
+
+    if (pos + 2 > HostImageSize || HostSwapped[pos >> 1]) {
+        return;
+    }
+    value = (HostImage[pos] << 8) | HostImage[pos + 1];
+    __builtin_memcpy(&HostImage[pos], &value, sizeof(value));
+    HostSwapped[pos >> 1] = TRUE;
+}
+
+/// Swaps the word at pos unless that was done already, and returns its value.
+static u32 host_swap32(u32 pos) {
+    u32 value;
+
+    if (HostSwapped[pos >> 1]) {
+        __builtin_memcpy(&value, &HostImage[pos], sizeof(value));
+        return value;
+    }
+    value = host_read_be32(pos);
+    __builtin_memcpy(&HostImage[pos], &value, sizeof(value));
+    HostSwapped[pos >> 1] = TRUE;
+    HostSwapped[(pos >> 1) + 1] = TRUE;
+    return value;
+}
+
+// Segments are lists of commands read as u32 by au_bgm_player_read_segment, each ending with a zero word.
+// Subsegment commands point to a table of 16 track words read by au_bgm_load_subsegment.
+static void host_prepare_BGM(u32 fileStart) {
+    BGMHeader header;
+    u32 segStart, fileEnd, pos, list, cmd;
+    s32 i, j;
+
+    if (fileStart + sizeof(header) > HostImageSize) {
+        return;
+    }
+    __builtin_memcpy(&header, &HostImage[fileStart], sizeof(header));
+    fileEnd = MIN(fileStart + header.size, HostImageSize);
+
+    for (i = 0; i < ARRAY_COUNT(header.info.segments); i++) {
+        if (header.info.segments[i] == 0) {
+            continue;
+        }
+        segStart = fileStart + (header.info.segments[i] << 2);
+
+        for (pos = segStart; pos + 4 <= fileEnd; pos += 4) {
+            cmd = host_swap32(pos);
+            if (cmd == 0) {
+                break;
+            }
+            if ((cmd >> 12) == (BGM_SEGMENT_SUBSEG << 16)) {
+                list = segStart + ((cmd & 0xFFFF) << 2);
+                if (list + 16 * 4 > fileEnd) {
+                    continue;
+                }
+                for (j = 0; j < 16; j++) {
+                    host_swap32(list + j * 4);
+                }
+            }
+        }
+    }
+}
+
+int audio_host_prepare_rom(unsigned char* rom, unsigned int romSize) {
+    SBNHeader sbnHeader;
+    SBNFileEntry entry;
+    INITHeader initHeader;
+    u32 pos, fileStart;
+    s32 i;
+
+    HostImage = rom;
+    HostImageSize = romSize;
+    HostSwapped = calloc(romSize / 2 + 2, 1);
+    if (HostSwapped == NULL) {
+        host_error("out of memory");
+        return 1;
+    }
+
+    if (romSize < sizeof(sbnHeader)) {
+        host_error("file is too small to be an SBN");
+        return 1;
+    }
+    __builtin_memcpy(&sbnHeader, rom, sizeof(sbnHeader));
+    if (sbnHeader.mdata.signature != 0x53424E20 || sbnHeader.tableOffset + sbnHeader.numEntries * sizeof(entry) > romSize) {
+        host_error("not an SBN file");
+        return 1;
+    }
+
+    for (i = 0; i < sbnHeader.numEntries; i++) {
+        __builtin_memcpy(&entry, &rom[sbnHeader.tableOffset + i * sizeof(entry)], sizeof(entry));
+        fileStart = entry.offset & 0xFFFFFF;
+        if (fileStart == 0) {
+            break;
+        }
+        if ((entry.data >> 24) == AU_FMT_BGM) {
+            host_prepare_BGM(fileStart);
+        }
+    }
+
+    // mseqFileList is read as u16
+    if (sbnHeader.INIToffset != 0 && sbnHeader.INIToffset + sizeof(initHeader) <= romSize) {
+        __builtin_memcpy(&initHeader, &rom[sbnHeader.INIToffset], sizeof(initHeader));
+        pos = sbnHeader.INIToffset + initHeader.shortsOffset;
+        for (i = 0; i < initHeader.shortsSize; i += 2) {
+            host_swap16(pos + i);
+        }
+    }
+
+    return 0;
+}
+
+static Instrument* host_get_instrument_storage(InstrumentGroup* group) {
+    s32 i;
+
+    for (i = 0; i < HostNumInstrumentGroups; i++) {
+        if (HostInstrumentGroups[i].group == group) {
+            return HostInstrumentGroups[i].instruments;
+        }
+    }
+
+    if (HostNumInstrumentGroups == ARRAY_COUNT(HostInstrumentGroups)) {
+        host_error("too many instrument groups");
+        exit(1);
+    }
+    HostInstrumentGroups[HostNumInstrumentGroups].group = group;
+    return HostInstrumentGroups[HostNumInstrumentGroups++].instruments;
+}
+
+// same conversion as au_swizzle_BK_instruments, into a host Instrument
+static void host_unpack_instrument(Instrument* instrument, BKInstrument* record, SoundBank* bank, s32 bkFileOffset) {
+    f32 outputRate = gSoundGlobals->outputRate;
+
+    instrument->base = record->base != 0 ? (u8*)(uintptr_t)(record->base + bkFileOffset) : NULL;
+    instrument->wavDataLength = record->wavDataLength;
+    instrument->loopPredictor = record->loopPredictor != 0 ? AU_FILE_RELATIVE(bank, record->loopPredictor) : NULL;
+    instrument->loopStart = record->loopStart;
+    instrument->loopEnd = record->loopEnd;
+    instrument->loopCount = record->loopCount;
+    instrument->predictor = record->predictor != 0 ? AU_FILE_RELATIVE(bank, record->predictor) : NULL;
+    instrument->dc_bookSize = record->dc_bookSize;
+    instrument->keyBase = record->keyBase;
+    instrument->pitchRatio = record->outputRate / outputRate;
+    instrument->type = record->type;
+    instrument->unk_25 = 1;
+    instrument->unk_26 = record->unk_26;
+    instrument->unk_27 = record->unk_27;
+    instrument->unk_28 = record->unk_28;
+    instrument->unk_29 = record->unk_29;
+    instrument->unk_2A = record->unk_2A;
+    instrument->unk_2B = record->unk_2B;
+    instrument->envelopes = record->envelopes != 0 ? AU_FILE_RELATIVE(bank, record->envelopes) : NULL;
+}
+
+// Replaces the engine's version, which is made a weak symbol when the harness is linked.
+// Only 'CR' banks are handled, like the original.
+SoundBank* au_load_BK_to_bank(s32 bkFileOffset, SoundBank* bank, s32 bankIndex, s32 bankGroup) {
+    ALHeap* heap = gSynDriverPtr->heap;
+    BKHeader header;
+    InstrumentGroup* group;
+    Instrument* instruments;
+    s32 instrumentCount;
+    s32 size;
+    u32 i;
+
+    au_read_rom(bkFileOffset, &header, sizeof(header));
+    if (header.signature != AL_HEADER_SIG_BK || header.size == 0 || header.format != AL_HEADER_SIG_CR) {
+        return bank;
+    }
+
+    size = ALIGN16_(header.instrumetsSize)
+        + ALIGN16_(header.unkSizeA)
+        + ALIGN16_(header.predictorsSize)
+        + ALIGN16_(header.unkSizeB)
+        + sizeof(header);
+    if (bank == NULL) {
+        bank = alHeapAlloc(heap, 1, size);
+    }
+    au_read_rom(bkFileOffset, bank, size);
+
+    group = au_get_BK_instruments(bankGroup, bankIndex);
+    if (group == NULL) {
+        host_error("bank loaded into an unknown instrument group");
+        return bank;
+    }
+    instruments = host_get_instrument_storage(group);
+    instrumentCount = 0;
+
+    for (i = 0; i < ARRAY_COUNT(header.instruments); i++) {
+        if (header.instruments[i] != 0) {
+            instrumentCount++;
+        }
+    }
+
+    for (i = 0; i < ARRAY_COUNT(header.instruments); i++) {
+        u16 instOffset = header.instruments[i];
+
+        if (instOffset == 0) {
+            // the original only replaces missing instruments while swizzling a bank which has any
+            (*group)[i] = instrumentCount != 0 ? gSoundGlobals->defaultInstrument : NULL;
+        } else {
+            host_unpack_instrument(&instruments[i], AU_FILE_RELATIVE(bank, instOffset), bank, bkFileOffset);
+            (*group)[i] = &instruments[i];
+        }
+    }
+
+    bank->swizzled = 1;
+    return bank;
+}
@@ -0,0 +1,41 @@
+#ifndef _ULTRATYPES_H_
+#define _ULTRATYPES_H_
+
+// Host stand-in for include/PR/ultratypes.h: the original types s32 and u32 as long, which is 64 bits wide here.
+
+typedef unsigned char           u8;
+typedef unsigned short          u16;
+typedef unsigned int            u32;
+typedef unsigned long long      u64;
+
+typedef signed char             s8;
+typedef short                   s16;
+typedef int                     s32;
+typedef long long               s64;
+
+typedef volatile unsigned char      vu8;
+typedef volatile unsigned short     vu16;
+typedef volatile unsigned int       vu32;
+typedef volatile unsigned long long vu64;
+
+typedef volatile signed char    vs8;
+typedef volatile short          vs16;
+typedef volatile int            vs32;
+typedef volatile long long      vs64;
+
+typedef float                   f32;
+typedef double                  f64;
+
+#ifndef TRUE
+#define TRUE    1
+#endif
+
+#ifndef FALSE
+#define FALSE   0
+#endif
+
+#ifndef NULL
+#define NULL    0
+#endif
+
+#endif // _ULTRATYPES_H_
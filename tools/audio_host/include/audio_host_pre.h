@@ -0,0 +1,15 @@
+#ifndef _AUDIO_HOST_PRE_H_
+#define _AUDIO_HOST_PRE_H_
+
+// Included ahead of every engine file in the host build.
+
+// the libc headers under include/ would otherwise declare a 32-bit size_t
+#define _SIZE_T_DEF
+typedef __SIZE_TYPE__ size_t;
+
+// Lay out every struct the engine declares big-endian, as on the N64. Sound files are read straight into these
+// structs and command lists are handed to the RSP as they are built, so both keep their N64 byte order.
+// Pointers are unaffected and stay 64 bits wide.
+#pragma scalar_storage_order big-endian
+
+#endif
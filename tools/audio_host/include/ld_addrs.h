@@ -0,0 +1,7 @@
+#ifndef _LD_ADDRS_H_
+#define _LD_ADDRS_H_
+
+// Host stand-in for the generated linker address header. The harness maps the SBN image at ROM address 0.
+#define audio_ROM_START 0
+
+#endif
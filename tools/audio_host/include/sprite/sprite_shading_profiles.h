@@ -0,0 +1 @@
+// Host stand-in for a header generated from assets, the audio engine uses nothing from it.
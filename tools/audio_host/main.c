@@ -0,0 +1,182 @@
+// Renders a song from an SBN file to a WAV file, running the audio engine on the host.
+// Reports the CPU time alAudioFrame takes per audio frame and the time of the RSP stand-in per command list.
+// Host timings only show relative costs: the engine is compiled for the host CPU, not the VR4300.
+//
+// usage: audio_host <sound.sbn> <out.wav> <songID> [variation] [seconds]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "audio_host.h"
+
+typedef struct TimeStats {
+    long long count;
+    long long total;
+    long long max;
+} TimeStats;
+
+static unsigned char* Output;
+static unsigned int OutputSize;
+static unsigned int OutputCapacity;
+static TimeStats FrameStats;
+static TimeStats TaskStats;
+
+static void stats_add(TimeStats* stats, long long time) {
+    stats->count++;
+    stats->total += time;
+    if (time > stats->max) {
+        stats->max = time;
+    }
+}
+
+static void stats_print(const char* name, TimeStats* stats) {
+    if (stats->count == 0) {
+        printf("%-28s none\n", name);
+        return;
+    }
+    printf("%-28s %lld, mean %.1f us, max %.1f us\n", name, stats->count,
+        stats->total / (double)stats->count / 1000.0, stats->max / 1000.0);
+}
+
+void host_output(const unsigned char* data, unsigned int size) {
+    if (OutputSize + size > OutputCapacity) {
+        OutputCapacity = (OutputSize + size) * 2;
+        Output = realloc(Output, OutputCapacity);
+        if (Output == NULL) {
+            host_error("out of memory");
+            exit(1);
+        }
+    }
+    memcpy(&Output[OutputSize], data, size);
+    OutputSize += size;
+}
+
+void host_frame_built(long long cpuTime) {
+    stats_add(&FrameStats, cpuTime);
+}
+
+void host_task_done(long long rspTime) {
+    stats_add(&TaskStats, rspTime);
+}
+
+long long host_clock(void) {
+    struct timespec ts;
+
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+void host_error(const char* message) {
+    fprintf(stderr, "audio_host: %s\n", message);
+}
+
+static unsigned char* read_file(const char* path, unsigned int* size) {
+    FILE* file = fopen(path, "rb");
+    unsigned char* data;
+    long length;
+
+    if (file == NULL) {
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    data = malloc(length > 0 ? length : 1);
+    if (data != NULL && fread(data, 1, length, file) != (size_t)length) {
+        free(data);
+        data = NULL;
+    }
+    fclose(file);
+    *size = length;
+    return data;
+}
+
+static void put_le(unsigned char* p, unsigned int value, int size) {
+    int i;
+
+    for (i = 0; i < size; i++) {
+        p[i] = value >> (i * 8);
+    }
+}
+
+// the AI buffers hold big-endian interleaved stereo, WAV wants little-endian
+static int write_wav(const char* path, unsigned int sampleRate) {
+    unsigned char header[44];
+    FILE* file = fopen(path, "wb");
+    unsigned int i;
+
+    if (file == NULL) {
+        return 1;
+    }
+
+    memcpy(&header[0], "RIFF", 4);
+    put_le(&header[4], 36 + OutputSize, 4);
+    memcpy(&header[8], "WAVEfmt ", 8);
+    put_le(&header[16], 16, 4);
+    put_le(&header[20], 1, 2);
+    put_le(&header[22], 2, 2);
+    put_le(&header[24], sampleRate, 4);
+    put_le(&header[28], sampleRate * 4, 4);
+    put_le(&header[32], 4, 2);
+    put_le(&header[34], 16, 2);
+    memcpy(&header[36], "data", 4);
+    put_le(&header[40], OutputSize, 4);
+
+    for (i = 0; i + 1 < OutputSize; i += 2) {
+        unsigned char hi = Output[i];
+
+        Output[i] = Output[i + 1];
+        Output[i + 1] = hi;
+    }
+
+    fwrite(header, 1, sizeof(header), file);
+    fwrite(Output, 1, OutputSize, file);
+    return fclose(file) != 0;
+}
+
+int main(int argc, char** argv) {
+    unsigned char* rom;
+    unsigned int romSize;
+    int songID, variation, numRetraces, sampleRate, result;
+
+    if (argc < 4) {
+        fprintf(stderr, "usage: %s <sound.sbn> <out.wav> <songID> [variation] [seconds]\n", argv[0]);
+        return 1;
+    }
+    songID = strtol(argv[3], NULL, 0);
+    variation = argc > 4 ? strtol(argv[4], NULL, 0) : 0;
+    numRetraces = (argc > 5 ? atof(argv[5]) : 30.0) * 60.0;
+
+    rom = read_file(argv[1], &romSize);
+    if (rom == NULL) {
+        fprintf(stderr, "audio_host: could not read %s\n", argv[1]);
+        return 1;
+    }
+    if (audio_host_init(rom, romSize) != 0) {
+        return 1;
+    }
+
+    sampleRate = audio_host_output_rate();
+    OutputCapacity = (unsigned int)(numRetraces + 60) * (sampleRate / 60 + 1) * 4;
+    Output = malloc(OutputCapacity);
+    if (Output == NULL) {
+        host_error("out of memory");
+        return 1;
+    }
+
+    result = audio_host_run(songID, variation, numRetraces);
+
+    if (write_wav(argv[2], sampleRate) != 0) {
+        fprintf(stderr, "audio_host: could not write %s\n", argv[2]);
+        return 1;
+    }
+
+    printf("song 0x%X variation %d, %d retraces, %u samples at %d Hz\n", songID, variation, numRetraces,
+        OutputSize / 4, sampleRate);
+    stats_print("audio frames built:", &FrameStats);
+    stats_print("command lists run (RSP):", &TaskStats);
+    return result;
+}
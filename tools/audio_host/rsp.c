@@ -0,0 +1,447 @@
+// Stand-in for the n_aspMain audio microcode: runs a command list built by alAudioFrame on the host.
+// DMEM addresses are relative to the start of the microcode's sample buffers, as the engine emits them.
+// Sample data in RDRAM and DMEM is big-endian, as on the console.
+//
+// The command semantics follow the published behaviour of the microcode. Two parts are approximations:
+//  - RESAMPLE interpolates with Catmull-Rom weights instead of the microcode's coefficient table,
+//    which is not part of this repository. Pitch stepping and the saved state follow the microcode.
+//  - POLEF only implements the two-pole filter; the IIR variant is never selected by the engine.
+// Output has not been compared against hardware.
+
+#include <stdint.h>
+#include <string.h>
+
+#include "audio_host.h"
+
+enum {
+    A_SPNOOP        = 0,
+    A_ADPCM         = 1,
+    A_CLEARBUFF     = 2,
+    A_ENVMIXER      = 3,
+    A_LOADBUFF      = 4,
+    A_RESAMPLE      = 5,
+    A_SAVEBUFF      = 6,
+    A_SETVOL        = 9,
+    A_DMEMMOVE      = 10,
+    A_LOADADPCM     = 11,
+    A_MIXER         = 12,
+    A_INTERLEAVE    = 13,
+    A_POLEF         = 14,
+    A_SETLOOP       = 15,
+};
+
+#define A_INIT  0x01
+#define A_LOOP  0x02
+#define A_LEFT  0x02
+#define A_VOL   0x04
+
+// fixed buffer layout used by the microcode for each frame of 184 samples
+#define N_COUNT         0x170
+#define N_MAIN          0x000
+#define N_MAIN2         0x170
+#define N_DRY_LEFT      0x4E0
+#define N_DRY_RIGHT     0x650
+#define N_WET_LEFT      0x7C0
+#define N_WET_RIGHT     0x930
+
+#define DMEM_SIZE 0x1000
+
+typedef struct RspRamp {
+    int32_t value;
+    int32_t target;
+    int32_t step;
+} RspRamp;
+
+// private ENVMIXER state, kept in the engine's state buffer (80 bytes)
+typedef struct RspEnvMixState {
+    int16_t wet;
+    int16_t dry;
+    RspRamp ramps[2];
+} RspEnvMixState;
+
+static uint8_t Dmem[DMEM_SIZE + 0x1000];
+static int16_t AdpcmTable[128];
+static uint32_t LoopAddress;
+static int16_t EnvVolume[2];
+static int16_t EnvTarget[2];
+static int32_t EnvRate[2];
+static int16_t EnvDry;
+static int16_t EnvWet;
+static int16_t ResampleTable[64][4];
+static int ResampleTableReady;
+
+static uint8_t* rdram(uint32_t addr) {
+    return (uint8_t*)(uintptr_t)(addr & 0xFFFFFF);
+}
+
+static int16_t clamp16(int32_t x) {
+    if (x < -0x8000) {
+        return -0x8000;
+    }
+    if (x > 0x7FFF) {
+        return 0x7FFF;
+    }
+    return x;
+}
+
+static int16_t load16(const uint8_t* p) {
+    return (int16_t)((p[0] << 8) | p[1]);
+}
+
+static void store16(uint8_t* p, int16_t value) {
+    p[0] = (uint16_t)value >> 8;
+    p[1] = value;
+}
+
+static int16_t dmem_get(uint32_t pos) {
+    return load16(&Dmem[pos & (DMEM_SIZE - 1)]);
+}
+
+static void dmem_set(uint32_t pos, int16_t value) {
+    store16(&Dmem[pos & (DMEM_SIZE - 1)], value);
+}
+
+static uint32_t dmem_span(uint32_t dmem, uint32_t count) {
+    // DMEM is padded, so a transfer running past the buffers stays inside the array
+    dmem &= DMEM_SIZE - 1;
+    return count <= sizeof(Dmem) - dmem ? count : sizeof(Dmem) - dmem;
+}
+
+static void build_resample_table(void) {
+    int i;
+
+    for (i = 0; i < 64; i++) {
+        double t = i / 64.0;
+        double t2 = t * t;
+        double t3 = t2 * t;
+
+        ResampleTable[i][0] = (int16_t)(32768.0 * (-0.5 * t3 + t2 - 0.5 * t));
+        ResampleTable[i][1] = (int16_t)(32767.0 * (1.5 * t3 - 2.5 * t2 + 1.0));
+        ResampleTable[i][2] = (int16_t)(32767.0 * (-1.5 * t3 + 2.0 * t2 + 0.5 * t));
+        ResampleTable[i][3] = (int16_t)(32768.0 * (0.5 * t3 - 0.5 * t2));
+    }
+    ResampleTableReady = 1;
+}
+
+static void adpcm_residuals(int16_t* dst, const int16_t* src, const int16_t* book, int16_t l1, int16_t l2) {
+    const int16_t* book1 = book;
+    const int16_t* book2 = book + 8;
+    int32_t accu;
+    int i, j;
+
+    for (i = 0; i < 8; i++) {
+        accu = src[i] * (1 << 11);
+        accu += book1[i] * l1 + book2[i] * l2;
+        for (j = 0; j < i; j++) {
+            accu += book2[j] * src[i - 1 - j];
+        }
+        dst[i] = clamp16(accu >> 11);
+    }
+}
+
+static void cmd_adpcm(uint32_t w0, uint32_t w1) {
+    uint32_t address = w0 & 0xFFFFFF;
+    uint32_t flags = w1 >> 28;
+    int32_t count = (((w1 >> 16) & 0xFFF) + 0x1F) & ~0x1F;
+    uint32_t dmemi = (w1 >> 12) & 0xF;
+    uint32_t dmemo = w1 & 0xFFF;
+    int16_t lastFrame[16];
+    int16_t frame[16];
+    int i;
+
+    if (flags & A_INIT) {
+        memset(lastFrame, 0, sizeof(lastFrame));
+    } else {
+        uint8_t* src = rdram((flags & A_LOOP) ? LoopAddress : address);
+
+        for (i = 0; i < 16; i++) {
+            lastFrame[i] = load16(&src[i * 2]);
+        }
+    }
+
+    for (i = 0; i < 16; i++, dmemo += 2) {
+        dmem_set(dmemo, lastFrame[i]);
+    }
+
+    while (count > 0) {
+        uint8_t code = Dmem[dmemi++ & (DMEM_SIZE - 1)];
+        uint32_t scale = code >> 4;
+        uint32_t rshift = scale < 12 ? 12 - scale : 0;
+        const int16_t* book = &AdpcmTable[(code & 0xF) << 4];
+
+        for (i = 0; i < 8; i++) {
+            uint8_t byte = Dmem[dmemi++ & (DMEM_SIZE - 1)];
+
+            frame[i * 2] = (int16_t)((byte & 0xF0) << 8) >> rshift;
+            frame[i * 2 + 1] = (int16_t)((byte & 0x0F) << 12) >> rshift;
+        }
+
+        adpcm_residuals(&lastFrame[0], &frame[0], book, lastFrame[14], lastFrame[15]);
+        adpcm_residuals(&lastFrame[8], &frame[8], book, lastFrame[6], lastFrame[7]);
+
+        for (i = 0; i < 16; i++, dmemo += 2) {
+            dmem_set(dmemo, lastFrame[i]);
+        }
+        count -= 32;
+    }
+
+    for (i = 0; i < 16; i++) {
+        store16(rdram(address + i * 2), lastFrame[i]);
+    }
+}
+
+static void cmd_resample(uint32_t w0, uint32_t w1) {
+    uint32_t address = w0 & 0xFFFFFF;
+    uint32_t flags = w1 >> 30;
+    uint32_t pitch = ((w1 >> 14) & 0xFFFF) << 1;
+    uint32_t ipos = (((w1 >> 2) & 0xFFF) >> 1) - 4;
+    uint32_t opos = ((w1 & 3) ? N_MAIN2 : N_MAIN) >> 1;
+    uint32_t pitchAccu;
+    uint8_t* state = rdram(address);
+    int count = N_COUNT >> 1;
+    int i;
+
+    if (!ResampleTableReady) {
+        build_resample_table();
+    }
+
+    if (flags & A_INIT) {
+        for (i = 0; i < 4; i++) {
+            dmem_set((ipos + i) << 1, 0);
+        }
+        pitchAccu = 0;
+    } else {
+        for (i = 0; i < 4; i++) {
+            dmem_set((ipos + i) << 1, load16(&state[i * 2]));
+        }
+        pitchAccu = (uint16_t)load16(&state[8]);
+    }
+
+    while (count-- != 0) {
+        const int16_t* lut = ResampleTable[(pitchAccu & 0xFC00) >> 10];
+        int32_t accu = 0;
+
+        for (i = 0; i < 4; i++) {
+            accu += dmem_get((ipos + i) << 1) * lut[i];
+        }
+        dmem_set(opos++ << 1, clamp16(accu >> 15));
+
+        pitchAccu += pitch;
+        ipos += pitchAccu >> 16;
+        pitchAccu &= 0xFFFF;
+    }
+
+    for (i = 0; i < 4; i++) {
+        store16(&state[i * 2], dmem_get((ipos + i) << 1));
+    }
+    store16(&state[8], pitchAccu);
+}
+
+static int16_t ramp_step(RspRamp* ramp) {
+    int reached;
+
+    ramp->value += ramp->step;
+    reached = ramp->step <= 0 ? ramp->value <= ramp->target : ramp->value >= ramp->target;
+    if (reached) {
+        ramp->value = ramp->target;
+        ramp->step = 0;
+    }
+    return ramp->value >> 16;
+}
+
+static void cmd_envmixer(uint32_t w0, uint32_t w1) {
+    uint32_t flags = (w0 >> 16) & 0xFF;
+    uint8_t* address = rdram(w1);
+    uint32_t outputs[4] = { N_DRY_LEFT, N_DRY_RIGHT, N_WET_LEFT, N_WET_RIGHT };
+    RspEnvMixState state;
+    int32_t gains[4];
+    int n, k;
+
+    EnvVolume[1] = w0;
+
+    if (flags & A_INIT) {
+        state.wet = EnvWet;
+        state.dry = EnvDry;
+        for (k = 0; k < 2; k++) {
+            state.ramps[k].value = (int32_t)((uint32_t)EnvVolume[k] << 16);
+            state.ramps[k].target = (int32_t)((uint32_t)EnvTarget[k] << 16);
+            state.ramps[k].step = EnvRate[k] / 8;
+        }
+    } else {
+        memcpy(&state, address, sizeof(state));
+    }
+
+    for (n = 0; n < N_COUNT >> 1; n++) {
+        int16_t in = dmem_get(N_MAIN + n * 2);
+        int16_t left = ramp_step(&state.ramps[0]);
+        int16_t right = ramp_step(&state.ramps[1]);
+
+        gains[0] = clamp16((left * state.dry + 0x4000) >> 15);
+        gains[1] = clamp16((right * state.dry + 0x4000) >> 15);
+        gains[2] = clamp16((left * state.wet + 0x4000) >> 15);
+        gains[3] = clamp16((right * state.wet + 0x4000) >> 15);
+
+        for (k = 0; k < 4; k++) {
+            uint32_t pos = outputs[k] + n * 2;
+
+            dmem_set(pos, clamp16(dmem_get(pos) + ((in * gains[k]) >> 15)));
+        }
+    }
+
+    memcpy(address, &state, sizeof(state));
+}
+
+static void cmd_polef(uint32_t w0, uint32_t w1) {
+    uint32_t flags = (w0 >> 16) & 0xFF;
+    int16_t gain = w0;
+    uint32_t dmem = (w1 >> 24) ? N_MAIN2 : N_MAIN;
+    uint8_t* state = rdram(w1);
+    const int16_t* h1 = &AdpcmTable[0];
+    const int16_t* h2 = &AdpcmTable[8];
+    int16_t h2Gain[8];
+    int16_t frame[8];
+    int16_t l1, l2;
+    int count = N_COUNT;
+    int32_t accu;
+    int i, j;
+
+    if (flags & A_INIT) {
+        l1 = 0;
+        l2 = 0;
+    } else {
+        l1 = load16(&state[4]);
+        l2 = load16(&state[6]);
+    }
+
+    for (i = 0; i < 8; i++) {
+        h2Gain[i] = (h2[i] * gain) >> 14;
+    }
+
+    while (count > 0) {
+        for (i = 0; i < 8; i++) {
+            frame[i] = dmem_get(dmem + i * 2);
+        }
+        for (i = 0; i < 8; i++) {
+            accu = frame[i] * gain;
+            accu += h1[i] * l1 + h2[i] * l2;
+            for (j = 0; j < i; j++) {
+                accu += h2Gain[j] * frame[i - 1 - j];
+            }
+            dmem_set(dmem + i * 2, clamp16(accu >> 14));
+        }
+        l1 = dmem_get(dmem + 12);
+        l2 = dmem_get(dmem + 14);
+        dmem += 16;
+        count -= 16;
+    }
+
+    // the last four samples, of which the next call uses the final two
+    for (i = 0; i < 4; i++) {
+        store16(&state[i * 2], dmem_get(dmem - 8 + i * 2));
+    }
+}
+
+static void cmd_mixer(uint32_t w0, uint32_t w1) {
+    int16_t gain = w0;
+    uint32_t dmemi = w1 >> 16;
+    uint32_t dmemo = w1 & 0xFFFF;
+    int n;
+
+    for (n = 0; n < N_COUNT; n += 2) {
+        dmem_set(dmemo + n, clamp16(dmem_get(dmemo + n) + ((dmem_get(dmemi + n) * gain) >> 15)));
+    }
+}
+
+static void cmd_interleave(void) {
+    int n;
+
+    for (n = 0; n < N_COUNT >> 1; n++) {
+        int16_t left = dmem_get(N_DRY_LEFT + n * 2);
+        int16_t right = dmem_get(N_DRY_RIGHT + n * 2);
+
+        dmem_set(N_MAIN + n * 4, left);
+        dmem_set(N_MAIN + n * 4 + 2, right);
+    }
+}
+
+void audio_host_rsp_run(const void* cmdList, unsigned int size) {
+    const uint8_t* cmd = cmdList;
+    const uint8_t* end = cmd + size;
+    uint32_t dmem, count, i;
+
+    for (; cmd < end; cmd += 8) {
+        uint32_t w0 = (cmd[0] << 24) | (cmd[1] << 16) | (cmd[2] << 8) | cmd[3];
+        uint32_t w1 = (cmd[4] << 24) | (cmd[5] << 16) | (cmd[6] << 8) | cmd[7];
+
+        switch (w0 >> 24) {
+            case A_ADPCM:
+                cmd_adpcm(w0, w1);
+                break;
+            case A_CLEARBUFF:
+                dmem = w0 & 0xFFFF;
+                count = dmem_span(dmem, w1 & 0xFFF);
+                memset(&Dmem[dmem & (DMEM_SIZE - 1)], 0, count);
+                break;
+            case A_ENVMIXER:
+                cmd_envmixer(w0, w1);
+                break;
+            case A_LOADBUFF:
+                // transfers are aligned the way the RSP DMA engine requires
+                dmem = w0 & 0xFFC;
+                count = dmem_span(dmem, (((w0 >> 12) & 0xFFF) + 7) & ~7);
+                memcpy(&Dmem[dmem], rdram(w1 & ~7), count);
+                break;
+            case A_RESAMPLE:
+                cmd_resample(w0, w1);
+                break;
+            case A_SAVEBUFF:
+                dmem = w0 & 0xFFC;
+                count = dmem_span(dmem, (((w0 >> 12) & 0xFFF) + 7) & ~7);
+                memcpy(rdram(w1 & ~7), &Dmem[dmem], count);
+                break;
+            case A_SETVOL:
+                if ((w0 >> 16) & A_VOL) {
+                    if ((w0 >> 16) & A_LEFT) {
+                        EnvVolume[0] = w0;
+                        EnvDry = w1 >> 16;
+                        EnvWet = w1;
+                    } else {
+                        EnvTarget[1] = w0;
+                        EnvRate[1] = w1;
+                    }
+                } else {
+                    EnvTarget[0] = w0;
+                    EnvRate[0] = w1;
+                }
+                break;
+            case A_DMEMMOVE:
+                // copied forwards byte by byte, which the engine relies on for overlapping moves
+                count = ((w1 & 0xFFFF) + 3) & ~3;
+                for (i = 0; i < count; i++) {
+                    Dmem[((w1 >> 16) + i) & (DMEM_SIZE - 1)] = Dmem[((w0 & 0xFFFF) + i) & (DMEM_SIZE - 1)];
+                }
+                break;
+            case A_LOADADPCM:
+                count = (w0 & 0xFFFF) >> 1;
+                for (i = 0; i < count && i < sizeof(AdpcmTable) / sizeof(AdpcmTable[0]); i++) {
+                    AdpcmTable[i] = load16(rdram(w1 + i * 2));
+                }
+                break;
+            case A_MIXER:
+                cmd_mixer(w0, w1);
+                break;
+            case A_INTERLEAVE:
+                cmd_interleave();
+                break;
+            case A_POLEF:
+                cmd_polef(w0, w1);
+                break;
+            case A_SETLOOP:
+                LoopAddress = w1 & 0xFFFFFF;
+                break;
+            case A_SPNOOP:
+            default:
+                break;
+        }
+    }
+}
@@ -6,6 +6,16 @@ import io
 
 
 SYMBOL_TABLE_PTR_ROM_ADDR = 0x18
+SYMBOL_INDEX_MAX = 1024  # see backtrace.c
+SYMBOL_INDEX_MIN_STRIDE = 16
+
+
+def index_stride(symbol_count: int) -> int:
+    # smallest power of two that keeps the index small enough to be cached in RAM by address2symbol
+    stride = SYMBOL_INDEX_MIN_STRIDE
+    while (symbol_count + stride - 1) // stride > SYMBOL_INDEX_MAX:
+        stride *= 2
+    return stride
 
 
 def readelf(elf: str) -> List[Tuple[int, str, str, int]]:
@@ -86,8 +96,11 @@ if __name__ == "__main__":
 
         # write header (see backtrace.h)
         f.seek(symbol_table_addr)
-        f.write(b"SYMS")
-        f.write(struct.pack(">I", len(symbols)))
+        stride = index_stride(len(symbols))
+        index = [symbols[i][0] for i in range(0, len(symbols), stride)]
+
+        f.write(b"SYM2")
+        f.write(struct.pack(">IIII", len(symbols), stride, len(index), 0))  # index offset is patched below
 
         sizeof_symbol = 4 + 4 + 4  # sizeof(Symbol)
         strings_begin = f.tell() + sizeof_symbol * len(symbols)
@@ -121,6 +134,17 @@ if __name__ == "__main__":
         padding_bytes = b"\x00" * (padding_size - f.tell())
         f.write(padding_bytes)
 
+        # sparse index of symbol addresses, so lookups can binary search it and then read only a few symbols
+        index_addr = f.tell()
+        for addr in index:
+            f.write(struct.pack(">I", addr))
+        f.write(b"\x00" * (-f.tell() % 16))
+
+        f.seek(symbol_table_addr + 16)
+        f.write(struct.pack(">I", index_addr))
+        f.seek(0, 2)
+
+        print(f"symbol index: {len(index)} entries, one every {stride} symbols")
         print("symbol table size: {} kib".format((f.tell() - symbol_table_addr) / 1024))
 
         print(f"updating SYMBOL_TABLE_PTR_ROM_ADDR")
@@ -0,0 +1,91 @@
+#!/usr/bin/env python3
+
+# Runs many asset conversion jobs in a single interpreter, so that a clean build doesn't pay python startup and
+# import costs once per image. configure.py groups jobs of the batchable rules into manifests; ninja reruns a batch
+# whenever any of its inputs change, and this script then only re-runs the jobs which are actually out of date.
+# The batch rule uses restat, so outputs of skipped jobs don't trigger downstream rebuilds.
+
+import importlib
+import json
+import os
+from pathlib import Path
+from sys import argv, path
+from typing import Dict, List, Set
+
+path.append(str(Path(__file__).parent))
+
+# rule name -> module providing main(args)
+TOOLS = {
+    "img": "img.build",
+    "npc_sprite": "sprite.npc_sprite",
+    "sprite_header": "sprite.header",
+    "tex": "mapfs.tex",
+}
+
+
+def job_key(job: Dict) -> str:
+    return json.dumps([job["tool"], job["args"]])
+
+
+def mtime(p: str) -> float:
+    try:
+        return os.stat(p).st_mtime
+    except FileNotFoundError:
+        return -1
+
+
+def is_stale(job: Dict, built: Set[str]) -> bool:
+    # args changed since the last run (e.g. new image flags)
+    if job_key(job) not in built:
+        return True
+
+    newest_input = max((mtime(p) for p in job["inputs"]), default=0)
+    for p in job["outputs"]:
+        out_time = mtime(p)
+        if out_time < 0 or out_time < newest_input:
+            return True
+    return False
+
+
+def run_batch(manifest_path: Path):
+    with open(manifest_path) as f:
+        jobs: List[Dict] = json.load(f)
+
+    done_path = manifest_path.with_suffix(".done")
+    try:
+        with open(done_path) as f:
+            built: Set[str] = set(json.load(f))
+    except (FileNotFoundError, json.JSONDecodeError):
+        built = set()
+
+    # forget jobs which are no longer part of this batch
+    built &= {job_key(job) for job in jobs}
+
+    modules = {}
+
+    try:
+        for job in jobs:
+            if not is_stale(job, built):
+                continue
+
+            tool = job["tool"]
+            if tool not in modules:
+                modules[tool] = importlib.import_module(TOOLS[tool])
+
+            for p in job["outputs"]:
+                Path(p).parent.mkdir(parents=True, exist_ok=True)
+
+            built.discard(job_key(job))
+            modules[tool].main(job["args"])
+            built.add(job_key(job))
+    finally:
+        with open(done_path, "w") as f:
+            json.dump(sorted(built), f)
+
+
+if __name__ == "__main__":
+    if len(argv) != 2:
+        print("usage: batch.py MANIFEST")
+        exit(1)
+
+    run_batch(Path(argv[1]))
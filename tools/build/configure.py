@@ -5,6 +5,7 @@ import os
 import shutil
 from typing import List, Dict, Set, Union
 from pathlib import Path
+import json
 import subprocess
 import sys
 import ninja_syntax
@@ -25,6 +26,10 @@ CRC_TOOL = f"{BUILD_TOOLS}/rom/n64crc"
 PIGMENT64 = "pigment64"
 CRUNCH64 = "crunch64"
 
+# Rules whose jobs are grouped and run by batch.py, BATCH_SIZE jobs per python process
+BATCH_RULES = ["img", "npc_sprite", "sprite_header", "tex"]
+BATCH_SIZE = 64
+
 RUST_TOOLS = [
     (PIGMENT64, "pigment64", "0.4.2"),
     (CRUNCH64, "crunch64-cli", "0.3.1"),
@@ -36,6 +41,32 @@ def exec_shell(command: List[str]) -> str:
     return ret.stdout
 
 
+def write_if_changed(path: Path, contents: str):
+    # keep the mtime of unchanged files, so ninja doesn't consider their dependents dirty
+    try:
+        if path.read_text() == contents:
+            return
+    except FileNotFoundError:
+        pass
+
+    path.parent.mkdir(parents=True, exist_ok=True)
+    path.write_text(contents)
+
+
+def batch_job_args(rule: str, outputs: List[str], inputs: List[str], variables: Dict[str, str]) -> List[str]:
+    # equivalent of the rule's command line, for running it through batch.py
+    out = outputs[0]
+    if rule == "img":
+        return [variables["img_type"], inputs[0], out, *variables["img_flags"].split()]
+    elif rule == "npc_sprite":
+        return [out, variables["sprite_name"], variables["asset_stack"]]
+    elif rule == "sprite_header":
+        return [out, variables["sprite_name"], variables["sprite_id"], variables["asset_stack"]]
+    elif rule == "tex":
+        return [out, variables["tex_name"], variables["asset_stack"]]
+    raise Exception(f"rule {rule} cannot be batched")
+
+
 def write_ninja_rules(
     ninja: ninja_syntax.Writer,
     cpp: str,
@@ -44,6 +75,8 @@ def write_ninja_rules(
     use_ccache: bool,
     shift: bool,
     debug: bool,
+    yay0_cache_dir: str,
+    compressor_versions: Dict[str, str],
 ):
     # platform-specific
 
@@ -207,6 +240,13 @@ def write_ninja_rules(
         command=f"$python {BUILD_TOOLS}/img/build.py $img_type $in $out $img_flags",
     )
 
+    ninja.rule(
+        "batch",
+        description="batch($batch_rule) $manifest",
+        command=f"$python {BUILD_TOOLS}/batch.py $manifest",
+        restat=True,
+    )
+
     ninja.rule(
         "pigment",
         description="img($img_type) $in",
@@ -219,10 +259,20 @@ def write_ninja_rules(
         command=f'$python {BUILD_TOOLS}/img/header.py $in $out "$c_name"',
     )
 
+    yay0_stats = "ver/$version/build/yay0_cache_stats.txt"
+
     ninja.rule(
         "yay0",
         description="yay0 $in",
-        command=f"crunch64 compress yay0 $in $out",
+        command=f"$python {BUILD_TOOLS}/yay0_cache.py $in $out {yay0_cache_dir} {CRUNCH64}-{compressor_versions[CRUNCH64]} {yay0_stats}",
+    )
+
+    # reruns whenever a compressed output changed, and evicts old cache entries
+    ninja.rule(
+        "yay0_stats",
+        description="yay0 cache stats",
+        command=f"$python {BUILD_TOOLS}/yay0_cache.py --stats {yay0_stats} $out {yay0_cache_dir}",
+        pool="console",
     )
 
     ninja.rule(
@@ -244,9 +294,10 @@ def write_ninja_rules(
     )
 
     ninja.rule(
-        "msg",
-        description="msg $in",
-        command=f"$python {BUILD_TOOLS}/msg/parse_compile.py $version $in $out",
+        "msg_sections",
+        description="msg sections $version",
+        command=f"$python {BUILD_TOOLS}/msg/compile_sections.py $version ver/$version/build/msg_cache $sections",
+        restat=True,
     )
 
     ninja.rule(
@@ -337,6 +388,80 @@ def write_ninja_for_tools(ninja: ninja_syntax.Writer):
 
     ninja.build(CRC_TOOL, "cc_tool", f"{BUILD_TOOLS}/rom/n64crc.c")
 
+    write_ninja_for_audio_host(ninja)
+
+
+AUDIO_HOST_DIR = "tools/audio_host"
+AUDIO_HOST_BUILD_DIR = "build/audio_host"
+AUDIO_HOST_ENGINE_FILES = [
+    "25f00_len_940",
+    "sfx_player",
+    "28910_len_5090",
+    "2BF90",
+    "2d9a0_len_890",
+    "2e230_len_2190",
+    "303c0_len_3e10",
+    "30450",
+    "31650",
+    "33450",
+    "tables",
+    "reverb",
+]
+
+
+# Host build of the audio engine that renders songs to WAV, see tools/audio_host/main.c.
+# Not part of "all"; build it with `ninja audio_host`.
+def write_ninja_for_audio_host(ninja: ninja_syntax.Writer):
+    engine_cflags = (
+        "-O2 -w -fno-toplevel-reorder -DAUDIO_HOST -include audio_host_pre.h "
+        f"-I{AUDIO_HOST_DIR}/include -I{AUDIO_HOST_DIR} -Iver/us/include -Iinclude -Isrc "
+        "-D_LANGUAGE_C -D_FINALROM -DVERSION=us -DVERSION_US -DF3DEX_GBI_2"
+    )
+
+    ninja.rule(
+        "audio_host_engine_cc",
+        description="audio_host cc $in",
+        command=f"cc -c {engine_cflags} $in -o $out",
+    )
+    ninja.rule(
+        "audio_host_cc",
+        description="audio_host cc $in",
+        command="cc -c -O2 -Wall $in -o $out",
+    )
+    # the harness provides its own au_load_BK_to_bank
+    ninja.rule(
+        "audio_host_weaken",
+        description="audio_host weaken $in",
+        command="objcopy --weaken-symbol=au_load_BK_to_bank $in $out",
+    )
+    # the engine keeps RDRAM addresses in 24-bit fields, so the image must load low
+    ninja.rule(
+        "audio_host_ld",
+        description="audio_host ld $out",
+        command="cc -no-pie $in -lm -o $out",
+    )
+
+    objects = []
+    for name in AUDIO_HOST_ENGINE_FILES:
+        obj = f"{AUDIO_HOST_BUILD_DIR}/src/audio/{name}.o"
+        ninja.build(obj, "audio_host_engine_cc", f"src/audio/{name}.c")
+        if name == "2e230_len_2190":
+            weak_obj = f"{AUDIO_HOST_BUILD_DIR}/src/audio/{name}.weak.o"
+            ninja.build(weak_obj, "audio_host_weaken", obj)
+            obj = weak_obj
+        objects.append(obj)
+    for name in ["host_os", "host_rom"]:
+        obj = f"{AUDIO_HOST_BUILD_DIR}/{name}.o"
+        ninja.build(obj, "audio_host_engine_cc", f"{AUDIO_HOST_DIR}/{name}.c")
+        objects.append(obj)
+    for name in ["rsp", "main"]:
+        obj = f"{AUDIO_HOST_BUILD_DIR}/{name}.o"
+        ninja.build(obj, "audio_host_cc", f"{AUDIO_HOST_DIR}/{name}.c")
+        objects.append(obj)
+
+    ninja.build(f"{AUDIO_HOST_BUILD_DIR}/audio_host", "audio_host_ld", objects)
+    ninja.build("audio_host", "phony", f"{AUDIO_HOST_BUILD_DIR}/audio_host")
+
 
 def does_iconv_work() -> bool:
     # run iconv and see if it works
@@ -435,6 +560,9 @@ class Configure:
         # TODO: read from splat.yaml
         return Path(f"ver/{self.version}/papermario.ld")
 
+    def yay0_stats_target(self) -> str:
+        return str(self.build_path() / "yay0_cache_summary.txt")
+
     def map_path(self) -> Path:
         return self.elf_path().with_suffix(".map")
 
@@ -492,12 +620,15 @@ class Configure:
         non_matching: bool,
         modern_gcc: bool,
         c_maps: bool = False,
+        batch_assets: bool = True,
     ):
         assert self.linker_entries is not None
 
         built_objects = set()
         generated_code = []
         inc_img_bins = []
+        batch_jobs: Dict[str, List[Dict]] = {rule: [] for rule in BATCH_RULES}
+        yay0_outputs = []
         precompiled_header_path = self.build_path() / "include" / "precompiled.h.gch"
 
         def build(
@@ -530,6 +661,9 @@ class Configure:
                 if i_output.endswith(".h"):
                     generated_code.append(i_output)
 
+            if task == "yay0":
+                yay0_outputs.extend(object_strs)
+
             if needs_build:
                 skip_outputs.update(object_strs)
 
@@ -545,6 +679,18 @@ class Configure:
                 inputs = self.resolve_src_paths(src_paths)
                 for dir in asset_deps:
                     inputs.extend(self.get_asset_list(dir))
+
+                if batch_assets and task in batch_jobs:
+                    batch_jobs[task].append(
+                        {
+                            "tool": task,
+                            "args": batch_job_args(task, object_strs, inputs, variables),
+                            "inputs": inputs,
+                            "outputs": object_strs + implicit_outputs,
+                        }
+                    )
+                    return
+
                 ninja.build(
                     outputs=object_strs,  # $out
                     rule=task,
@@ -979,11 +1125,20 @@ class Configure:
 
             elif seg.type == "pm_msg":
                 msg_bins = []
+                msg_sections = []
 
                 for section_idx, msg_path in enumerate(entry.src_paths):
                     bin_path = entry.object_path.with_suffix("") / f"{section_idx:02X}.bin"
                     msg_bins.append(bin_path)
-                    build(bin_path, [msg_path], "msg")
+                    msg_sections.extend([str(bin_path), str(self.resolve_asset_path(msg_path))])
+
+                # all sections are compiled by one process, in parallel and through a cache
+                build(
+                    msg_bins,
+                    entry.src_paths,
+                    "msg_sections",
+                    variables={"sections": " ".join(msg_sections)},
+                )
 
                 build(
                     [
@@ -1234,6 +1389,24 @@ class Configure:
             else:
                 raise Exception(f"don't know how to build {seg.__class__.__name__} '{seg.name}'")
 
+        # Asset conversion batches
+        for rule, jobs in batch_jobs.items():
+            for i in range(0, len(jobs), BATCH_SIZE):
+                batch = jobs[i : i + BATCH_SIZE]
+                manifest_path = self.build_path() / "batch" / f"{rule}_{i // BATCH_SIZE}.json"
+                write_if_changed(manifest_path, json.dumps(batch, indent=1))
+
+                ninja.build(
+                    outputs=[out for job in batch for out in job["outputs"]],
+                    rule="batch",
+                    inputs=[str(manifest_path)],
+                    implicit=sorted({inp for job in batch for inp in job["inputs"]}),
+                    variables={
+                        "manifest": str(manifest_path),
+                        "batch_rule": rule,
+                    },
+                )
+
         # Run undefined_syms through cpp
         ninja.build(
             str(self.undefined_syms_path()),
@@ -1283,6 +1456,13 @@ class Configure:
             variables={"baserom": str(self.baserom_path())},
         )
 
+        ninja.build(
+            self.yay0_stats_target(),
+            "yay0_stats",
+            implicit=yay0_outputs,
+            variables={"version": self.version},
+        )
+
         ninja.build("generated_code_" + self.version, "phony", generated_code)
         ninja.build("inc_img_bins_" + self.version, "phony", inc_img_bins)
 
@@ -1343,6 +1523,15 @@ if __name__ == "__main__":
         help="Use modern GCC instead of the original compiler",
     )
     parser.add_argument("--no-ccache", action="store_true", help="Use ccache")
+    parser.add_argument(
+        "--no-batch-assets",
+        action="store_true",
+        help="Run one python process per converted asset instead of batching them",
+    )
+    parser.add_argument(
+        "--yay0-cache",
+        help="Directory for cached Yay0 compression outputs, can be shared between checkouts (default: ver/VERSION/build/yay0_cache)",
+    )
     parser.add_argument(
         "--c-maps",
         action="store_true",
@@ -1380,9 +1569,11 @@ if __name__ == "__main__":
     version_err_msg = ""
     missing_tools = []
     version_old_tools = []
+    tool_versions: Dict[str, str] = {}
     for tool, crate_name, req_version in RUST_TOOLS:
         try:
             version = exec_shell([tool, "--version"]).split(" ")[1].strip()
+            tool_versions[tool] = version
 
             if version < req_version:
                 version_err_msg += (
@@ -1473,11 +1664,14 @@ if __name__ == "__main__":
         args.ccache,
         args.shift,
         args.debug,
+        args.yay0_cache or "ver/$version/build/yay0_cache",
+        tool_versions,
     )
     write_ninja_for_tools(ninja)
 
     skip_files: Set[str] = set()
     all_rom_oks: List[str] = []
+    all_yay0_stats: List[str] = []
     first_configure = None
 
     for version in versions:
@@ -1498,15 +1692,23 @@ if __name__ == "__main__":
         sys.path.append(str((ROOT / "tools/splat_ext").resolve()))
 
         configure.split(not args.no_split_assets, args.split_code, args.shift, args.debug)
-        configure.write_ninja(ninja, skip_files, non_matching, args.modern_gcc, args.c_maps)
+        configure.write_ninja(
+            ninja,
+            skip_files,
+            non_matching,
+            args.modern_gcc,
+            args.c_maps,
+            not args.no_batch_assets,
+        )
 
         all_rom_oks.append(str(configure.rom_ok_path()))
+        all_yay0_stats.append(configure.yay0_stats_target())
 
     assert first_configure, "no versions configured"
     first_configure.make_current(ninja)
 
     if non_matching:
-        ninja.build("all", "phony", [str(first_configure.rom_path())])
+        ninja.build("all", "phony", [str(first_configure.rom_path()), first_configure.yay0_stats_target()])
     else:
-        ninja.build("all", "phony", all_rom_oks)
+        ninja.build("all", "phony", all_rom_oks + all_yay0_stats)
     ninja.default("all")
@@ -1,8 +1,9 @@
 #!/usr/bin/env python3
 
 from sys import argv, stderr
-from math import floor, ceil
+from math import ceil
 from glob import glob
+import numpy as np
 import png  # type: ignore
 
 
@@ -32,18 +33,28 @@ def rgb_to_intensity(r, g, b):
     return round(r * 0.2126 + g * 0.7152 + 0.0722 * b)
 
 
-def iter_in_groups(iterable, n, fillvalue=None):
-    from itertools import zip_longest
+# vectorized equivalents of the above, operating on (..., 4) arrays of channels
+def pack_colors(rgba: np.ndarray) -> bytes:
+    rgba = rgba.astype(np.uint32)
+    packed = (
+        ((rgba[..., 0] >> 3) << 11) | ((rgba[..., 1] >> 3) << 6) | ((rgba[..., 2] >> 3) << 1) | (rgba[..., 3] >> 7)
+    )
+    return packed.astype(">u2").tobytes()
 
-    args = [iter(iterable)] * n
-    return zip_longest(*args, fillvalue=fillvalue)
 
+def rgb_to_intensities(rgba: np.ndarray) -> np.ndarray:
+    rgb = rgba.astype(np.float64)
+    # np.rint rounds half to even, matching round()
+    return np.rint(rgb[..., 0] * 0.2126 + rgb[..., 1] * 0.7152 + 0.0722 * rgb[..., 2]).astype(np.uint32)
 
-def reversed_if(iterator, cond):
-    if cond:
-        return reversed(list(iterator))
-    else:
-        return iterator
+
+def not_grayscale(rgba: np.ndarray) -> bool:
+    # matches the chained comparison c[0] != c[1] != c[2]
+    return bool(np.any((rgba[..., 0] != rgba[..., 1]) & (rgba[..., 1] != rgba[..., 2])))
+
+
+def not_alpha_mask(alpha: np.ndarray) -> bool:
+    return bool(np.any((alpha != 0) & (alpha != 0xFF)))
 
 
 class Converter:
@@ -62,6 +73,26 @@ class Converter:
             self.warned = True
             print(self.infile + ": warning: " + msg, file=stderr)
 
+    def read_rgba(self, img):
+        (width, height, data, info) = img.asRGBA()
+        pixels = np.array(list(data), dtype=np.uint32).reshape(height, width, 4)
+        if self.flip_y:
+            pixels = pixels[::-1]
+        return (width, height, pixels)
+
+    def read_indexed(self, img):
+        (width, height, data, info) = img.read()
+        pixels = np.array(list(data), dtype=np.uint8).reshape(height, width)
+        if self.flip_y:
+            pixels = pixels[::-1]
+        return (width, height, pixels)
+
+    def pack_palette(self, palette) -> bytes:
+        rgba = np.array(palette, dtype=np.uint32).reshape(-1, 4)
+        if not_alpha_mask(rgba[:, 3]):
+            self.warn("alpha mask mode but translucent pixels used")
+        return pack_colors(rgba)
+
     def convert(self):
         out_bytes = bytearray()
         out_width = 0
@@ -69,146 +100,89 @@ class Converter:
         img = png.Reader(self.infile)
 
         if self.mode == "rgba32":
-            (out_width, out_height, data, info) = img.asRGBA()
-            for row in reversed_if(data, self.flip_y):
-                out_bytes += row
+            (out_width, out_height, pixels) = self.read_rgba(img)
+            out_bytes += pixels.astype(np.uint8).tobytes()
         elif self.mode == "rgba16":
-            (out_width, out_height, data, info) = img.asRGBA()
-            for row in reversed_if(data, self.flip_y):
-                for rgba in iter_in_groups(row, 4):
-                    if rgba[3] not in (0, 0xFF):
-                        self.warn("alpha mask mode but translucent pixels used")
-
-                    color = pack_color(*rgba)
-                    out_bytes += color.to_bytes(2, byteorder="big")
+            (out_width, out_height, pixels) = self.read_rgba(img)
+            if not_alpha_mask(pixels[..., 3]):
+                self.warn("alpha mask mode but translucent pixels used")
+            out_bytes += pack_colors(pixels)
         elif self.mode == "ci8":
-            (out_width, out_height, data, info) = img.read()
-            for row in reversed_if(data, self.flip_y):
-                out_bytes += row
+            (out_width, out_height, pixels) = self.read_indexed(img)
+            out_bytes += pixels.tobytes()
         elif self.mode == "ci4":
-            (out_width, out_height, data, info) = img.read()
-            for row in reversed_if(data, self.flip_y):
-                for a, b in iter_in_groups(row, 2):
-                    byte = (a << 4) | b
-                    byte = byte & 0xFF
-                    out_bytes += byte.to_bytes(1, byteorder="big")
+            (out_width, out_height, pixels) = self.read_indexed(img)
+            pairs = pixels.reshape(out_height, out_width // 2, 2).astype(np.uint32)
+            out_bytes += (((pairs[..., 0] << 4) | pairs[..., 1]) & 0xFF).astype(np.uint8).tobytes()
         elif self.mode == "palette":
             img.preamble(True)
-            palette = img.palette(alpha="force")
-
-            for rgba in palette:
-                if rgba[3] not in (0, 0xFF):
-                    self.warn("alpha mask mode but translucent pixels used")
-
-                color = pack_color(*rgba)
-                out_bytes += color.to_bytes(2, byteorder="big")
+            out_bytes += self.pack_palette(img.palette(alpha="force"))
         elif self.mode == "ia4":
-            (out_width, out_height, data, info) = img.asRGBA()
-            for row in reversed_if(data, self.flip_y):
-                for c1, c2 in iter_in_groups(iter_in_groups(row, 4), 2):
-                    i1 = rgb_to_intensity(*c1[:3])
-                    a1 = c1[3]
-
-                    i2 = rgb_to_intensity(*c2[:3])
-                    a2 = c2[3]
-
-                    i1 = i1 >> 5
-                    i2 = i2 >> 5
-
-                    if a1 not in (0, 0xFF) or a2 not in (0, 0xFF):
-                        self.warn("alpha mask mode but translucent pixels used")
-                    if c1[0] != c1[1] != c1[2]:
-                        self.warn("grayscale mode but image is not")
-                    if c2[0] != c2[1] != c2[2]:
-                        self.warn("grayscale mode but image is not")
-
-                    a1 = 1 if a1 > 128 else 0
-                    a2 = 1 if a2 > 128 else 0
-
-                    h = (i1 << 1) | a1
-                    l = (i2 << 1) | a2
-
-                    byte = (h << 4) | l
-                    out_bytes += byte.to_bytes(1, byteorder="big")
+            (out_width, out_height, pixels) = self.read_rgba(img)
+            pairs = pixels.reshape(out_height, out_width // 2, 2, 4)
+
+            if not_alpha_mask(pixels[..., 3]):
+                self.warn("alpha mask mode but translucent pixels used")
+            if not_grayscale(pixels):
+                self.warn("grayscale mode but image is not")
+
+            i = rgb_to_intensities(pairs) >> 5
+            a = (pairs[..., 3] > 128).astype(np.uint32)
+            nibbles = (i << 1) | a
+            out_bytes += ((nibbles[..., 0] << 4) | nibbles[..., 1]).astype(np.uint8).tobytes()
         elif self.mode == "ia8":
-            (out_width, out_height, data, info) = img.asRGBA()
-            for row in reversed_if(data, self.flip_y):
-                for rgba in iter_in_groups(row, 4):
-                    i = rgb_to_intensity(*rgba[:3])
-                    a = rgba[3]
-
-                    i = floor(15 * (i / 0xFF))
-                    a = floor(15 * (a / 0xFF))
+            (out_width, out_height, pixels) = self.read_rgba(img)
 
-                    if rgba[0] != rgba[1] != rgba[2]:
-                        self.warn("grayscale mode but image is not")
+            if not_grayscale(pixels):
+                self.warn("grayscale mode but image is not")
 
-                    byte = (i << 4) | a
-                    out_bytes += byte.to_bytes(1, byteorder="big")
+            i = np.floor(15 * (rgb_to_intensities(pixels) / 0xFF)).astype(np.uint32)
+            a = np.floor(15 * (pixels[..., 3] / 0xFF)).astype(np.uint32)
+            out_bytes += ((i << 4) | a).astype(np.uint8).tobytes()
         elif self.mode == "ia16":
-            (out_width, out_height, data, info) = img.asRGBA()
-            for row in reversed_if(data, self.flip_y):
-                for rgba in iter_in_groups(row, 4):
-                    i = rgb_to_intensity(*rgba[:3])
-                    a = rgba[3]
+            (out_width, out_height, pixels) = self.read_rgba(img)
 
-                    if rgba[0] != rgba[1] != rgba[2]:
-                        self.warn("grayscale mode but image is not")
+            if not_grayscale(pixels):
+                self.warn("grayscale mode but image is not")
 
-                    out_bytes += bytes((i, a))
+            ia = np.stack((rgb_to_intensities(pixels), pixels[..., 3]), axis=-1)
+            out_bytes += ia.astype(np.uint8).tobytes()
         elif self.mode == "i4":
-            (out_width, out_height, data, info) = img.asRGBA()
-            for row in reversed_if(data, self.flip_y):
-                for c1, c2 in iter_in_groups(iter_in_groups(row, 4), 2):
-                    if c1[3] != 0xFF or c2[3] != 0xFF:
-                        self.warn("discarding alpha channel")
+            (out_width, out_height, pixels) = self.read_rgba(img)
+            pairs = pixels.reshape(out_height, out_width // 2, 2, 4)
 
-                    i1 = rgb_to_intensity(*c1[:3])
-                    i2 = rgb_to_intensity(*c2[:3])
+            if np.any(pixels[..., 3] != 0xFF):
+                self.warn("discarding alpha channel")
+            if not_grayscale(pixels):
+                self.warn("grayscale mode but image is not")
 
-                    i1 = floor(15 * (i1 / 0xFF))
-                    i2 = floor(15 * (i2 / 0xFF))
+            i = np.floor(15 * (rgb_to_intensities(pairs) / 0xFF)).astype(np.uint32)
+            out_bytes += ((i[..., 0] << 4) | i[..., 1]).astype(np.uint8).tobytes()
+        elif self.mode == "i8":
+            (out_width, out_height, pixels) = self.read_rgba(img)
 
-                    if c1[0] != c1[1] != c1[2]:
-                        self.warn("grayscale mode but image is not")
-                    if c2[0] != c2[1] != c2[2]:
-                        self.warn("grayscale mode but image is not")
+            if np.any(pixels[..., 3] != 0xFF):
+                self.warn("discarding alpha channel")
+            if not_grayscale(pixels):
+                self.warn("grayscale mode but image is not")
 
-                    byte = (i1 << 4) | i2
-                    out_bytes += byte.to_bytes(1, byteorder="big")
-        elif self.mode == "i8":
-            (out_width, out_height, data, info) = img.asRGBA()
-            for row in reversed_if(data, self.flip_y):
-                for rgba in iter_in_groups(row, 4):
-                    if rgba[3] != 0xFF or rgba[3] != 0xFF:
-                        self.warn("discarding alpha channel")
-                    if rgba[0] != rgba[1] != rgba[2]:
-                        self.warn("grayscale mode but image is not")
-
-                    i = rgb_to_intensity(*rgba[:3])
-                    out_bytes += i.to_bytes(1, byteorder="big")
+            out_bytes += rgb_to_intensities(pixels).astype(np.uint8).tobytes()
         elif self.mode == "party":
-            (out_width, out_height, data, info) = img.read()
             img.preamble(True)
             palette = img.palette(alpha="force")
+            (out_width, out_height, pixels) = self.read_indexed(img)
 
             # palette
-            for rgba in palette:
-                if rgba[3] not in (0, 0xFF):
-                    self.warn("alpha mask mode but translucent pixels used")
-
-                color = pack_color(*rgba)
-                out_bytes += color.to_bytes(2, byteorder="big")
+            out_bytes += self.pack_palette(palette)
 
             # ci 8
-            for row in reversed_if(data, self.flip_y):
-                out_bytes += row
+            out_bytes += pixels.tobytes()
 
             out_bytes += b"\0\0\0\0\0\0\0\0\0\0"  # padding
         elif self.mode == "bg":
-            (out_width, out_height, data, info) = img.read()
             img.preamble(True)
             palettes = [img.palette(alpha="force")]
+            (out_width, out_height, pixels) = self.read_indexed(img)
 
             for palettepath in glob(self.infile.split(".")[0] + ".*.png"):
                 pal = png.Reader(palettepath)
@@ -230,16 +204,10 @@ class Converter:
 
             for palette in palettes:
                 # palette
-                for rgba in palette:
-                    if rgba[3] not in (0, 0xFF):
-                        self.warn("alpha mask mode but translucent pixels used")
-
-                    color = pack_color(*rgba)
-                    out_bytes += color.to_bytes(2, byteorder="big")
+                out_bytes += self.pack_palette(palette)
 
             # ci 8
-            for row in reversed_if(data, self.flip_y):
-                out_bytes += row
+            out_bytes += pixels.tobytes()
         else:
             print("unsupported mode", file=stderr)
             exit(1)
@@ -247,18 +215,22 @@ class Converter:
         return (out_bytes, out_width, out_height)
 
 
-if __name__ == "__main__":
-    if len(argv) < 4:
+def main(args):
+    if len(args) < 3:
         print("usage: build.py MODE INFILE OUTFILE [--flip-x] [--flip-y]")
         exit(1)
 
-    mode = argv[1]
-    infile = argv[2]
-    outfile = argv[3]
+    mode = args[0]
+    infile = args[1]
+    outfile = args[2]
 
-    flip_x = "--flip-x" in argv
-    flip_y = "--flip-y" in argv
+    flip_x = "--flip-x" in args
+    flip_y = "--flip-y" in args
 
     (out_bytes, out_width, out_height) = Converter(mode, infile, flip_x, flip_y).convert()
-    with open(argv[3], "wb") as f:
+    with open(outfile, "wb") as f:
         f.write(out_bytes)
+
+
+if __name__ == "__main__":
+    main(argv[1:])
@@ -165,14 +165,18 @@ def build(out_path: Path, tex_name: str, asset_stack: Tuple[Path, ...], endian:
         out_bin.write(out_bytes)
 
 
-if __name__ == "__main__":
+def main(argv):
     parser = argparse.ArgumentParser(description="Texture archives")
     parser.add_argument("bin_out", type=Path, help="Output binary file path")
     parser.add_argument("name", help="Name of tex subdirectory")
     parser.add_argument("asset_stack", help="comma-separated asset stack")
     parser.add_argument("--endian", choices=["big", "little"], default="big", help="Output endianness")
-    args = parser.parse_args()
+    args = parser.parse_args(argv)
 
     asset_stack = tuple(Path(d) for d in args.asset_stack.split(","))
 
     build(args.bin_out, args.name, asset_stack, args.endian)
+
+
+if __name__ == "__main__":
+    main(None)
@@ -0,0 +1,142 @@
+#!/usr/bin/env python3
+
+# Compiles every message section (one .msg file each) in a single invocation. Sections are compiled in parallel
+# worker processes, and compiled sections are cached by the hash of their source, the game version and the compiler
+# itself. Outputs are only rewritten when their contents change, so with ninja's restat an edit that doesn't affect
+# the compiled bytes (e.g. a comment) doesn't rebuild the combined message blob.
+
+import hashlib
+import os
+import time
+from concurrent.futures import ProcessPoolExecutor
+from pathlib import Path
+from sys import argv, path
+from typing import List, Optional, Tuple
+
+path.append(str(Path(__file__).parent))
+
+import parse_compile
+
+COMPILER_SOURCES = [Path(parse_compile.__file__), Path(__file__)]
+
+
+def compiler_hash() -> bytes:
+    digest = hashlib.sha256()
+    for source in COMPILER_SOURCES:
+        digest.update(source.read_bytes())
+    return digest.digest()
+
+
+def section_key(compiler: bytes, version: str, text: bytes) -> str:
+    digest = hashlib.sha256(compiler)
+    digest.update(version.encode())
+    digest.update(text)
+    return digest.hexdigest()
+
+
+def compile_section(version: str, filename: str) -> Optional[bytes]:
+    try:
+        return parse_compile.pack_messages(parse_compile.compile_file(version, filename, False))
+    except SystemExit:
+        # the parser has already printed the error
+        return None
+
+
+def write_if_changed(out_path: Path, data: bytes):
+    try:
+        if out_path.read_bytes() == data:
+            return
+    except FileNotFoundError:
+        pass
+
+    out_path.parent.mkdir(parents=True, exist_ok=True)
+    out_path.write_bytes(data)
+
+
+def compile_sections(
+    version: str,
+    cache_dir: Optional[Path],
+    sections: List[Tuple[Path, Path]],
+    jobs: Optional[int] = None,
+) -> Tuple[int, int]:
+    compiler = compiler_hash()
+
+    results: List[Optional[bytes]] = [None] * len(sections)
+    keys: List[str] = []
+    pending: List[int] = []
+
+    for i, (_, in_path) in enumerate(sections):
+        key = section_key(compiler, version, in_path.read_bytes())
+        keys.append(key)
+
+        if cache_dir is not None and (cache_dir / key).is_file():
+            results[i] = (cache_dir / key).read_bytes()
+        else:
+            pending.append(i)
+
+    if len(pending) == 1 or jobs == 1:
+        compiled = [compile_section(version, str(sections[i][1])) for i in pending]
+    elif len(pending) > 1:
+        with ProcessPoolExecutor(max_workers=jobs) as executor:
+            in_paths = [str(sections[i][1]) for i in pending]
+            compiled = list(executor.map(compile_section, [version] * len(pending), in_paths))
+    else:
+        compiled = []
+
+    failed = False
+    for i, data in zip(pending, compiled):
+        if data is None:
+            failed = True
+            continue
+
+        results[i] = data
+        if cache_dir is not None:
+            write_if_changed(cache_dir / keys[i], data)
+
+    if failed:
+        exit(1)
+
+    for (out_path, _), data in zip(sections, results):
+        assert data is not None
+        write_if_changed(out_path, data)
+
+    return (len(sections) - len(pending), len(pending))
+
+
+def benchmark(version: str, in_paths: List[Path]):
+    import tempfile
+
+    with tempfile.TemporaryDirectory() as tmp:
+        sections = [(Path(tmp) / "out" / f"{i:02X}.bin", in_path) for i, in_path in enumerate(in_paths)]
+        cache_dir = Path(tmp) / "cache"
+
+        runs = [
+            ("serial, uncached", None, 1),
+            ("parallel, cold cache", cache_dir, None),
+            ("parallel, warm cache", cache_dir, None),
+        ]
+
+        print(f"compiling {len(sections)} sections using up to {os.cpu_count()} workers")
+        for name, run_cache_dir, jobs in runs:
+            start = time.perf_counter()
+            hits, misses = compile_sections(version, run_cache_dir, sections, jobs)
+            elapsed = time.perf_counter() - start
+            print(f"{name:>22}: {elapsed:7.3f}s ({hits} cached, {misses} compiled)")
+
+
+if __name__ == "__main__":
+    if len(argv) >= 4 and argv[2] == "--benchmark":
+        # e.g. compile_sections.py us --benchmark assets/*/msg/*.msg
+        benchmark(argv[1], [Path(p) for p in argv[3:]])
+        exit(0)
+
+    if len(argv) < 5 or (len(argv) - 3) % 2 != 0:
+        print("usage: compile_sections.py [version] [cache_dir] [out.msgpack in.msg]...")
+        print("       compile_sections.py [version] --benchmark [in.msg]...")
+        exit(1)
+
+    version = argv[1]
+    cache_dir = Path(argv[2])
+    rest = argv[3:]
+
+    compile_sections(version, cache_dir, [(Path(rest[i]), Path(rest[i + 1])) for i in range(0, len(rest), 2)])
@@ -3,6 +3,7 @@
 from sys import argv
 from collections import OrderedDict
 import re
+from typing import List
 import msgpack  # way faster than pickle
 
 
@@ -3160,1270 +3161,1296 @@ def strip_c_comments(text):
     return re.sub(pattern, replacer, text)
 
 
-if __name__ == "__main__":
-    if len(argv) < 3:
-        print("usage: parse_compile.py [version] [in.msg] [out.msgpack] [--c]")
-        exit(1)
+class SourceView:
+    """Read-only view of the source text starting at some offset.
 
-    version = argv[1]
-    filename = argv[2]
-    outfile = argv[3]
-    is_output_format_c = "--c" in argv
+    The parser consumes its input with `source = source[1:]`; slicing a str copies the whole remainder, which made
+    compiling a file quadratic in its length. Slicing a view just moves the offset.
+    """
 
+    __slots__ = ("text", "pos")
+
+    def __init__(self, text: str, pos: int = 0):
+        self.text = text
+        self.pos = pos
+
+    def __len__(self):
+        return len(self.text) - self.pos
+
+    def __getitem__(self, key):
+        if isinstance(key, slice):
+            assert key.stop is None and key.step is None
+            return SourceView(self.text, min(self.pos + (key.start or 0), len(self.text)))
+
+        if key < 0 or self.pos + key >= len(self.text):
+            raise IndexError("source index out of range")
+        return self.text[self.pos + key]
+
+
+def compile_source(version: str, filename: str, text: str, is_output_format_c: bool) -> List[Message]:
     messages = []
 
     message = None
-    with open(filename, "r") as f:
-        source = strip_c_comments(f.read())
-        lineno = 1
+    source = strip_c_comments(text)
+    lineno = 1
 
-        # ignore all carriage returns
-        source = source.replace("\r", "")
+    # ignore all carriage returns
+    source = SourceView(source.replace("\r", ""))
 
-        directive = ""
-        indent_level = 0
+    directive = ""
+    indent_level = 0
 
-        if version == "jp":
-            charset = CHARSET_KANA
-        elif version == "ique":
-            charset = CHARSET_IQUE
-        else:
-            charset = CHARSET_STANDARD
-        font_stack = [0]
-        sound_stack = [0]
-        color_stack = [0x0A]
-        fx_stack = []
-        style = None
-        explicit_end = False
-        choiceindex = -1
-
-        while len(source) > 0:
-            if source[0] == "\t":
-                source = source[1:]
-                continue
+    if version == "jp":
+        charset = CHARSET_KANA
+    elif version == "ique":
+        charset = CHARSET_IQUE
+    else:
+        charset = CHARSET_STANDARD
+    font_stack = [0]
+    sound_stack = [0]
+    color_stack = [0x0A]
+    fx_stack = []
+    style = None
+    explicit_end = False
+    choiceindex = -1
+
+    while len(source) > 0:
+        if source[0] == "\t":
+            source = source[1:]
+            continue
+
+        if source[0] == "\n":
+            lineno += 1
+            source = source[1:]
 
-            if source[0] == "\n":
-                lineno += 1
+            for i in range(indent_level):
+                if source[0] == "\t":
+                    source = source[1:]
+                else:
+                    break
+
+            continue
+
+        if message is None:
+            # non-whitespace character while not reading a message --> start of new message
+            directive = ""
+            while source[0] != "{":
+                if source[0] == "\n":
+                    lineno += 1
+                elif source[0] == " ":
+                    pass
+                else:
+                    directive += source[0]
                 source = source[1:]
 
-                for i in range(indent_level):
-                    if source[0] == "\t":
-                        source = source[1:]
-                    else:
-                        break
+            directive = directive.split(":")
+
+            if directive[0] != "#message":
+                print(f"{filename}:{lineno}: expected #message directive")
+                exit(1)
+            if is_output_format_c:
+                if len(directive) != 2:
+                    print(f"{filename}:{lineno}: expected #message:NAME directive")
+                    exit(1)
+
+                message = Message(directive[1], None, None)
+            else:
+                if len(directive) != 3:
+                    print(f"{filename}:{lineno}: expected #message:SECTION:INDEX directive")
+                    exit(1)
 
-                continue
+                section = int(directive[1], 16)
+
+                if directive[2].startswith("(") and directive[2].endswith(")"):
+                    name = directive[2][1:-1]
+                    index = None
+                else:
+                    name = None
+                    index = int(directive[2], 16)
 
-            if message is None:
-                # non-whitespace character while not reading a message --> start of new message
                 directive = ""
-                while source[0] != "{":
-                    if source[0] == "\n":
-                        lineno += 1
-                    elif source[0] == " ":
-                        pass
-                    else:
-                        directive += source[0]
-                    source = source[1:]
 
-                directive = directive.split(":")
+                message = Message(name, section, index)
+            messages.append(message)
+
+            if version == "jp":
+                charset = CHARSET_KANA
+            elif version == "ique":
+                charset = CHARSET_IQUE
+            else:
+                charset = CHARSET_STANDARD
+
+            while source[0] != "{":
+                source = source[1:]
 
-                if directive[0] != "#message":
-                    print(f"{filename}:{lineno}: expected #message directive")
+                if source[0] == "\n":
+                    lineno += 1
+                elif source[0] == "\r":
+                    pass
+                elif source[0] == "{":
+                    break
+                elif source[0] != " " and source[0] != "\t":
+                    print(f"{filename}:{lineno}: expected opening brace ('{{')")
                     exit(1)
-                if is_output_format_c:
-                    if len(directive) != 2:
-                        print(f"{filename}:{lineno}: expected #message:NAME directive")
+
+            source = source[1:]  # {
+
+            # count indent level
+            indent_level = 0
+            """
+            while source[0] == " " or source[0] == "\t" or source[0] == "\n" or source[0] == "\r":
+                if source[0] == " " or source[0] == "\t":
+                    indent_level += 1
+                source = source[1:]
+            """
+        else:
+            command, args, named_args, source = parse_command(source)
+
+            if command:
+                if command == "end":
+                    message.bytes += [0xFD]
+                    explicit_end = True
+                elif command == "raw":
+                    message.bytes += [*args]
+                elif command == "br":
+                    message.bytes += [0xF0]
+                elif command == "wait":
+                    message.bytes += [0xF1]
+                elif command == "pause":
+                    if len(args) != 1:
+                        print(f"{filename}:{lineno}: {command} command requires 1 parameter")
                         exit(1)
 
-                    message = Message(directive[1], None, None)
-                else:
-                    if len(directive) != 3:
-                        print(f"{filename}:{lineno}: expected #message:SECTION:INDEX directive")
+                    message.bytes += [0xF2, args[0]]
+                elif command == "next":
+                    message.bytes += [0xFB]
+                elif command == "yield":
+                    message.bytes += [0xFF, 0x04]
+                elif command == "savecolor":
+                    message.bytes += [0xFF, 0x24]
+                elif command == "restorecolor":
+                    message.bytes += [0xFF, 0x25]
+                elif command == "color":
+                    if len(args) != 1:
+                        print(f"{filename}:{lineno}: color command requires 1 parameter")
                         exit(1)
 
-                    section = int(directive[1], 16)
+                    color = color_to_code(args[0], style)
+
+                    if color is None:
+                        print(f"{filename}:{lineno}: unknown color")
+                        exit(1)
 
-                    if directive[2].startswith("(") and directive[2].endswith(")"):
-                        name = directive[2][1:-1]
-                        index = None
+                    message.bytes += [0xFF, 0x05, color]
+                    # color_stack.append(color)
+                # elif command == "/color":
+                #    color_stack.pop()
+                #    message.bytes += [0xFF, 0x05, color_stack[0]]
+                elif command == "style":
+                    message.bytes += [0xFC]
+
+                    style = args[0]
+                    args = args[1:]
+                    if type(style) is int:
+                        message.bytes += [style, *args]
                     else:
-                        name = None
-                        index = int(directive[2], 16)
+                        if style == "right":
+                            message.bytes += [0x01]
+                        elif style == "left":
+                            message.bytes += [0x02]
+                        elif style == "center":
+                            message.bytes += [0x03]
+                        elif style == "tattle":
+                            message.bytes += [0x04]
+                        elif style == "choice":
+                            pos = named_args.get("pos")
 
-                    directive = ""
+                            if not isinstance(pos, list) or len(pos) != 2:
+                                print(f"{filename}:{lineno}: 'choice' style requires pos=_,_")
+                                exit(1)
 
-                    message = Message(name, section, index)
-                messages.append(message)
+                            size = named_args.get("size")
 
-                if version == "jp":
-                    charset = CHARSET_KANA
-                elif version == "ique":
-                    charset = CHARSET_IQUE
-                else:
-                    charset = CHARSET_STANDARD
+                            if not isinstance(size, list) or len(size) != 2:
+                                print(f"{filename}:{lineno}: 'choice' style requires size=_,_")
+                                exit(1)
 
-                while source[0] != "{":
-                    source = source[1:]
+                            message.bytes += [
+                                0x05,
+                                pos[0],
+                                pos[1],
+                                size[0],
+                                size[1],
+                            ]
+                        elif style == "inspect":
+                            message.bytes += [0x06]
+                        elif style == "sign":
+                            message.bytes += [0x07]
+                        elif style == "lamppost":
+                            height = named_args.get("height")
 
-                    if source[0] == "\n":
-                        lineno += 1
-                    elif source[0] == "\r":
-                        pass
-                    elif source[0] == "{":
-                        break
-                    elif source[0] != " " and source[0] != "\t":
-                        print(f"{filename}:{lineno}: expected opening brace ('{{')")
-                        exit(1)
+                            if not isinstance(height, int):
+                                print(f"{filename}:{lineno}: 'lamppost' style requires height=_")
+                                exit(1)
 
-                source = source[1:]  # {
+                            message.bytes += [0x08, height]
+                        elif style == "postcard":
+                            index = named_args.get("index")
 
-                # count indent level
-                indent_level = 0
-                """
-                while source[0] == " " or source[0] == "\t" or source[0] == "\n" or source[0] == "\r":
-                    if source[0] == " " or source[0] == "\t":
-                        indent_level += 1
-                    source = source[1:]
-                """
-            else:
-                command, args, named_args, source = parse_command(source)
-
-                if command:
-                    if command == "end":
-                        message.bytes += [0xFD]
-                        explicit_end = True
-                    elif command == "raw":
-                        message.bytes += [*args]
-                    elif command == "br":
-                        message.bytes += [0xF0]
-                    elif command == "wait":
-                        message.bytes += [0xF1]
-                    elif command == "pause":
-                        if len(args) != 1:
-                            print(f"{filename}:{lineno}: {command} command requires 1 parameter")
-                            exit(1)
+                            if not isinstance(index, int):
+                                print(f"{filename}:{lineno}: 'postcard' style requires index=_")
+                                exit(1)
 
-                        message.bytes += [0xF2, args[0]]
-                    elif command == "next":
-                        message.bytes += [0xFB]
-                    elif command == "yield":
-                        message.bytes += [0xFF, 0x04]
-                    elif command == "savecolor":
-                        message.bytes += [0xFF, 0x24]
-                    elif command == "restorecolor":
-                        message.bytes += [0xFF, 0x25]
-                    elif command == "color":
-                        if len(args) != 1:
-                            print(f"{filename}:{lineno}: color command requires 1 parameter")
-                            exit(1)
+                            message.bytes += [0x09, index]
+                        elif style == "popup":
+                            message.bytes += [0x0A]
+                        elif style == "popup2":
+                            message.bytes += [0x0B]
+                        elif style == "upgrade":
+                            pos = named_args.get("pos")
 
-                        color = color_to_code(args[0], style)
+                            if not isinstance(pos, list) or len(pos) != 2:
+                                print(f"{filename}:{lineno}: 'upgrade' style requires pos=_,_")
+                                exit(1)
 
-                        if color is None:
-                            print(f"{filename}:{lineno}: unknown color")
-                            exit(1)
+                            size = named_args.get("size")
 
-                        message.bytes += [0xFF, 0x05, color]
-                        # color_stack.append(color)
-                    # elif command == "/color":
-                    #    color_stack.pop()
-                    #    message.bytes += [0xFF, 0x05, color_stack[0]]
-                    elif command == "style":
-                        message.bytes += [0xFC]
-
-                        style = args[0]
-                        args = args[1:]
-                        if type(style) is int:
-                            message.bytes += [style, *args]
-                        else:
-                            if style == "right":
-                                message.bytes += [0x01]
-                            elif style == "left":
-                                message.bytes += [0x02]
-                            elif style == "center":
-                                message.bytes += [0x03]
-                            elif style == "tattle":
-                                message.bytes += [0x04]
-                            elif style == "choice":
-                                pos = named_args.get("pos")
-
-                                if not isinstance(pos, list) or len(pos) != 2:
-                                    print(f"{filename}:{lineno}: 'choice' style requires pos=_,_")
-                                    exit(1)
-
-                                size = named_args.get("size")
-
-                                if not isinstance(size, list) or len(size) != 2:
-                                    print(f"{filename}:{lineno}: 'choice' style requires size=_,_")
-                                    exit(1)
-
-                                message.bytes += [
-                                    0x05,
-                                    pos[0],
-                                    pos[1],
-                                    size[0],
-                                    size[1],
-                                ]
-                            elif style == "inspect":
-                                message.bytes += [0x06]
-                            elif style == "sign":
-                                message.bytes += [0x07]
-                            elif style == "lamppost":
-                                height = named_args.get("height")
-
-                                if not isinstance(height, int):
-                                    print(f"{filename}:{lineno}: 'lamppost' style requires height=_")
-                                    exit(1)
-
-                                message.bytes += [0x08, height]
-                            elif style == "postcard":
-                                index = named_args.get("index")
-
-                                if not isinstance(index, int):
-                                    print(f"{filename}:{lineno}: 'postcard' style requires index=_")
-                                    exit(1)
-
-                                message.bytes += [0x09, index]
-                            elif style == "popup":
-                                message.bytes += [0x0A]
-                            elif style == "popup2":
-                                message.bytes += [0x0B]
-                            elif style == "upgrade":
-                                pos = named_args.get("pos")
-
-                                if not isinstance(pos, list) or len(pos) != 2:
-                                    print(f"{filename}:{lineno}: 'upgrade' style requires pos=_,_")
-                                    exit(1)
-
-                                size = named_args.get("size")
-
-                                if not isinstance(size, list) or len(size) != 2:
-                                    print(f"{filename}:{lineno}: 'upgrade' style requires size=_,_")
-                                    exit(1)
-
-                                message.bytes += [
-                                    0x0C,
-                                    pos[0],
-                                    pos[1],
-                                    size[0],
-                                    size[1],
-                                ]
-                            elif style == "narrate":
-                                message.bytes += [0x0D]
-                            elif style == "epilogue":
-                                message.bytes += [0x0E]
-                    elif command == "font":
-                        if len(args) != 1:
-                            print(f"{filename}:{lineno}: font command requires 1 parameter")
-                            exit(1)
+                            if not isinstance(size, list) or len(size) != 2:
+                                print(f"{filename}:{lineno}: 'upgrade' style requires size=_,_")
+                                exit(1)
 
-                        font = args[0]
-
-                        if font == "standard":
-                            font = 0
-                        elif font == "menu":
-                            font = 1
-                        elif font == "menu2":
-                            font = 2
-                        elif font == "title":
-                            font = 3
-                        elif font == "subtitle":
-                            font = 4
-
-                        if type(font) is not int:
-                            print(f"{filename}:{lineno}: unknown font '{font}'")
-                            exit(1)
+                            message.bytes += [
+                                0x0C,
+                                pos[0],
+                                pos[1],
+                                size[0],
+                                size[1],
+                            ]
+                        elif style == "narrate":
+                            message.bytes += [0x0D]
+                        elif style == "epilogue":
+                            message.bytes += [0x0E]
+                elif command == "font":
+                    if len(args) != 1:
+                        print(f"{filename}:{lineno}: font command requires 1 parameter")
+                        exit(1)
+
+                    font = args[0]
+
+                    if font == "standard":
+                        font = 0
+                    elif font == "menu":
+                        font = 1
+                    elif font == "menu2":
+                        font = 2
+                    elif font == "title":
+                        font = 3
+                    elif font == "subtitle":
+                        font = 4
+
+                    if type(font) is not int:
+                        print(f"{filename}:{lineno}: unknown font '{font}'")
+                        exit(1)
 
-                        message.bytes += [0xFF, 0x00, font]
-                        # font_stack.append(font)
+                    message.bytes += [0xFF, 0x00, font]
+                    # font_stack.append(font)
 
-                        if font == 3 or font == 4:
-                            charset = CHARSET_CREDITS
+                    if font == 3 or font == 4:
+                        charset = CHARSET_CREDITS
+                    else:
+                        if version == "jp":
+                            charset = CHARSET_KANA
+                        elif version == "ique":
+                            charset = CHARSET_IQUE
                         else:
-                            if version == "jp":
-                                charset = CHARSET_KANA
-                            elif version == "ique":
-                                charset = CHARSET_IQUE
-                            else:
-                                charset = CHARSET_STANDARD
-                    # elif command == "/font":
-                    #     font_stack.pop()
-                    #     message.bytes += [0xFF, 0x00, font_stack[0]]
-
-                    #     if font == 3 or font == 4:
-                    #         charset = CHARSET_CREDITS
-                    #     else:
-                    #         charset = CHARSET
-                    elif command == "charset":
-                        if version != "jp":
-                            print(f"{filename}:{lineno}: charset command is only supported in the JP version")
-                            exit(1)
+                            charset = CHARSET_STANDARD
+                # elif command == "/font":
+                #     font_stack.pop()
+                #     message.bytes += [0xFF, 0x00, font_stack[0]]
+
+                #     if font == 3 or font == 4:
+                #         charset = CHARSET_CREDITS
+                #     else:
+                #         charset = CHARSET
+                elif command == "charset":
+                    if version != "jp":
+                        print(f"{filename}:{lineno}: charset command is only supported in the JP version")
+                        exit(1)
 
-                        if len(args) != 1:
-                            print(f"{filename}:{lineno}: charset command requires 1 parameter")
-                            exit(1)
+                    if len(args) != 1:
+                        print(f"{filename}:{lineno}: charset command requires 1 parameter")
+                        exit(1)
 
-                        arg_charset = args[0]
+                    arg_charset = args[0]
 
-                        if arg_charset == "kana":
-                            arg_charset = 0
-                        elif arg_charset == "latin":
-                            arg_charset = 1
-                        elif arg_charset == "kanji":
-                            arg_charset = 2
-                        elif arg_charset == "buttons":
-                            arg_charset = 3
+                    if arg_charset == "kana":
+                        arg_charset = 0
+                    elif arg_charset == "latin":
+                        arg_charset = 1
+                    elif arg_charset == "kanji":
+                        arg_charset = 2
+                    elif arg_charset == "buttons":
+                        arg_charset = 3
 
-                        if type(arg_charset) is not int:
-                            print(f"{filename}:{lineno}: unknown charset '{arg_charset}'")
-                            exit(1)
+                    if type(arg_charset) is not int:
+                        print(f"{filename}:{lineno}: unknown charset '{arg_charset}'")
+                        exit(1)
 
-                        message.bytes += [0xF3 + arg_charset]
+                    message.bytes += [0xF3 + arg_charset]
+
+                    if arg_charset == 0:
+                        charset = CHARSET_KANA
+                    elif arg_charset == 1:
+                        charset = CHARSET_LATIN
+                    elif arg_charset == 2:
+                        charset = CHARSET_KANJI
+                    elif arg_charset == 3:
+                        charset = CHARSET_BUTTONS
+
+                elif command == "inputoff":
+                    message.bytes += [0xFF, 0x07]
+                elif command == "inputon":
+                    message.bytes += [0xFF, 0x08]
+                elif command == "delayoff":
+                    message.bytes += [0xFF, 0x09]
+                elif command == "delayon":
+                    message.bytes += [0xFF, 0x0A]
+                elif command == "charwidth":
+                    if len(args) != 1:
+                        print(f"{filename}:{lineno}: {command} command requires 1 parameter")
+                        exit(1)
 
-                        if arg_charset == 0:
-                            charset = CHARSET_KANA
-                        elif arg_charset == 1:
-                            charset = CHARSET_LATIN
-                        elif arg_charset == 2:
-                            charset = CHARSET_KANJI
-                        elif arg_charset == 3:
-                            charset = CHARSET_BUTTONS
-
-                    elif command == "inputoff":
-                        message.bytes += [0xFF, 0x07]
-                    elif command == "inputon":
-                        message.bytes += [0xFF, 0x08]
-                    elif command == "delayoff":
-                        message.bytes += [0xFF, 0x09]
-                    elif command == "delayon":
-                        message.bytes += [0xFF, 0x0A]
-                    elif command == "charwidth":
-                        if len(args) != 1:
-                            print(f"{filename}:{lineno}: {command} command requires 1 parameter")
-                            exit(1)
+                    message.bytes += [0xFF, 0x0B, args[0]]
+                elif command == "scroll":
+                    if len(args) != 1:
+                        print(f"{filename}:{lineno}: {command} command requires 1 parameter")
+                        exit(1)
 
-                        message.bytes += [0xFF, 0x0B, args[0]]
-                    elif command == "scroll":
-                        if len(args) != 1:
-                            print(f"{filename}:{lineno}: {command} command requires 1 parameter")
-                            exit(1)
+                    message.bytes += [0xFF, 0x0C, args[0]]
+                elif command == "size":
+                    args = args[0]
+
+                    if len(args) == 1:
+                        args.append(args[0])
 
-                        message.bytes += [0xFF, 0x0C, args[0]]
-                    elif command == "size":
-                        args = args[0]
+                    if len(args) != 2:
+                        print(f"{filename}:{lineno}: {command} command requires 2 parameters")
+                        exit(1)
 
-                        if len(args) == 1:
-                            args.append(args[0])
+                    message.bytes += [0xFF, 0x0D, args[0], args[1]]
+                elif command == "sizereset":
+                    message.bytes += [0xFF, 0x0E]
+                elif command == "speed":
+                    delay = named_args.get("delay")
 
-                        if len(args) != 2:
-                            print(f"{filename}:{lineno}: {command} command requires 2 parameters")
-                            exit(1)
+                    if not isinstance(delay, int):
+                        print(f"{filename}:{lineno}: {command} command requires delay=_")
+                        exit(1)
 
-                        message.bytes += [0xFF, 0x0D, args[0], args[1]]
-                    elif command == "sizereset":
-                        message.bytes += [0xFF, 0x0E]
-                    elif command == "speed":
-                        delay = named_args.get("delay")
+                    chars = named_args.get("chars")
 
-                        if not isinstance(delay, int):
-                            print(f"{filename}:{lineno}: {command} command requires delay=_")
-                            exit(1)
+                    if not isinstance(delay, int):
+                        print(f"{filename}:{lineno}: {command} command requires chars=_")
+                        exit(1)
 
-                        chars = named_args.get("chars")
+                    message.bytes += [0xFF, 0x0F, delay, chars]
+                # elif command == "pos":
+                #     if "y" not in named_args:
+                #         print(f"{filename}:{lineno}: pos command requires parameter: y (x is optional)")
+                #         exit(1)
+
+                #     if "x" in named_args:
+                #         message.bytes += [0xFF, 0x10, named_args["x"], named_args["y"]]
+                #     else:
+                #         message.bytes += [0xFF, 0x11, named_args["y"]]
+                elif command == "setposx":
+                    if len(args) != 1:
+                        print(f"{filename}:{lineno}: {command} command requires 1 parameter")
+                        exit(1)
 
-                        if not isinstance(delay, int):
-                            print(f"{filename}:{lineno}: {command} command requires chars=_")
-                            exit(1)
+                    message.bytes += [0xFF, 0x10, args[0] >> 8, args[0] & 0xFF]
+                elif command == "setposy":
+                    if len(args) != 1:
+                        print(f"{filename}:{lineno}: {command} command requires 1 parameter")
+                        exit(1)
 
-                        message.bytes += [0xFF, 0x0F, delay, chars]
-                    # elif command == "pos":
-                    #     if "y" not in named_args:
-                    #         print(f"{filename}:{lineno}: pos command requires parameter: y (x is optional)")
-                    #         exit(1)
-
-                    #     if "x" in named_args:
-                    #         message.bytes += [0xFF, 0x10, named_args["x"], named_args["y"]]
-                    #     else:
-                    #         message.bytes += [0xFF, 0x11, named_args["y"]]
-                    elif command == "setposx":
+                    message.bytes += [0xFF, 0x11, *args]
+                elif command == "right":
+                    if len(args) == 0:
+                        if version == "jp":
+                            charset_byte, charset = check_if_correct_charset("[right]", charset, filename, lineno)
+                            if charset_byte != -1:
+                                message.bytes += [0xF3 + charset_byte]
+                            message.bytes += [0xB4]
+                        else:
+                            message.bytes += [0x95]
+                    else:
                         if len(args) != 1:
                             print(f"{filename}:{lineno}: {command} command requires 1 parameter")
                             exit(1)
 
-                        message.bytes += [0xFF, 0x10, args[0] >> 8, args[0] & 0xFF]
-                    elif command == "setposy":
+                        message.bytes += [0xFF, 0x12, args[0]]
+                elif command == "down":
+                    if len(args) == 0:
+                        if version == "jp":
+                            charset_byte, charset = check_if_correct_charset("[down]", charset, filename, lineno)
+                            if charset_byte != -1:
+                                message.bytes += [0xF3 + charset_byte]
+                            message.bytes += [0xB2]
+                        else:
+                            message.bytes += [0x93]
+                    else:
                         if len(args) != 1:
                             print(f"{filename}:{lineno}: {command} command requires 1 parameter")
                             exit(1)
 
-                        message.bytes += [0xFF, 0x11, *args]
-                    elif command == "right":
-                        if len(args) == 0:
-                            if version == "jp":
-                                charset_byte, charset = check_if_correct_charset("[right]", charset, filename, lineno)
-                                if charset_byte != -1:
-                                    message.bytes += [0xF3 + charset_byte]
-                                message.bytes += [0xB4]
-                            else:
-                                message.bytes += [0x95]
+                        message.bytes += [0xFF, 0x13, args[0]]
+                elif command == "up":
+                    if len(args) == 0:
+                        if version == "jp":
+                            charset_byte, charset = check_if_correct_charset("[up]", charset, filename, lineno)
+                            if charset_byte != -1:
+                                message.bytes += [0xF3 + charset_byte]
+                            message.bytes += [0xB1]
                         else:
-                            if len(args) != 1:
-                                print(f"{filename}:{lineno}: {command} command requires 1 parameter")
-                                exit(1)
+                            message.bytes += [0x92]
+                    else:
+                        if len(args) != 1:
+                            print(f"{filename}:{lineno}: {command} command requires 1 parameter")
+                            exit(1)
 
-                            message.bytes += [0xFF, 0x12, args[0]]
-                    elif command == "down":
-                        if len(args) == 0:
-                            if version == "jp":
-                                charset_byte, charset = check_if_correct_charset("[down]", charset, filename, lineno)
-                                if charset_byte != -1:
-                                    message.bytes += [0xF3 + charset_byte]
-                                message.bytes += [0xB2]
-                            else:
-                                message.bytes += [0x93]
-                        else:
-                            if len(args) != 1:
-                                print(f"{filename}:{lineno}: {command} command requires 1 parameter")
-                                exit(1)
+                        message.bytes += [0xFF, 0x14, args[0]]
+                elif command == "inlineimage":
+                    index = named_args.get("index")
 
-                            message.bytes += [0xFF, 0x13, args[0]]
-                    elif command == "up":
-                        if len(args) == 0:
-                            if version == "jp":
-                                charset_byte, charset = check_if_correct_charset("[up]", charset, filename, lineno)
-                                if charset_byte != -1:
-                                    message.bytes += [0xF3 + charset_byte]
-                                message.bytes += [0xB1]
-                            else:
-                                message.bytes += [0x92]
-                        else:
-                            if len(args) != 1:
-                                print(f"{filename}:{lineno}: {command} command requires 1 parameter")
-                                exit(1)
+                    if not isinstance(index, int):
+                        print(f"{filename}:{lineno}: {command} command requires index=_")
+                        exit(1)
 
-                            message.bytes += [0xFF, 0x14, args[0]]
-                    elif command == "inlineimage":
-                        index = named_args.get("index")
+                    message.bytes += [0xFF, 0x15, index]
+                elif command == "animsprite":
+                    spriteid = named_args.get("spriteid")
+                    raster = named_args.get("raster")
 
-                        if not isinstance(index, int):
-                            print(f"{filename}:{lineno}: {command} command requires index=_")
-                            exit(1)
+                    # TODO: named sprite id and raster
 
-                        message.bytes += [0xFF, 0x15, index]
-                    elif command == "animsprite":
-                        spriteid = named_args.get("spriteid")
-                        raster = named_args.get("raster")
+                    if not isinstance(spriteid, int):
+                        print(f"{filename}:{lineno}: {command} command requires spriteid=_")
+                        exit(1)
+                    if not isinstance(raster, int):
+                        print(f"{filename}:{lineno}: {command} command requires raster=_")
+                        exit(1)
 
-                        # TODO: named sprite id and raster
+                    message.bytes += [
+                        0xFF,
+                        0x16,
+                        spriteid >> 8,
+                        spriteid & 0xFF,
+                        raster,
+                    ]
+                elif command == "itemicon":
+                    itemid = named_args.get("itemid")
 
-                        if not isinstance(spriteid, int):
-                            print(f"{filename}:{lineno}: {command} command requires spriteid=_")
-                            exit(1)
-                        if not isinstance(raster, int):
-                            print(f"{filename}:{lineno}: {command} command requires raster=_")
-                            exit(1)
+                    # TODO: itemname
 
-                        message.bytes += [
-                            0xFF,
-                            0x16,
-                            spriteid >> 8,
-                            spriteid & 0xFF,
-                            raster,
-                        ]
-                    elif command == "itemicon":
-                        itemid = named_args.get("itemid")
+                    if not isinstance(itemid, int):
+                        print(f"{filename}:{lineno}: {command} command requires itemid=_")
+                        exit(1)
 
-                        # TODO: itemname
+                    message.bytes += [0xFF, 0x17, itemid >> 8, itemid & 0xFF]
+                elif command == "image":
+                    index = named_args.get("index")
+                    pos = named_args.get("pos")  # xx,y
+                    hasborder = named_args.get("hasborder")
+                    alpha = named_args.get("alpha")
+                    fadeamount = named_args.get("fadeamount")
 
-                        if not isinstance(itemid, int):
-                            print(f"{filename}:{lineno}: {command} command requires itemid=_")
-                            exit(1)
+                    if not isinstance(index, int):
+                        print(f"{filename}:{lineno}: {command} command requires index=_")
+                        exit(1)
+                    if not isinstance(pos, list) or len(pos) != 2:
+                        print(f"{filename}:{lineno}: {command} command requires pos=_,_")
+                        exit(1)
+                    if not isinstance(hasborder, int):
+                        print(f"{filename}:{lineno}: {command} command requires hasborder=_")
+                        exit(1)
+                    if not isinstance(alpha, int):
+                        print(f"{filename}:{lineno}: {command} command requires alpha=_")
+                        exit(1)
+                    if not isinstance(fadeamount, int):
+                        print(f"{filename}:{lineno}: {command} command requires fadeamount=_")
+                        exit(1)
 
-                        message.bytes += [0xFF, 0x17, itemid >> 8, itemid & 0xFF]
-                    elif command == "image":
-                        index = named_args.get("index")
-                        pos = named_args.get("pos")  # xx,y
-                        hasborder = named_args.get("hasborder")
-                        alpha = named_args.get("alpha")
-                        fadeamount = named_args.get("fadeamount")
+                    message.bytes += [
+                        0xFF,
+                        0x18,
+                        index,
+                        pos[0] >> 8,
+                        pos[0] & 0xFF,
+                        pos[1],
+                        hasborder,
+                        alpha,
+                        fadeamount,
+                    ]
+                elif command == "hideimage":
+                    fadeamount = named_args.get("fadeamount", 0)
+
+                    if not isinstance(fadeamount, int):
+                        print(f"{filename}:{lineno}: {command} command requires fadeamount=_")
+                        exit(1)
 
-                        if not isinstance(index, int):
-                            print(f"{filename}:{lineno}: {command} command requires index=_")
-                            exit(1)
-                        if not isinstance(pos, list) or len(pos) != 2:
-                            print(f"{filename}:{lineno}: {command} command requires pos=_,_")
-                            exit(1)
-                        if not isinstance(hasborder, int):
-                            print(f"{filename}:{lineno}: {command} command requires hasborder=_")
-                            exit(1)
-                        if not isinstance(alpha, int):
-                            print(f"{filename}:{lineno}: {command} command requires alpha=_")
-                            exit(1)
-                        if not isinstance(fadeamount, int):
-                            print(f"{filename}:{lineno}: {command} command requires fadeamount=_")
-                            exit(1)
+                    message.bytes += [0xFF, 0x19, fadeamount]
+                elif command == "animdelay":
+                    index = named_args.get("index")
+                    delay = named_args.get("delay")
 
-                        message.bytes += [
-                            0xFF,
-                            0x18,
-                            index,
-                            pos[0] >> 8,
-                            pos[0] & 0xFF,
-                            pos[1],
-                            hasborder,
-                            alpha,
-                            fadeamount,
-                        ]
-                    elif command == "hideimage":
-                        fadeamount = named_args.get("fadeamount", 0)
+                    if not isinstance(index, int):
+                        print(f"{filename}:{lineno}: {command} command requires index=_")
+                        exit(1)
+                    if not isinstance(delay, int):
+                        print(f"{filename}:{lineno}: {command} command requires delay=_")
+                        exit(1)
 
-                        if not isinstance(fadeamount, int):
-                            print(f"{filename}:{lineno}: {command} command requires fadeamount=_")
-                            exit(1)
+                    message.bytes += [0xFF, 0x1A, 0, index, delay]
+                elif command == "animloop":
+                    if len(args) != 2:
+                        print(f"{filename}:{lineno}: {command} command requires 2 parameters")
+                        exit(1)
+                    message.bytes += [0xFF, 0x1B, args[0], args[1]]
+                elif command == "animdone":
+                    if len(args) != 1:
+                        print(f"{filename}:{lineno}: {command} command requires 1 parameter")
+                        exit(1)
+                    message.bytes += [0xFF, 0x1C, args[0]]
+                elif command == "setcursorpos":
+                    index = named_args.get("index")
+                    pos = named_args.get("pos")
 
-                        message.bytes += [0xFF, 0x19, fadeamount]
-                    elif command == "animdelay":
-                        index = named_args.get("index")
-                        delay = named_args.get("delay")
+                    if not isinstance(index, int):
+                        print(f"{filename}:{lineno}: {command} command requires index=_")
+                        exit(1)
+                    if not isinstance(pos, list) or len(pos) != 2:
+                        print(f"{filename}:{lineno}: {command} command requires pos=_,_")
+                        exit(1)
 
-                        if not isinstance(index, int):
-                            print(f"{filename}:{lineno}: {command} command requires index=_")
-                            exit(1)
-                        if not isinstance(delay, int):
-                            print(f"{filename}:{lineno}: {command} command requires delay=_")
-                            exit(1)
+                    message.bytes += [0xFF, 0x1D, index, pos, pos]
+                elif command == "cursor":
+                    if len(args) != 1:
+                        print(f"{filename}:{lineno}: cursor command requires 1 parameter")
+                        exit(1)
 
-                        message.bytes += [0xFF, 0x1A, 0, index, delay]
-                    elif command == "animloop":
-                        if len(args) != 2:
-                            print(f"{filename}:{lineno}: {command} command requires 2 parameters")
-                            exit(1)
-                        message.bytes += [0xFF, 0x1B, args[0], args[1]]
-                    elif command == "animdone":
-                        if len(args) != 1:
-                            print(f"{filename}:{lineno}: {command} command requires 1 parameter")
-                            exit(1)
-                        message.bytes += [0xFF, 0x1C, args[0]]
-                    elif command == "setcursorpos":
-                        index = named_args.get("index")
-                        pos = named_args.get("pos")
+                    message.bytes += [0xFF, 0x1E, *args]
+                elif command == "option" and choiceindex == -1:
+                    if len(args) != 1:
+                        print(f"{filename}:{lineno}: option command requires 1 parameter")
+                        exit(1)
 
-                        if not isinstance(index, int):
-                            print(f"{filename}:{lineno}: {command} command requires index=_")
-                            exit(1)
-                        if not isinstance(pos, list) or len(pos) != 2:
-                            print(f"{filename}:{lineno}: {command} command requires pos=_,_")
-                            exit(1)
+                    message.bytes += [0xFF, 0x21, *args]
+                elif command == "endchoice" and choiceindex == -1:
+                    if len(args) != 1:
+                        print(f"{filename}:{lineno}: {command} command requires 1 parameter")
+                        exit(1)
 
-                        message.bytes += [0xFF, 0x1D, index, pos, pos]
-                    elif command == "cursor":
-                        if len(args) != 1:
-                            print(f"{filename}:{lineno}: cursor command requires 1 parameter")
-                            exit(1)
+                    message.bytes += [0xFF, 0x1F, args[0]]
+                elif command == "setcancel":
+                    if len(args) != 1:
+                        print(f"{filename}:{lineno}: {command} command requires 1 parameter")
+                        exit(1)
 
-                        message.bytes += [0xFF, 0x1E, *args]
-                    elif command == "option" and choiceindex == -1:
-                        if len(args) != 1:
-                            print(f"{filename}:{lineno}: option command requires 1 parameter")
-                            exit(1)
+                    message.bytes += [0xFF, 0x20, args[0]]
+                # elif command == "startfx":
+                #     message.bytes += [0xFF, 0x26, resolve_effect(args[0]), *args[1:]]
+                # elif command == "endfx":
+                #     message.bytes += [0xFF, 0x27, resolve_effect(args[0]), *args[1:]]
+                elif command == "/fx":
+                    message.bytes += [0xFF, 0x27, fx_stack.pop()]
+                elif command == "shake":
+                    fx_stack.append(0x00)
+                    message.bytes += [0xFF, 0x26, 0x00]
+                elif command == "/shake":
+                    fx_stack.pop()
+                    message.bytes += [0xFF, 0x27, 0x00]
+                elif command == "wave":
+                    fx_stack.append(0x01)
+                    message.bytes += [0xFF, 0x26, 0x01]
+                elif command == "/wave":
+                    fx_stack.pop()
+                    message.bytes += [0xFF, 0x27, 0x01]
+                elif command == "noiseoutline":
+                    fx_stack.append(0x02)
+                    message.bytes += [0xFF, 0x26, 0x02]
+                elif command == "/noiseoutline":
+                    fx_stack.pop()
+                    message.bytes += [0xFF, 0x27, 0x02]
+                elif command == "static":
+                    if len(args) != 1:
+                        print(f"{filename}:{lineno}: {command} command requires 1 parameter")
+                        exit(1)
 
-                        message.bytes += [0xFF, 0x21, *args]
-                    elif command == "endchoice" and choiceindex == -1:
-                        if len(args) != 1:
-                            print(f"{filename}:{lineno}: {command} command requires 1 parameter")
-                            exit(1)
+                    fx_stack.append(0x03)
+                    message.bytes += [0xFF, 0x26, 0x03, args[0]]
+                elif command == "/static":
+                    fx_stack.pop()
+                    message.bytes += [0xFF, 0x27, 0x03]
+                elif command == "blur":
+                    _dir = named_args.get("dir")
+
+                    if _dir == "x":
+                        _dir = 0
+                    elif _dir == "y":
+                        _dir = 1
+                    elif _dir == "xy":
+                        _dir = 2
+
+                    if not isinstance(_dir, int):
+                        print(f"{filename}:{lineno}: {command} command requires dir=_")
+                        exit(1)
 
-                        message.bytes += [0xFF, 0x1F, args[0]]
-                    elif command == "setcancel":
-                        if len(args) != 1:
-                            print(f"{filename}:{lineno}: {command} command requires 1 parameter")
-                            exit(1)
+                    fx_stack.append(0x05)
+                    message.bytes += [0xFF, 0x26, 0x05, _dir]
+                elif command == "/blur":
+                    fx_stack.pop()
+                    message.bytes += [0xFF, 0x27, 0x05]
+                elif command == "rainbow":
+                    fx_stack.append(0x06)
+                    message.bytes += [0xFF, 0x26, 0x06]
+                elif command == "/rainbow":
+                    fx_stack.pop()
+                    message.bytes += [0xFF, 0x27, 0x06]
+                elif command == "ditherfade":
+                    if len(args) != 1:
+                        print(f"{filename}:{lineno}: {command} command requires 1 parameter")
+                        exit(1)
 
-                        message.bytes += [0xFF, 0x20, args[0]]
-                    # elif command == "startfx":
-                    #     message.bytes += [0xFF, 0x26, resolve_effect(args[0]), *args[1:]]
-                    # elif command == "endfx":
-                    #     message.bytes += [0xFF, 0x27, resolve_effect(args[0]), *args[1:]]
-                    elif command == "/fx":
-                        message.bytes += [0xFF, 0x27, fx_stack.pop()]
-                    elif command == "shake":
-                        fx_stack.append(0x00)
-                        message.bytes += [0xFF, 0x26, 0x00]
-                    elif command == "/shake":
-                        fx_stack.pop()
-                        message.bytes += [0xFF, 0x27, 0x00]
-                    elif command == "wave":
-                        fx_stack.append(0x01)
-                        message.bytes += [0xFF, 0x26, 0x01]
-                    elif command == "/wave":
-                        fx_stack.pop()
-                        message.bytes += [0xFF, 0x27, 0x01]
-                    elif command == "noiseoutline":
-                        fx_stack.append(0x02)
-                        message.bytes += [0xFF, 0x26, 0x02]
-                    elif command == "/noiseoutline":
-                        fx_stack.pop()
-                        message.bytes += [0xFF, 0x27, 0x02]
-                    elif command == "static":
-                        if len(args) != 1:
-                            print(f"{filename}:{lineno}: {command} command requires 1 parameter")
-                            exit(1)
+                    fx_stack.append(0x07)
+                    message.bytes += [0xFF, 0x26, 0x07, args[0]]
+                elif command == "/ditherfade":
+                    fx_stack.pop()
+                    message.bytes += [0xFF, 0x27, 0x07]
+                elif command == "printrising":
+                    fx_stack.append(0x0A)
+                    message.bytes += [0xFF, 0x26, 0x0A]
+                elif command == "/printrising":
+                    fx_stack.pop()
+                    message.bytes += [0xFF, 0x27, 0x0A]
+                elif command == "printgrowing":
+                    fx_stack.append(0x0B)
+                    message.bytes += [0xFF, 0x26, 0x0B]
+                elif command == "/printgrowing":
+                    fx_stack.pop()
+                    message.bytes += [0xFF, 0x27, 0x0B]
+                elif command == "sizejitter":
+                    fx_stack.append(0x0C)
+                    message.bytes += [0xFF, 0x26, 0x0C]
+                elif command == "/sizejitter":
+                    fx_stack.pop()
+                    message.bytes += [0xFF, 0x27, 0x0C]
+                elif command == "sizewave":
+                    fx_stack.append(0x0D)
+                    message.bytes += [0xFF, 0x26, 0x0D]
+                elif command == "/sizewave":
+                    fx_stack.pop()
+                    message.bytes += [0xFF, 0x27, 0x0D]
+                elif command == "dropshadow":
+                    fx_stack.append(0x0E)
+                    message.bytes += [0xFF, 0x26, 0x0E]
+                elif command == "/dropshadow":
+                    fx_stack.pop()
+                    message.bytes += [0xFF, 0x27, 0x0E]
+                elif command == "var":
+                    if len(args) != 1:
+                        print(f"{filename}:{lineno}: var command requires 1 parameter")
+                        exit(1)
 
-                        fx_stack.append(0x03)
-                        message.bytes += [0xFF, 0x26, 0x03, args[0]]
-                    elif command == "/static":
-                        fx_stack.pop()
-                        message.bytes += [0xFF, 0x27, 0x03]
-                    elif command == "blur":
-                        _dir = named_args.get("dir")
-
-                        if _dir == "x":
-                            _dir = 0
-                        elif _dir == "y":
-                            _dir = 1
-                        elif _dir == "xy":
-                            _dir = 2
-
-                        if not isinstance(_dir, int):
-                            print(f"{filename}:{lineno}: {command} command requires dir=_")
-                            exit(1)
+                    message.bytes += [0xFF, 0x28, *args]
+                elif command == "centerx":
+                    if len(args) != 1:
+                        print(f"{filename}:{lineno}: {command} command requires 1 parameter")
+                        exit(1)
 
-                        fx_stack.append(0x05)
-                        message.bytes += [0xFF, 0x26, 0x05, _dir]
-                    elif command == "/blur":
-                        fx_stack.pop()
-                        message.bytes += [0xFF, 0x27, 0x05]
-                    elif command == "rainbow":
-                        fx_stack.append(0x06)
-                        message.bytes += [0xFF, 0x26, 0x06]
-                    elif command == "/rainbow":
-                        fx_stack.pop()
-                        message.bytes += [0xFF, 0x27, 0x06]
-                    elif command == "ditherfade":
-                        if len(args) != 1:
-                            print(f"{filename}:{lineno}: {command} command requires 1 parameter")
-                            exit(1)
+                    message.bytes += [0xFF, 0x29, *args]
+                elif command == "rewindoff":
+                    message.bytes += [0xFF, 0x2A, 0]
+                elif command == "rewindon":
+                    message.bytes += [0xFF, 0x2A, 1]
+                elif command == "customvoice":
+                    soundids = named_args.get("soundids")
 
-                        fx_stack.append(0x07)
-                        message.bytes += [0xFF, 0x26, 0x07, args[0]]
-                    elif command == "/ditherfade":
-                        fx_stack.pop()
-                        message.bytes += [0xFF, 0x27, 0x07]
-                    elif command == "printrising":
-                        fx_stack.append(0x0A)
-                        message.bytes += [0xFF, 0x26, 0x0A]
-                    elif command == "/printrising":
-                        fx_stack.pop()
-                        message.bytes += [0xFF, 0x27, 0x0A]
-                    elif command == "printgrowing":
-                        fx_stack.append(0x0B)
-                        message.bytes += [0xFF, 0x26, 0x0B]
-                    elif command == "/printgrowing":
-                        fx_stack.pop()
-                        message.bytes += [0xFF, 0x27, 0x0B]
-                    elif command == "sizejitter":
-                        fx_stack.append(0x0C)
-                        message.bytes += [0xFF, 0x26, 0x0C]
-                    elif command == "/sizejitter":
-                        fx_stack.pop()
-                        message.bytes += [0xFF, 0x27, 0x0C]
-                    elif command == "sizewave":
-                        fx_stack.append(0x0D)
-                        message.bytes += [0xFF, 0x26, 0x0D]
-                    elif command == "/sizewave":
-                        fx_stack.pop()
-                        message.bytes += [0xFF, 0x27, 0x0D]
-                    elif command == "dropshadow":
-                        fx_stack.append(0x0E)
-                        message.bytes += [0xFF, 0x26, 0x0E]
-                    elif command == "/dropshadow":
-                        fx_stack.pop()
-                        message.bytes += [0xFF, 0x27, 0x0E]
-                    elif command == "var":
-                        if len(args) != 1:
-                            print(f"{filename}:{lineno}: var command requires 1 parameter")
-                            exit(1)
+                    if not isinstance(soundids, list) or len(pos) != 2:
+                        print(f"{filename}:{lineno}: {command} command requires soundids=_,_")
+                        exit(1)
 
-                        message.bytes += [0xFF, 0x28, *args]
-                    elif command == "centerx":
-                        if len(args) != 1:
-                            print(f"{filename}:{lineno}: {command} command requires 1 parameter")
-                            exit(1)
+                    message.bytes += [
+                        0xFF,
+                        0x2C,
+                        soundids[0] >> 24,
+                        (soundids[0] >> 16) & 0xFF,
+                        (soundids[0] >> 8) & 0xFF,
+                        soundids[0] & 0xFF,
+                        soundids[1] >> 24,
+                        (soundids[1] >> 16) & 0xFF,
+                        (soundids[1] >> 8) & 0xFF,
+                        soundids[1] & 0xFF,
+                    ]
+                elif command == "volume":
+                    if len(args) != 1:
+                        print(f"{filename}:{lineno}: {command} command requires 1 parameter")
+                        exit(1)
+
+                    message.bytes += [0xFF, 0x2E, *args]
+                elif command == "voice":
+                    if len(args) != 1:
+                        print(f"{filename}:{lineno}: {command} command requires 1 parameter")
+                        exit(1)
 
-                        message.bytes += [0xFF, 0x29, *args]
-                    elif command == "rewindoff":
-                        message.bytes += [0xFF, 0x2A, 0]
-                    elif command == "rewindon":
-                        message.bytes += [0xFF, 0x2A, 1]
-                    elif command == "customvoice":
-                        soundids = named_args.get("soundids")
+                    sound = args[0]
 
-                        if not isinstance(soundids, list) or len(pos) != 2:
-                            print(f"{filename}:{lineno}: {command} command requires soundids=_,_")
-                            exit(1)
+                    if sound == "normal":
+                        sound = 0
+                    elif sound == "bowser":
+                        sound = 1
+                    elif sound == "star" or sound == "spirit":
+                        sound = 2
+
+                    if type(sound) is not int:
+                        print(f"{filename}:{lineno}: unknown voice '{sound}'")
+                        exit(1)
 
+                    message.bytes += [0xFF, 0x2F, sound]
+                    # sound_stack.append(sound)
+                # elif command == "/sound":
+                #     sound_stack.pop()
+                #     message.bytes += [0xFF, 0x2F, sound_stack[0]]
+                elif command == "a":
+                    color_code = color_to_code("blue", "button")
+                    assert color_code is not None
+                    if version == "jp":
                         message.bytes += [
                             0xFF,
-                            0x2C,
-                            soundids[0] >> 24,
-                            (soundids[0] >> 16) & 0xFF,
-                            (soundids[0] >> 8) & 0xFF,
-                            soundids[0] & 0xFF,
-                            soundids[1] >> 24,
-                            (soundids[1] >> 16) & 0xFF,
-                            (soundids[1] >> 8) & 0xFF,
-                            soundids[1] & 0xFF,
+                            0x24,
+                            0xFF,
+                            0x05,
+                            color_code,
+                            0xF6,
+                            0x00,
+                            0xFF,
+                            0x25,
                         ]
-                    elif command == "volume":
-                        if len(args) != 1:
-                            print(f"{filename}:{lineno}: {command} command requires 1 parameter")
-                            exit(1)
-
-                        message.bytes += [0xFF, 0x2E, *args]
-                    elif command == "voice":
-                        if len(args) != 1:
-                            print(f"{filename}:{lineno}: {command} command requires 1 parameter")
-                            exit(1)
-
-                        sound = args[0]
-
-                        if sound == "normal":
-                            sound = 0
-                        elif sound == "bowser":
-                            sound = 1
-                        elif sound == "star" or sound == "spirit":
-                            sound = 2
-
-                        if type(sound) is not int:
-                            print(f"{filename}:{lineno}: unknown voice '{sound}'")
-                            exit(1)
-
-                        message.bytes += [0xFF, 0x2F, sound]
-                        # sound_stack.append(sound)
-                    # elif command == "/sound":
-                    #     sound_stack.pop()
-                    #     message.bytes += [0xFF, 0x2F, sound_stack[0]]
-                    elif command == "a":
-                        color_code = color_to_code("blue", "button")
-                        assert color_code is not None
-                        if version == "jp":
-                            message.bytes += [
-                                0xFF,
-                                0x24,
-                                0xFF,
-                                0x05,
-                                color_code,
-                                0xF6,
-                                0x00,
-                                0xFF,
-                                0x25,
-                            ]
-                        else:
-                            message.bytes += [
-                                0xFF,
-                                0x24,
-                                0xFF,
-                                0x05,
-                                color_code,
-                                0x98,
-                                0xFF,
-                                0x25,
-                            ]
-                    elif command == "b":
-                        color_code = color_to_code(
-                            named_args.get("color", "green"),
-                            named_args.get("ctx", "button"),
-                        )
-                        assert color_code is not None
-                        if version == "jp":
-                            message.bytes += [
-                                0xFF,
-                                0x24,
-                                0xFF,
-                                0x05,
-                                color_code,
-                                0xF6,
-                                0x01,
-                                0xFF,
-                                0x25,
-                            ]
-                        else:
-                            message.bytes += [
-                                0xFF,
-                                0x24,
-                                0xFF,
-                                0x05,
-                                color_code,
-                                0x99,
-                                0xFF,
-                                0x25,
-                            ]
-                    elif command == "l":
-                        color_code = color_to_code(
-                            named_args.get("color", "gray"),
-                            named_args.get("ctx", "button"),
-                        )
-                        assert color_code is not None
-                        if version == "jp":
-                            message.bytes += [
-                                0xFF,
-                                0x24,
-                                0xFF,
-                                0x05,
-                                color_code,
-                                0xF6,
-                                0x08,
-                                0xFF,
-                                0x25,
-                            ]
-                        else:
-                            message.bytes += [
-                                0xFF,
-                                0x24,
-                                0xFF,
-                                0x05,
-                                color_code,
-                                0x9A,
-                                0xFF,
-                                0x25,
-                            ]
-                    elif command == "r":
-                        color_code = color_to_code(
-                            named_args.get("color", "gray"),
-                            named_args.get("ctx", "button"),
-                        )
-                        assert color_code is not None
-                        if version == "jp":
-                            message.bytes += [
-                                0xFF,
-                                0x24,
-                                0xFF,
-                                0x05,
-                                color_code,
-                                0xF6,
-                                0x09,
-                                0xFF,
-                                0x25,
-                            ]
-                        else:
-                            message.bytes += [
-                                0xFF,
-                                0x24,
-                                0xFF,
-                                0x05,
-                                color_code,
-                                0x9B,
-                                0xFF,
-                                0x25,
-                            ]
-                    elif command == "z":
-                        color_code = color_to_code("grey", "button")
-                        assert color_code is not None
-                        if version == "jp":
-                            message.bytes += [
-                                0xFF,
-                                0x24,
-                                0xFF,
-                                0x05,
-                                color_code,
-                                0xF6,
-                                0x07,
-                                0xFF,
-                                0x25,
-                            ]
-                        else:
-                            message.bytes += [
-                                0xFF,
-                                0x24,
-                                0xFF,
-                                0x05,
-                                color_code,
-                                0x9C,
-                                0xFF,
-                                0x25,
-                            ]
-                    elif command == "c-up":
-                        color_code = color_to_code(
-                            named_args.get("color", "yellow"),
-                            named_args.get("ctx", "button"),
-                        )
-                        assert color_code is not None
-                        if version == "jp":
-                            message.bytes += [
-                                0xFF,
-                                0x24,
-                                0xFF,
-                                0x05,
-                                color_code,
-                                0xF6,
-                                0x03,
-                                0xFF,
-                                0x25,
-                            ]
-                        else:
-                            message.bytes += [
-                                0xFF,
-                                0x24,
-                                0xFF,
-                                0x05,
-                                color_code,
-                                0x9D,
-                                0xFF,
-                                0x25,
-                            ]
-                    elif command == "c-down":
-                        color_code = color_to_code(
-                            named_args.get("color", "yellow"),
-                            named_args.get("ctx", "button"),
-                        )
-                        assert color_code is not None
-                        if version == "jp":
-                            message.bytes += [
-                                0xFF,
-                                0x24,
-                                0xFF,
-                                0x05,
-                                color_code,
-                                0xF6,
-                                0x04,
-                                0xFF,
-                                0x25,
-                            ]
-                        else:
-                            message.bytes += [
-                                0xFF,
-                                0x24,
-                                0xFF,
-                                0x05,
-                                color_code,
-                                0x9E,
-                                0xFF,
-                                0x25,
-                            ]
-                    elif command == "c-left":
-                        color_code = color_to_code(
-                            named_args.get("color", "yellow"),
-                            named_args.get("ctx", "button"),
-                        )
-                        assert color_code is not None
-                        if version == "jp":
-                            message.bytes += [
-                                0xFF,
-                                0x24,
-                                0xFF,
-                                0x05,
-                                color_code,
-                                0xF6,
-                                0x05,
-                                0xFF,
-                                0x25,
-                            ]
-                        else:
-                            message.bytes += [
-                                0xFF,
-                                0x24,
-                                0xFF,
-                                0x05,
-                                color_code,
-                                0x9F,
-                                0xFF,
-                                0x25,
-                            ]
-                    elif command == "c-right":
-                        color_code = color_to_code(
-                            named_args.get("color", "yellow"),
-                            named_args.get("ctx", "button"),
-                        )
-                        assert color_code is not None
-                        if version == "jp":
-                            message.bytes += [
-                                0xFF,
-                                0x24,
-                                0xFF,
-                                0x05,
-                                color_code,
-                                0xF6,
-                                0x06,
-                                0xFF,
-                                0x25,
-                            ]
-                        else:
-                            message.bytes += [
-                                0xFF,
-                                0x24,
-                                0xFF,
-                                0x05,
-                                color_code,
-                                0xA0,
-                                0xFF,
-                                0x25,
-                            ]
-                    elif command == "start":
-                        color_code = color_to_code(
-                            named_args.get("color", "red"),
-                            named_args.get("ctx", "button"),
-                        )  #
-                        assert color_code is not None
-                        if version == "jp":
-                            message.bytes += [
-                                0xFF,
-                                0x24,
-                                0xFF,
-                                0x05,
-                                color_code,
-                                0xF6,
-                                0x02,
-                                0xFF,
-                                0x25,
-                            ]
-                        else:
-                            message.bytes += [
-                                0xFF,
-                                0x24,
-                                0xFF,
-                                0x05,
-                                color_code,
-                                0xA1,
-                                0xFF,
-                                0x25,
-                            ]
-                    elif command == "~a":
-                        if version == "jp":
-                            charset_byte, charset = check_if_correct_charset("[~a]", charset, filename, lineno)
-                            if charset_byte != -1:
-                                message.bytes += [0xF3 + charset_byte]
-                            message.bytes += [0x00]
-                        else:
-                            message.bytes += [0x98]
-                    elif command == "~b":
-                        if version == "jp":
-                            charset_byte, charset = check_if_correct_charset("[~b]", charset, filename, lineno)
-                            if charset_byte != -1:
-                                message.bytes += [0xF3 + charset_byte]
-                            message.bytes += [0x01]
-                        else:
-                            message.bytes += [0x99]
-                    elif command == "~l":
-                        if version == "jp":
-                            charset_byte, charset = check_if_correct_charset("[~l]", charset, filename, lineno)
-                            if charset_byte != -1:
-                                message.bytes += [0xF3 + charset_byte]
-                            message.bytes += [0x08]
-                        else:
-                            message.bytes += [0x9A]
-                    elif command == "~r":
-                        if version == "jp":
-                            charset_byte, charset = check_if_correct_charset("[~r]", charset, filename, lineno)
-                            if charset_byte != -1:
-                                message.bytes += [0xF3 + charset_byte]
-                            message.bytes += [0x09]
-                        else:
-                            message.bytes += [0x9B]
-                    elif command == "~z":
-                        if version == "jp":
-                            charset_byte, charset = check_if_correct_charset("[~z]", charset, filename, lineno)
-                            if charset_byte != -1:
-                                message.bytes += [0xF3 + charset_byte]
-                            message.bytes += [0x07]
-                        else:
-                            message.bytes += [0x9C]
-                    elif command == "~c-up":
-                        if version == "jp":
-                            charset_byte, charset = check_if_correct_charset("[~c-up]", charset, filename, lineno)
-                            if charset_byte != -1:
-                                message.bytes += [0xF3 + charset_byte]
-                            message.bytes += [0x03]
-                        else:
-                            message.bytes += [0x9D]
-                    elif command == "~c-down":
-                        if version == "jp":
-                            charset_byte, charset = check_if_correct_charset("[~c-down]", charset, filename, lineno)
-                            if charset_byte != -1:
-                                message.bytes += [0xF3 + charset_byte]
-                            message.bytes += [0x04]
-                        else:
-                            message.bytes += [0x9E]
-                    elif command == "~c-left":
-                        if version == "jp":
-                            charset_byte, charset = check_if_correct_charset("[~c-left]", charset, filename, lineno)
-                            if charset_byte != -1:
-                                message.bytes += [0xF3 + charset_byte]
-                            message.bytes += [0x05]
-                        else:
-                            message.bytes += [0x9F]
-                    elif command == "~c-right":
-                        if version == "jp":
-                            charset_byte, charset = check_if_correct_charset("[~c-right]", charset, filename, lineno)
-                            if charset_byte != -1:
-                                message.bytes += [0xF3 + charset_byte]
-                            message.bytes += [0x06]
-                        else:
-                            message.bytes += [0xA0]
-                    elif command == "~start":
-                        if version == "jp":
-                            charset_byte, charset = check_if_correct_charset("[~start]", charset, filename, lineno)
-                            if charset_byte != -1:
-                                message.bytes += [0xF3 + charset_byte]
-                            message.bytes += [0x02]
-                        else:
-                            message.bytes += [0xA1]
-                    elif command == "note":
-                        if version == "jp":
-                            charset_byte, charset = check_if_correct_charset("[note]", charset, filename, lineno)
-                            if charset_byte != -1:
-                                message.bytes += [0xF3 + charset_byte]
-                            message.bytes += [0x6A]
-                        else:
-                            message.bytes += [0x00]
-                    elif command == "heart":
-                        if version == "jp":
-                            charset_byte, charset = check_if_correct_charset("[heart]", charset, filename, lineno)
-                            if charset_byte != -1:
-                                message.bytes += [0xF3 + charset_byte]
-                            message.bytes += [0xBD]
-                        else:
-                            message.bytes += [0x90]
-                    elif command == "star":
-                        if version == "jp":
-                            charset_byte, charset = check_if_correct_charset("[star]", charset, filename, lineno)
-                            if charset_byte != -1:
-                                message.bytes += [0xF3 + charset_byte]
-                            message.bytes += [0xBE]
-                        else:
-                            message.bytes += [0x91]
-                    elif command == "left":
-                        if version == "jp":
-                            charset_byte, charset = check_if_correct_charset("[left]", charset, filename, lineno)
-                            if charset_byte != -1:
-                                message.bytes += [0xF3 + charset_byte]
-                            message.bytes += [0xB3]
-                        else:
-                            message.bytes += [0x94]
-                    elif command == "circle":
-                        if version == "jp":
-                            charset_byte, charset = check_if_correct_charset("[circle]", charset, filename, lineno)
-                            if charset_byte != -1:
-                                message.bytes += [0xF3 + charset_byte]
-                            message.bytes += [0x61]
-                        else:
-                            message.bytes += [0x96]
-                    elif command == "cross":
-                        if version == "jp":
-                            charset_byte, charset = check_if_correct_charset("[cross]", charset, filename, lineno)
-                            if charset_byte != -1:
-                                message.bytes += [0xF3 + charset_byte]
-                            message.bytes += [0x62]
-                        else:
-                            message.bytes += [0x97]
-                    elif command == "katakana":
-                        if version != "jp":
-                            print(f"{filename}:{lineno}: Command katakana is only supported in the JP version")
-                            exit(1)
+                    else:
+                        message.bytes += [
+                            0xFF,
+                            0x24,
+                            0xFF,
+                            0x05,
+                            color_code,
+                            0x98,
+                            0xFF,
+                            0x25,
+                        ]
+                elif command == "b":
+                    color_code = color_to_code(
+                        named_args.get("color", "green"),
+                        named_args.get("ctx", "button"),
+                    )
+                    assert color_code is not None
+                    if version == "jp":
+                        message.bytes += [
+                            0xFF,
+                            0x24,
+                            0xFF,
+                            0x05,
+                            color_code,
+                            0xF6,
+                            0x01,
+                            0xFF,
+                            0x25,
+                        ]
+                    else:
+                        message.bytes += [
+                            0xFF,
+                            0x24,
+                            0xFF,
+                            0x05,
+                            color_code,
+                            0x99,
+                            0xFF,
+                            0x25,
+                        ]
+                elif command == "l":
+                    color_code = color_to_code(
+                        named_args.get("color", "gray"),
+                        named_args.get("ctx", "button"),
+                    )
+                    assert color_code is not None
+                    if version == "jp":
+                        message.bytes += [
+                            0xFF,
+                            0x24,
+                            0xFF,
+                            0x05,
+                            color_code,
+                            0xF6,
+                            0x08,
+                            0xFF,
+                            0x25,
+                        ]
+                    else:
+                        message.bytes += [
+                            0xFF,
+                            0x24,
+                            0xFF,
+                            0x05,
+                            color_code,
+                            0x9A,
+                            0xFF,
+                            0x25,
+                        ]
+                elif command == "r":
+                    color_code = color_to_code(
+                        named_args.get("color", "gray"),
+                        named_args.get("ctx", "button"),
+                    )
+                    assert color_code is not None
+                    if version == "jp":
+                        message.bytes += [
+                            0xFF,
+                            0x24,
+                            0xFF,
+                            0x05,
+                            color_code,
+                            0xF6,
+                            0x09,
+                            0xFF,
+                            0x25,
+                        ]
+                    else:
+                        message.bytes += [
+                            0xFF,
+                            0x24,
+                            0xFF,
+                            0x05,
+                            color_code,
+                            0x9B,
+                            0xFF,
+                            0x25,
+                        ]
+                elif command == "z":
+                    color_code = color_to_code("grey", "button")
+                    assert color_code is not None
+                    if version == "jp":
+                        message.bytes += [
+                            0xFF,
+                            0x24,
+                            0xFF,
+                            0x05,
+                            color_code,
+                            0xF6,
+                            0x07,
+                            0xFF,
+                            0x25,
+                        ]
+                    else:
+                        message.bytes += [
+                            0xFF,
+                            0x24,
+                            0xFF,
+                            0x05,
+                            color_code,
+                            0x9C,
+                            0xFF,
+                            0x25,
+                        ]
+                elif command == "c-up":
+                    color_code = color_to_code(
+                        named_args.get("color", "yellow"),
+                        named_args.get("ctx", "button"),
+                    )
+                    assert color_code is not None
+                    if version == "jp":
+                        message.bytes += [
+                            0xFF,
+                            0x24,
+                            0xFF,
+                            0x05,
+                            color_code,
+                            0xF6,
+                            0x03,
+                            0xFF,
+                            0x25,
+                        ]
+                    else:
+                        message.bytes += [
+                            0xFF,
+                            0x24,
+                            0xFF,
+                            0x05,
+                            color_code,
+                            0x9D,
+                            0xFF,
+                            0x25,
+                        ]
+                elif command == "c-down":
+                    color_code = color_to_code(
+                        named_args.get("color", "yellow"),
+                        named_args.get("ctx", "button"),
+                    )
+                    assert color_code is not None
+                    if version == "jp":
+                        message.bytes += [
+                            0xFF,
+                            0x24,
+                            0xFF,
+                            0x05,
+                            color_code,
+                            0xF6,
+                            0x04,
+                            0xFF,
+                            0x25,
+                        ]
+                    else:
+                        message.bytes += [
+                            0xFF,
+                            0x24,
+                            0xFF,
+                            0x05,
+                            color_code,
+                            0x9E,
+                            0xFF,
+                            0x25,
+                        ]
+                elif command == "c-left":
+                    color_code = color_to_code(
+                        named_args.get("color", "yellow"),
+                        named_args.get("ctx", "button"),
+                    )
+                    assert color_code is not None
+                    if version == "jp":
+                        message.bytes += [
+                            0xFF,
+                            0x24,
+                            0xFF,
+                            0x05,
+                            color_code,
+                            0xF6,
+                            0x05,
+                            0xFF,
+                            0x25,
+                        ]
+                    else:
+                        message.bytes += [
+                            0xFF,
+                            0x24,
+                            0xFF,
+                            0x05,
+                            color_code,
+                            0x9F,
+                            0xFF,
+                            0x25,
+                        ]
+                elif command == "c-right":
+                    color_code = color_to_code(
+                        named_args.get("color", "yellow"),
+                        named_args.get("ctx", "button"),
+                    )
+                    assert color_code is not None
+                    if version == "jp":
+                        message.bytes += [
+                            0xFF,
+                            0x24,
+                            0xFF,
+                            0x05,
+                            color_code,
+                            0xF6,
+                            0x06,
+                            0xFF,
+                            0x25,
+                        ]
+                    else:
+                        message.bytes += [
+                            0xFF,
+                            0x24,
+                            0xFF,
+                            0x05,
+                            color_code,
+                            0xA0,
+                            0xFF,
+                            0x25,
+                        ]
+                elif command == "start":
+                    color_code = color_to_code(
+                        named_args.get("color", "red"),
+                        named_args.get("ctx", "button"),
+                    )  #
+                    assert color_code is not None
+                    if version == "jp":
+                        message.bytes += [
+                            0xFF,
+                            0x24,
+                            0xFF,
+                            0x05,
+                            color_code,
+                            0xF6,
+                            0x02,
+                            0xFF,
+                            0x25,
+                        ]
+                    else:
+                        message.bytes += [
+                            0xFF,
+                            0x24,
+                            0xFF,
+                            0x05,
+                            color_code,
+                            0xA1,
+                            0xFF,
+                            0x25,
+                        ]
+                elif command == "~a":
+                    if version == "jp":
+                        charset_byte, charset = check_if_correct_charset("[~a]", charset, filename, lineno)
+                        if charset_byte != -1:
+                            message.bytes += [0xF3 + charset_byte]
+                        message.bytes += [0x00]
+                    else:
+                        message.bytes += [0x98]
+                elif command == "~b":
+                    if version == "jp":
+                        charset_byte, charset = check_if_correct_charset("[~b]", charset, filename, lineno)
+                        if charset_byte != -1:
+                            message.bytes += [0xF3 + charset_byte]
+                        message.bytes += [0x01]
+                    else:
+                        message.bytes += [0x99]
+                elif command == "~l":
+                    if version == "jp":
+                        charset_byte, charset = check_if_correct_charset("[~l]", charset, filename, lineno)
+                        if charset_byte != -1:
+                            message.bytes += [0xF3 + charset_byte]
+                        message.bytes += [0x08]
+                    else:
+                        message.bytes += [0x9A]
+                elif command == "~r":
+                    if version == "jp":
+                        charset_byte, charset = check_if_correct_charset("[~r]", charset, filename, lineno)
+                        if charset_byte != -1:
+                            message.bytes += [0xF3 + charset_byte]
+                        message.bytes += [0x09]
+                    else:
+                        message.bytes += [0x9B]
+                elif command == "~z":
+                    if version == "jp":
+                        charset_byte, charset = check_if_correct_charset("[~z]", charset, filename, lineno)
+                        if charset_byte != -1:
+                            message.bytes += [0xF3 + charset_byte]
+                        message.bytes += [0x07]
+                    else:
+                        message.bytes += [0x9C]
+                elif command == "~c-up":
+                    if version == "jp":
+                        charset_byte, charset = check_if_correct_charset("[~c-up]", charset, filename, lineno)
+                        if charset_byte != -1:
+                            message.bytes += [0xF3 + charset_byte]
+                        message.bytes += [0x03]
+                    else:
+                        message.bytes += [0x9D]
+                elif command == "~c-down":
+                    if version == "jp":
+                        charset_byte, charset = check_if_correct_charset("[~c-down]", charset, filename, lineno)
+                        if charset_byte != -1:
+                            message.bytes += [0xF3 + charset_byte]
+                        message.bytes += [0x04]
+                    else:
+                        message.bytes += [0x9E]
+                elif command == "~c-left":
+                    if version == "jp":
+                        charset_byte, charset = check_if_correct_charset("[~c-left]", charset, filename, lineno)
+                        if charset_byte != -1:
+                            message.bytes += [0xF3 + charset_byte]
+                        message.bytes += [0x05]
+                    else:
+                        message.bytes += [0x9F]
+                elif command == "~c-right":
+                    if version == "jp":
+                        charset_byte, charset = check_if_correct_charset("[~c-right]", charset, filename, lineno)
+                        if charset_byte != -1:
+                            message.bytes += [0xF3 + charset_byte]
+                        message.bytes += [0x06]
+                    else:
+                        message.bytes += [0xA0]
+                elif command == "~start":
+                    if version == "jp":
+                        charset_byte, charset = check_if_correct_charset("[~start]", charset, filename, lineno)
+                        if charset_byte != -1:
+                            message.bytes += [0xF3 + charset_byte]
+                        message.bytes += [0x02]
+                    else:
+                        message.bytes += [0xA1]
+                elif command == "note":
+                    if version == "jp":
+                        charset_byte, charset = check_if_correct_charset("[note]", charset, filename, lineno)
+                        if charset_byte != -1:
+                            message.bytes += [0xF3 + charset_byte]
+                        message.bytes += [0x6A]
+                    else:
+                        message.bytes += [0x00]
+                elif command == "heart":
+                    if version == "jp":
+                        charset_byte, charset = check_if_correct_charset("[heart]", charset, filename, lineno)
+                        if charset_byte != -1:
+                            message.bytes += [0xF3 + charset_byte]
+                        message.bytes += [0xBD]
+                    else:
+                        message.bytes += [0x90]
+                elif command == "star":
+                    if version == "jp":
+                        charset_byte, charset = check_if_correct_charset("[star]", charset, filename, lineno)
+                        if charset_byte != -1:
+                            message.bytes += [0xF3 + charset_byte]
+                        message.bytes += [0xBE]
+                    else:
+                        message.bytes += [0x91]
+                elif command == "left":
+                    if version == "jp":
+                        charset_byte, charset = check_if_correct_charset("[left]", charset, filename, lineno)
+                        if charset_byte != -1:
+                            message.bytes += [0xF3 + charset_byte]
+                        message.bytes += [0xB3]
+                    else:
+                        message.bytes += [0x94]
+                elif command == "circle":
+                    if version == "jp":
+                        charset_byte, charset = check_if_correct_charset("[circle]", charset, filename, lineno)
+                        if charset_byte != -1:
+                            message.bytes += [0xF3 + charset_byte]
+                        message.bytes += [0x61]
+                    else:
+                        message.bytes += [0x96]
+                elif command == "cross":
+                    if version == "jp":
+                        charset_byte, charset = check_if_correct_charset("[cross]", charset, filename, lineno)
+                        if charset_byte != -1:
+                            message.bytes += [0xF3 + charset_byte]
+                        message.bytes += [0x62]
+                    else:
+                        message.bytes += [0x97]
+                elif command == "katakana":
+                    if version != "jp":
+                        print(f"{filename}:{lineno}: Command katakana is only supported in the JP version")
+                        exit(1)
 
-                        kana_char = args[0]
+                    kana_char = args[0]
 
-                        if kana_char == "smalln":
-                            charset_byte, charset = check_if_correct_charset(
-                                "[katakana smalln]", charset, filename, lineno
-                            )
-                            if charset_byte != -1:
-                                message.bytes += [0xF3 + charset_byte]
-                            message.bytes += [0xC5]
-                        else:
-                            print(f"{filename}:{lineno}: Invalid or unimplemented katakana character name {kana_char}")
-                            exit(1)
-                    elif command == "hiragana":
-                        if version != "jp":
-                            print(f"{filename}:{lineno}: Command hiragana is only supported in the JP version")
-                            exit(1)
+                    if kana_char == "smalln":
+                        charset_byte, charset = check_if_correct_charset(
+                            "[katakana smalln]", charset, filename, lineno
+                        )
+                        if charset_byte != -1:
+                            message.bytes += [0xF3 + charset_byte]
+                        message.bytes += [0xC5]
+                    else:
+                        print(f"{filename}:{lineno}: Invalid or unimplemented katakana character name {kana_char}")
+                        exit(1)
+                elif command == "hiragana":
+                    if version != "jp":
+                        print(f"{filename}:{lineno}: Command hiragana is only supported in the JP version")
+                        exit(1)
 
-                        kana_char = args[0]
+                    kana_char = args[0]
 
-                        if kana_char == "smalln":
-                            charset_byte, charset = check_if_correct_charset(
-                                "[hiragana smalln]", charset, filename, lineno
-                            )
-                            if charset_byte != -1:
-                                message.bytes += [0xF3 + charset_byte]
-                            message.bytes += [0xC4]
-                        else:
-                            print(f"{filename}:{lineno}: Invalid or unimplemented hiragana character name {kana_char}")
-                            exit(1)
-                    elif command == "fullspace":
-                        message.bytes += [0xF8]
-                    elif command == "halfspace":
-                        message.bytes += [0xF9]
-                    elif command == "savepos":
-                        message.bytes += [0xFF, 0x22]
-                    elif command == "restorepos":
-                        message.bytes += [0xFF, 0x23]
-                    elif command == "enablecdownnext":
-                        message.bytes += [0xFF, 0x2B]
-                    elif command == "beginchoice":
-                        choiceindex = 0
-                        message.bytes += [0xFF, 0x09]  # delayoff
-                    elif command == "option" and choiceindex >= 0:
-                        message.bytes += [0xFF, 0x1E, choiceindex]  # cursor n
-                        message.bytes += [0xFF, 0x21, choiceindex]  # option n
-                        choiceindex += 1
-                    elif command == "endchoice" and choiceindex >= 0:
-                        cancel = named_args.get("cancel")
-
-                        message.bytes += [0xFF, 0x21, 255]  # option 255
-                        message.bytes += [0xFF, 0x0A]  # delayon
-
-                        if isinstance(cancel, int):
-                            message.bytes += [0xFF, 0x20, cancel]  # setcancel n
-
-                        message.bytes += [0xFF, 0x1F, choiceindex]  # endchoice n
-
-                        choiceindex = -1
-                    elif command == "animation" and choiceindex >= 0:
-                        # TODO
-                        print(f"{filename}:{lineno}: '{command}' tag is not yet implemented")
-                        exit(1)
+                    if kana_char == "smalln":
+                        charset_byte, charset = check_if_correct_charset(
+                            "[hiragana smalln]", charset, filename, lineno
+                        )
+                        if charset_byte != -1:
+                            message.bytes += [0xF3 + charset_byte]
+                        message.bytes += [0xC4]
                     else:
-                        print(f"{filename}:{lineno}: unknown command '{command}'")
+                        print(f"{filename}:{lineno}: Invalid or unimplemented hiragana character name {kana_char}")
                         exit(1)
+                elif command == "fullspace":
+                    message.bytes += [0xF8]
+                elif command == "halfspace":
+                    message.bytes += [0xF9]
+                elif command == "savepos":
+                    message.bytes += [0xFF, 0x22]
+                elif command == "restorepos":
+                    message.bytes += [0xFF, 0x23]
+                elif command == "enablecdownnext":
+                    message.bytes += [0xFF, 0x2B]
+                elif command == "beginchoice":
+                    choiceindex = 0
+                    message.bytes += [0xFF, 0x09]  # delayoff
+                elif command == "option" and choiceindex >= 0:
+                    message.bytes += [0xFF, 0x1E, choiceindex]  # cursor n
+                    message.bytes += [0xFF, 0x21, choiceindex]  # option n
+                    choiceindex += 1
+                elif command == "endchoice" and choiceindex >= 0:
+                    cancel = named_args.get("cancel")
+
+                    message.bytes += [0xFF, 0x21, 255]  # option 255
+                    message.bytes += [0xFF, 0x0A]  # delayon
+
+                    if isinstance(cancel, int):
+                        message.bytes += [0xFF, 0x20, cancel]  # setcancel n
+
+                    message.bytes += [0xFF, 0x1F, choiceindex]  # endchoice n
+
+                    choiceindex = -1
+                elif command == "animation" and choiceindex >= 0:
+                    # TODO
+                    print(f"{filename}:{lineno}: '{command}' tag is not yet implemented")
+                    exit(1)
                 else:
-                    if source[0] == "}":
-                        if not explicit_end:
-                            print(f"{filename}:{lineno}: warning: string lacks an [end] command")
-                            # message.bytes += [0xFD]
-                        explicit_end = False
-
-                        # sanity check
-                        for b in message.bytes:
-                            if not isinstance(b, int):
-                                print(b)
-
-                        # padding
-                        while len(message.bytes) % 4 != 0:
-                            message.bytes += [0x00]
-
-                        message = None
-                        source = source[1:]  # }
-                        indent_level = 0
-                        choiceindex = -1
-                        continue
-
-                    if source[0] == "\\":
-                        source = source[1:]
+                    print(f"{filename}:{lineno}: unknown command '{command}'")
+                    exit(1)
+            else:
+                if source[0] == "}":
+                    if not explicit_end:
+                        print(f"{filename}:{lineno}: warning: string lacks an [end] command")
+                        # message.bytes += [0xFD]
+                    explicit_end = False
+
+                    # sanity check
+                    for b in message.bytes:
+                        if not isinstance(b, int):
+                            print(b)
+
+                    # padding
+                    while len(message.bytes) % 4 != 0:
+                        message.bytes += [0x00]
+
+                    message = None
+                    source = source[1:]  # }
+                    indent_level = 0
+                    choiceindex = -1
+                    continue
+
+                if source[0] == "\\":
+                    source = source[1:]
 
-                    if version == "jp" and charset is not CHARSET_CREDITS:
-                        charset_byte, charset = check_if_correct_charset(source[0], charset, filename, lineno)
-                        if charset_byte != -1:
-                            message.bytes += [0xF3 + charset_byte]
-                        elif (
-                            source[0] not in CHARSET_KANA
-                            and source[0] not in CHARSET_LATIN
-                            and source[0] not in CHARSET_KANJI
-                            and source[0] not in CHARSET_BUTTONS
-                        ):
-                            print(f"{filename}:{lineno}: unsupported character '{source[0]}' for current font")
-                            exit(1)
+                if version == "jp" and charset is not CHARSET_CREDITS:
+                    charset_byte, charset = check_if_correct_charset(source[0], charset, filename, lineno)
+                    if charset_byte != -1:
+                        message.bytes += [0xF3 + charset_byte]
+                    elif (
+                        source[0] not in CHARSET_KANA
+                        and source[0] not in CHARSET_LATIN
+                        and source[0] not in CHARSET_KANJI
+                        and source[0] not in CHARSET_BUTTONS
+                    ):
+                        print(f"{filename}:{lineno}: unsupported character '{source[0]}' for current font")
+                        exit(1)
 
+                    data = charset[source[0]]
+
+                    if type(data) is int:
+                        message.bytes.append(data)
+                    else:
+                        message.bytes += data
+
+                    source = source[1:]
+                else:
+                    if source[0] in charset:
                         data = charset[source[0]]
 
                         if type(data) is int:
@@ -4433,23 +4460,22 @@ if __name__ == "__main__":
 
                         source = source[1:]
                     else:
-                        if source[0] in charset:
-                            data = charset[source[0]]
+                        print(f"{filename}:{lineno}: unsupported character '{source[0]}' for current font")
+                        exit(1)
 
-                            if type(data) is int:
-                                message.bytes.append(data)
-                            else:
-                                message.bytes += data
+    if message != None:
+        print(f"{filename}: missing [end]")
+        exit(1)
+
+    return messages
 
-                            source = source[1:]
-                        else:
-                            print(f"{filename}:{lineno}: unsupported character '{source[0]}' for current font")
-                            exit(1)
 
-        if message != None:
-            print(f"{filename}: missing [end]")
-            exit(1)
+def compile_file(version: str, filename: str, is_output_format_c: bool) -> List[Message]:
+    with open(filename, "r") as f:
+        return compile_source(version, filename, f.read(), is_output_format_c)
+
 
+def write_output(messages: List[Message], outfile: str, is_output_format_c: bool):
     if is_output_format_c:
         with open(outfile, "w") as f:
             f.write(f"#include <ultra64.h>\n")
@@ -4462,15 +4488,31 @@ if __name__ == "__main__":
 
     else:
         with open(outfile, "wb") as f:
-            msgpack.pack(
-                [
-                    {
-                        "section": message.section,
-                        "index": message.index,
-                        "name": message.name,
-                        "bytes": bytes(message.bytes),
-                    }
-                    for message in messages
-                ],
-                f,
-            )
+            f.write(pack_messages(messages))
+
+
+def pack_messages(messages: List[Message]) -> bytes:
+    return msgpack.packb(
+        [
+            {
+                "section": message.section,
+                "index": message.index,
+                "name": message.name,
+                "bytes": bytes(message.bytes),
+            }
+            for message in messages
+        ]
+    )
+
+
+if __name__ == "__main__":
+    if len(argv) < 3:
+        print("usage: parse_compile.py [version] [in.msg] [out.msgpack] [--c]")
+        exit(1)
+
+    version = argv[1]
+    filename = argv[2]
+    outfile = argv[3]
+    is_output_format_c = "--c" in argv
+
+    write_output(compile_file(version, filename, is_output_format_c), outfile, is_output_format_c)
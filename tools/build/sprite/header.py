@@ -7,12 +7,12 @@ path.append(str(Path(__file__).parent.parent))
 
 from sprite.npc_sprite import from_dir as npc_from_dir
 
-if __name__ == "__main__":
-    if len(argv) < 4:
+def main(args):
+    if len(args) < 3:
         print("usage: header.py [OUT] [NAME] [ID]")
         exit(1)
 
-    _, outfile, sprite_name, s_in, asset_stack_raw = argv
+    outfile, sprite_name, s_in, asset_stack_raw = args
 
     asset_stack = tuple(Path(d) for d in asset_stack_raw.split(","))
 
@@ -56,3 +56,7 @@ if __name__ == "__main__":
             f.write("\n")
 
         f.write("#endif\n")
+
+
+if __name__ == "__main__":
+    main(argv[1:])
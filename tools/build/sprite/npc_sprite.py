@@ -1,10 +1,10 @@
 #!/usr/bin/env python3
 
-from math import floor
 from sys import argv, path
 from pathlib import Path
 from typing import List, Tuple
 import xml.etree.ElementTree as ET
+import numpy as np
 import png  # type: ignore
 
 path.append(str(Path(__file__).parent.parent))
@@ -12,7 +12,7 @@ path.append(str(Path(__file__).parent.parent.parent))
 path.append(str(Path(__file__).parent.parent.parent / "splat"))
 path.append(str(Path(__file__).parent.parent.parent / "splat_ext"))
 
-from common import get_asset_path, iter_in_groups
+from common import get_asset_path
 from splat_ext.pm_sprites import (
     MAX_COMPONENTS_XML,
     PALETTE_GROUPS_XML,
@@ -23,17 +23,17 @@ from splat_ext.pm_sprites import (
 from splat_ext.sprite_common import AnimComponent
 
 
-def pack_color(r, g, b, a):
-    r = floor(31 * (r / 255))
-    g = floor(31 * (g / 255))
-    b = floor(31 * (b / 255))
+def pack_colors(rgba: np.ndarray) -> bytes:
+    r = np.floor(31 * (rgba[:, 0] / 255)).astype(np.uint32)
+    g = np.floor(31 * (rgba[:, 1] / 255)).astype(np.uint32)
+    b = np.floor(31 * (rgba[:, 2] / 255)).astype(np.uint32)
 
-    s = round(a / 0xFF)
+    s = np.rint(rgba[:, 3] / 0xFF).astype(np.uint32)
     s |= (r & 0x1F) << 11
     s |= (g & 0x1F) << 6
     s |= (b & 0x1F) << 1
 
-    return s
+    return s.astype(">u2").tobytes()
 
 
 def resolve_image_path(
@@ -140,12 +140,12 @@ def from_dir(
     )
 
 
-if __name__ == "__main__":
-    if len(argv) != 4:
+def main(args):
+    if len(args) != 3:
         print("usage: sprite.py [OUTBIN] [SPRITE_NAME] [ASSET_STACK]")
         exit(1)
 
-    _, outfile, sprite_name, asset_stack_raw = argv
+    outfile, sprite_name, asset_stack_raw = args
 
     asset_stack = tuple(Path(d) for d in asset_stack_raw.split(","))
 
@@ -203,22 +203,20 @@ if __name__ == "__main__":
         palette_offsets: List[int] = []
         for i, palette in enumerate(sprite.palettes):
             palette_offsets.append(f.tell())
-            for rgba in palette:
-                if rgba[3] not in (0, 0xFF):
-                    print("error: translucent pixels not allowed in palette {sprite.palette_names[i]}")
-                    exit(1)
+            rgba = np.array(palette, dtype=np.uint32).reshape(-1, 4)
+            if np.any((rgba[:, 3] != 0) & (rgba[:, 3] != 0xFF)):
+                print("error: translucent pixels not allowed in palette {sprite.palette_names[i]}")
+                exit(1)
 
-                color = pack_color(*rgba)
-                f.write(color.to_bytes(2, byteorder="big"))
+            f.write(pack_colors(rgba))
 
         # write images/rasters
         image_offsets = []
         for image in sprite.images:
             offset = f.tell()
 
-            for a, b in iter_in_groups(image.raster, 2):
-                byte = (a << 4) | b
-                f.write(byte.to_bytes(1, byteorder="big"))
+            pairs = np.asarray(image.raster, dtype=np.uint8).reshape(-1, 2)
+            f.write(((pairs[:, 0] << 4) | pairs[:, 1]).tobytes())
 
             image_offsets.append(f.tell())
 
@@ -248,3 +246,7 @@ if __name__ == "__main__":
         animation_offsets.append(-1)
         for offset in animation_offsets:
             f.write(offset.to_bytes(4, byteorder="big", signed=True))
+
+
+if __name__ == "__main__":
+    main(argv[1:])
@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+
+# Content-addressed cache in front of `crunch64 compress yay0`. Compressed outputs are stored under the hash of their
+# input and the compressor version, so identical payloads (after a clean, a branch switch, or in another checkout
+# sharing the cache) are copied instead of recompressed. Each lookup is appended to a stats file, which is printed
+# and reset by `--stats` at the end of the build. `--stats` also evicts the least recently used entries once the cache
+# grows past MAX_CACHE_SIZE.
+
+import hashlib
+import os
+import shutil
+import subprocess
+from pathlib import Path
+from sys import argv, stderr
+
+CRUNCH64 = "crunch64"
+
+MAX_CACHE_SIZE = 256 * 1024 * 1024
+
+
+def record(stats_path: Path, result: str):
+    # a single short O_APPEND write, so parallel jobs don't interleave
+    fd = os.open(stats_path, os.O_WRONLY | os.O_APPEND | os.O_CREAT, 0o644)
+    try:
+        os.write(fd, (result + "\n").encode())
+    finally:
+        os.close(fd)
+
+
+def compress(in_path: Path, out_path: Path, cache_dir: Path, compressor_version: str, stats_path: Path):
+    digest = hashlib.sha256(compressor_version.encode())
+    digest.update(in_path.read_bytes())
+    key = digest.hexdigest()
+
+    cached_path = cache_dir / key[:2] / (key + ".Yay0")
+
+    try:
+        shutil.copyfile(cached_path, out_path)
+        # hits refresh the mtime, which is what eviction goes by
+        os.utime(cached_path)
+        record(stats_path, "hit")
+        return
+    except FileNotFoundError:
+        # not cached, or evicted by another build in the meantime
+        pass
+
+    subprocess.run([CRUNCH64, "compress", "yay0", str(in_path), str(out_path)], check=True)
+
+    # publish via rename so concurrent builds sharing the cache never see a partial file
+    cached_path.parent.mkdir(parents=True, exist_ok=True)
+    tmp_path = cached_path.with_suffix(f".{os.getpid()}.tmp")
+    shutil.copyfile(out_path, tmp_path)
+    os.replace(tmp_path, cached_path)
+    record(stats_path, "miss")
+
+
+def evict(cache_dir: Path):
+    entries = []
+    for path in cache_dir.glob("*/*.Yay0"):
+        try:
+            st = path.stat()
+        except FileNotFoundError:
+            continue
+        entries.append((st.st_mtime, st.st_size, path))
+
+    size = sum(entry[1] for entry in entries)
+    if size <= MAX_CACHE_SIZE:
+        return
+
+    entries.sort()
+    for _, entry_size, path in entries:
+        if size <= MAX_CACHE_SIZE:
+            break
+        path.unlink(missing_ok=True)
+        size -= entry_size
+
+
+def print_stats(stats_path: Path, out_path: Path, cache_dir: Path):
+    try:
+        results = stats_path.read_text().split()
+    except FileNotFoundError:
+        results = []
+
+    hits = results.count("hit")
+    misses = results.count("miss")
+    total = hits + misses
+
+    summary = ""
+    if total > 0:
+        summary = f"yay0 cache: {hits} hits, {misses} misses ({100 * hits / total:.1f}% hit rate)"
+        print(summary)
+
+    stats_path.unlink(missing_ok=True)
+    evict(cache_dir)
+
+    # the build edge's output, so ninja only reruns this after something was compressed again
+    out_path.write_text(summary + "\n")
+
+
+if __name__ == "__main__":
+    if len(argv) == 5 and argv[1] == "--stats":
+        print_stats(Path(argv[2]), Path(argv[3]), Path(argv[4]))
+        exit(0)
+
+    if len(argv) != 6:
+        print("usage: yay0_cache.py IN OUT CACHE_DIR COMPRESSOR_VERSION STATS_FILE", file=stderr)
+        print("       yay0_cache.py --stats STATS_FILE OUT CACHE_DIR", file=stderr)
+        exit(1)
+
+    _, in_path, out_path, cache_dir, compressor_version, stats_path = argv
+
+    compress(Path(in_path), Path(out_path), Path(cache_dir), compressor_version, Path(stats_path))
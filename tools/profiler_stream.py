@@ -0,0 +1,258 @@
+#!/usr/bin/env python3
+
+# Decodes a capture of the binary profiler stream (DX_PROFILER_STREAM in src/dx/config.h) written to the IS-Viewer.
+# Records may be interleaved with regular printf output; anything that isn't a valid record is skipped.
+
+import argparse
+import csv
+import struct
+import sys
+from dataclasses import dataclass
+from typing import Dict, Iterator, List
+
+MAGIC = b"PRF1"
+HEADER = struct.Struct(">4sHBBI")
+
+CPU_USEC_PER_CYCLE = 64 / 3000  # OS_CYCLES_TO_USEC
+RDP_USEC_PER_CLOCK = 10 / 625  # RDP_CYCLE_CONV
+
+# enum ProfilerTime with the default profiler configuration (GFX_PROFILING enabled, no PUPPYPRINT_DEBUG or
+# AUDIO_PROFILING). Streams with a different number of buckets get generic names.
+TIME_NAMES = [
+    "fps",
+    "controllers",
+    "workers",
+    "triggers",
+    "evt",
+    "messages",
+    "hud_elements",
+    "step_game_mode",
+    "entities",
+    "gfx_start",
+    "gfx_update",
+    "gfx_dummy",
+    "gfx_entities",
+    "gfx_models",
+    "gfx_player",
+    "gfx_npcs",
+    "gfx_workers",
+    "gfx_effects",
+    "gfx_render_tasks",
+    "gfx_hud_elements",
+    "gfx_back_ui",
+    "gfx_front_ui",
+    "gfx",
+    "audio",
+    "total",
+    "rsp_gfx",
+    "rsp_audio",
+    "rdp_tmem",
+    "rdp_pipe",
+    "rdp_cmd",
+    "world_encounters",
+    "world_npcs",
+    "world_player",
+    "world_item_entities",
+    "world_effects",
+    "world_cameras",
+]
+
+# enum ProfilerCounter
+COUNTER_NAMES = [
+    "audio_dma_hits",
+    "audio_dma_misses",
+    "audio_dma_loads",
+    "shading_cache_hits",
+    "shading_cache_misses",
+]
+
+RDP_TIMES = {"rdp_tmem", "rdp_pipe", "rdp_cmd"}
+
+# folded stack for each bucket, parents must come before their children
+FLAME_STACKS = {
+    "controllers": "cpu;controllers",
+    "workers": "cpu;workers",
+    "triggers": "cpu;triggers",
+    "evt": "cpu;evt",
+    "messages": "cpu;messages",
+    "hud_elements": "cpu;hud_elements",
+    "step_game_mode": "cpu;step_game_mode",
+    "world_encounters": "cpu;step_game_mode;encounters",
+    "world_npcs": "cpu;step_game_mode;npcs",
+    "world_player": "cpu;step_game_mode;player",
+    "world_item_entities": "cpu;step_game_mode;item_entities",
+    "world_effects": "cpu;step_game_mode;effects",
+    "world_cameras": "cpu;step_game_mode;cameras",
+    "entities": "cpu;entities",
+    "gfx": "cpu;gfx",
+    "gfx_update": "cpu;gfx;update",
+    "gfx_entities": "cpu;gfx;entities",
+    "gfx_models": "cpu;gfx;models",
+    "gfx_player": "cpu;gfx;player",
+    "gfx_npcs": "cpu;gfx;npcs",
+    "gfx_workers": "cpu;gfx;workers",
+    "gfx_effects": "cpu;gfx;effects",
+    "gfx_render_tasks": "cpu;gfx;render_tasks",
+    "gfx_hud_elements": "cpu;gfx;hud_elements",
+    "gfx_back_ui": "cpu;gfx;back_ui",
+    "gfx_front_ui": "cpu;gfx;front_ui",
+    "audio": "audio",
+    "rsp_gfx": "rsp;gfx",
+    "rsp_audio": "rsp;audio",
+}
+
+
+@dataclass
+class Record:
+    frame: int
+    times: Dict[str, float]  # microseconds
+    counters: Dict[str, int]
+    heap_used: int
+    heap_free: int
+    heap_largest_free: int
+    num_scripts: int
+    num_npcs: int
+    num_effects: int
+
+
+def time_names(count: int) -> List[str]:
+    if count == len(TIME_NAMES):
+        return TIME_NAMES
+    return [f"time_{i}" for i in range(count)]
+
+
+def counter_names(count: int) -> List[str]:
+    if count == len(COUNTER_NAMES):
+        return COUNTER_NAMES
+    return [f"counter_{i}" for i in range(count)]
+
+
+def decode(data: bytes) -> Iterator[Record]:
+    pos = data.find(MAGIC)
+    while pos >= 0:
+        if pos + HEADER.size > len(data):
+            return
+
+        _, size, num_times, num_counters, frame = HEADER.unpack_from(data, pos)
+        expected_size = HEADER.size + 4 * (num_times + num_counters) + 3 * 4 + 4 * 2 + 4
+        if size != expected_size or pos + size > len(data):
+            pos = data.find(MAGIC, pos + 1)
+            continue
+
+        words = struct.unpack_from(f">{size // 4}I", data, pos)
+        if sum(words[:-1]) & 0xFFFFFFFF != words[-1]:
+            pos = data.find(MAGIC, pos + 1)
+            continue
+
+        offset = pos + HEADER.size
+        raw_times = struct.unpack_from(f">{num_times}I", data, offset)
+        offset += 4 * num_times
+        raw_counters = struct.unpack_from(f">{num_counters}I", data, offset)
+        offset += 4 * num_counters
+        heap_used, heap_free, heap_largest_free, num_scripts, num_npcs, num_effects, _ = struct.unpack_from(
+            ">IIIHHHH", data, offset
+        )
+
+        times = {}
+        for name, value in zip(time_names(num_times), raw_times):
+            scale = RDP_USEC_PER_CLOCK if name in RDP_TIMES else CPU_USEC_PER_CYCLE
+            times[name] = value * scale
+
+        yield Record(
+            frame,
+            times,
+            dict(zip(counter_names(num_counters), raw_counters)),
+            heap_used,
+            heap_free,
+            heap_largest_free,
+            num_scripts,
+            num_npcs,
+            num_effects,
+        )
+        pos = data.find(MAGIC, pos + size)
+
+
+def write_csv(records: List[Record], out):
+    if not records:
+        return
+
+    time_columns = list(records[0].times.keys())
+    counter_columns = list(records[0].counters.keys())
+    stat_columns = ["heap_used", "heap_free", "heap_largest_free", "num_scripts", "num_npcs", "num_effects"]
+
+    writer = csv.writer(out)
+    writer.writerow(["frame"] + [f"{c}_us" for c in time_columns] + counter_columns + stat_columns)
+    for r in records:
+        writer.writerow(
+            [r.frame]
+            + [f"{r.times.get(c, 0):.1f}" for c in time_columns]
+            + [r.counters.get(c, 0) for c in counter_columns]
+            + [getattr(r, c) for c in stat_columns]
+        )
+
+
+def folded_stacks(records: List[Record]) -> Dict[str, float]:
+    # children are subtracted from their parents so each stack holds only its own time
+    totals: Dict[str, float] = {}
+    for r in records:
+        frame: Dict[str, float] = {}
+        for name, stack in FLAME_STACKS.items():
+            if name in r.times:
+                frame[stack] = r.times[name]
+        if "total" in r.times:
+            frame["cpu"] = r.times["total"]
+
+        for stack in sorted(frame.keys(), key=lambda s: -s.count(";")):
+            parent = stack.rpartition(";")[0]
+            if parent in frame:
+                frame[parent] -= frame[stack]
+
+        for stack, value in frame.items():
+            totals[stack] = totals.get(stack, 0) + max(value, 0)
+    return totals
+
+
+def write_flame(records: List[Record], out):
+    # format understood by flamegraph.pl, speedscope, etc; values are total microseconds
+    for stack, value in sorted(folded_stacks(records).items()):
+        if value >= 1:
+            out.write(f"{stack} {int(value)}\n")
+
+
+def print_spikes(records: List[Record], count: int, out):
+    if not records:
+        return
+
+    cpu = lambda r: r.times.get("total", 0) + 2 * r.times.get("audio", 0)
+    average = sum(cpu(r) for r in records) / len(records)
+    out.write(f"{len(records)} frames, average CPU {average:.0f}us\n")
+
+    for r in sorted(records, key=cpu, reverse=True)[:count]:
+        buckets = [(v, n) for n, v in r.times.items() if n in FLAME_STACKS and n != "gfx"]
+        top = ", ".join(f"{n} {v:.0f}" for v, n in sorted(buckets, reverse=True)[:4])
+        out.write(f"  frame {r.frame}: {cpu(r):.0f}us ({top})\n")
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Decode a capture of the IS-Viewer binary profiler stream")
+    parser.add_argument("capture", help="raw bytes written to the IS-Viewer by the game")
+    parser.add_argument("--csv", help="write one row per frame to this file ('-' for stdout)")
+    parser.add_argument("--flame", help="write folded stacks of the total time per bucket to this file")
+    parser.add_argument("--spikes", type=int, default=10, help="number of slowest frames to list (default 10)")
+    args = parser.parse_args()
+
+    with open(args.capture, "rb") as f:
+        records = list(decode(f.read()))
+
+    if args.csv == "-":
+        write_csv(records, sys.stdout)
+    elif args.csv:
+        with open(args.csv, "w", newline="") as f:
+            write_csv(records, f)
+
+    if args.flame:
+        with open(args.flame, "w") as f:
+            write_flame(records, f)
+
+    if args.csv != "-":
+        print_spikes(records, args.spikes, sys.stdout)
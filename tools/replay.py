@@ -0,0 +1,105 @@
+#!/usr/bin/env python3
+
+# Extracts an input recording (DX_REPLAY_RECORD in src/dx/config.h) from a capture of the IS-Viewer output, and
+# converts it into src/dx/replay_data.inc.c for playback with DX_REPLAY_PLAY. The capture may contain printf output
+# and profiler records as well; only replay records are kept. --save writes just the replay records, which is the
+# compact form to keep around and can be passed back in place of a capture.
+
+import argparse
+import struct
+from dataclasses import dataclass, field
+from typing import List, Tuple
+
+MAGIC_START = b"RPLS"
+MAGIC_FRAMES = b"RPLF"
+MAGIC_CHAOS = b"RPLC"
+
+CHUNK_FRAMES = 64  # REPLAY_CHUNK_FRAMES
+FRAMES_SIZE = 12 + 4 * CHUNK_FRAMES
+
+
+@dataclass
+class Recording:
+    seed: int = 1
+    frames: List[Tuple[int, int, int]] = field(default_factory=list)
+    chaos_events: List[Tuple[int, int]] = field(default_factory=list)
+    raw: bytearray = field(default_factory=bytearray)
+
+
+def next_record(data: bytes, pos: int) -> int:
+    found = [p for p in (data.find(m, pos) for m in (MAGIC_START, MAGIC_FRAMES, MAGIC_CHAOS)) if p >= 0]
+    return min(found, default=-1)
+
+
+def decode(data: bytes) -> Recording:
+    rec = Recording()
+    pos = next_record(data, 0)
+
+    while pos >= 0:
+        magic = data[pos : pos + 4]
+
+        if magic == MAGIC_START and pos + 8 <= len(data):
+            if rec.raw:
+                print("warning: capture contains more than one recording, keeping the last one")
+                rec = Recording()
+            (rec.seed,) = struct.unpack_from(">I", data, pos + 4)
+            size = 8
+        elif magic == MAGIC_FRAMES and pos + FRAMES_SIZE <= len(data):
+            first, count = struct.unpack_from(">II", data, pos + 4)
+            # only the chunk sent when recording stops may be partly filled
+            if first != len(rec.frames) or count == 0 or count > CHUNK_FRAMES:
+                # not a real record (or a dropped chunk), resync on the next magic
+                pos = next_record(data, pos + 1)
+                continue
+            for i in range(count):
+                rec.frames.append(struct.unpack_from(">Hbb", data, pos + 12 + 4 * i))
+            size = FRAMES_SIZE
+        elif magic == MAGIC_CHAOS and pos + 12 <= len(data):
+            frame, effect = struct.unpack_from(">II", data, pos + 4)
+            rec.chaos_events.append((frame, effect))
+            size = 12
+        else:
+            pos = next_record(data, pos + 1)
+            continue
+
+        rec.raw += data[pos : pos + size]
+        pos = next_record(data, pos + size)
+
+    return rec
+
+
+def write_inc_c(rec: Recording, out_path: str):
+    with open(out_path, "w") as f:
+        f.write("/* This file is auto-generated by tools/replay.py. Do not edit. */\n\n")
+        f.write(f"u32 ReplaySeed = 0x{rec.seed:08X};\n\n")
+
+        f.write("ReplayFrame ReplayFrames[] = {\n")
+        for buttons, x, y in rec.frames:
+            f.write(f"    {{ 0x{buttons:04X}, {x}, {y} }},\n")
+        f.write("};\n\n")
+
+        f.write("ReplayChaosEvent ReplayChaosEvents[] = {\n")
+        for frame, effect in rec.chaos_events:
+            f.write(f"    {{ {frame}, {effect} }},\n")
+        f.write("    { 0xFFFFFFFF, 0xFFFF }, // end\n")
+        f.write("};\n")
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description="Convert an IS-Viewer input recording for playback")
+    parser.add_argument("capture", help="raw IS-Viewer output, or a file written by --save")
+    parser.add_argument("-o", "--output", help="C file to generate, e.g. src/dx/replay_data.inc.c")
+    parser.add_argument("--save", help="write only the replay records to this file")
+    args = parser.parse_args()
+
+    with open(args.capture, "rb") as f:
+        rec = decode(f.read())
+
+    print(f"{len(rec.frames)} frames, {len(rec.chaos_events)} chaos effects, seed 0x{rec.seed:08X}")
+
+    if args.save:
+        with open(args.save, "wb") as f:
+            f.write(rec.raw)
+
+    if args.output:
+        write_inc_c(rec, args.output)